@@ -0,0 +1,38 @@
+#if !defined(_CHRONO_H)
+#define _CHRONO_H
+
+#include <stdbool.h>
+
+/* Frame interval of the timer sweep, a quarter of the vsync rate */
+#define CHRONO_FRAME_TIME (1.0 / 15.0)
+
+/* The minute count in the day window stops here, to fit its three characters */
+#define CHRONO_MINUTES_MAX 99
+
+typedef enum {
+	CHRONO_STATE_RESET = 0,
+	CHRONO_STATE_RUNNING = 1,
+	CHRONO_STATE_STOPPED = 2,
+} chrono_state_e;
+
+/*
+ * Called with the elapsed time whenever the timer display should change
+ */
+typedef void (*chrono_update_cb)(chrono_state_e state, double elapsed);
+
+/*
+ * Initialize the chrono component
+ */
+void chrono_initialize(chrono_update_cb update_cb);
+
+/*
+ * Finalize the chrono component
+ */
+void chrono_finalize(void);
+
+void chrono_toggle(void);
+void chrono_set_active(bool active);
+chrono_state_e chrono_get_state(void);
+double chrono_get_elapsed(void);
+
+#endif
@@ -0,0 +1,55 @@
+#if !defined(_COMPLICATION_H)
+#define _COMPLICATION_H
+
+#include <time.h>
+#include <stdbool.h>
+
+#define COMPLICATION_MAX 8
+
+/* Compute allowance for all providers started from one tick, in seconds */
+#define COMPLICATION_TICK_BUDGET 0.005
+
+typedef enum {
+	COMPLICATION_PERIOD_MINUTE = 60,
+	COMPLICATION_PERIOD_HOUR = 3600,
+	COMPLICATION_PERIOD_DAY = 86400,
+} complication_period_e;
+
+/*
+ * A published value. It is never modified after publishing, a new
+ * value replaces it as a whole.
+ */
+typedef struct _complication_value {
+	time_t computed_at;
+	double value;
+	int step;
+} complication_value_s;
+
+/*
+ * Compute a new value for the time given. Runs on a worker thread,
+ * so it must not touch any EFL object.
+ */
+typedef bool (*complication_compute_cb)(time_t now, complication_value_s *value_out, void *user_data);
+
+typedef struct _complication_provider {
+	const char *name;
+	complication_period_e period;
+	complication_compute_cb compute;
+	void *user_data;
+} complication_provider_s;
+
+/*
+ * Initialize the complication component
+ */
+void complication_initialize(void);
+
+/*
+ * Finalize the complication component
+ */
+void complication_finalize(void);
+
+int complication_register(const complication_provider_s *provider);
+void complication_update(time_t now);
+const complication_value_s *complication_get_value(int id);
+
+#endif
@@ -1,26 +1,34 @@
 #if !defined(_DATA_H)
 #define _DATA_H
 
+#include "complication.h"
+
 #define IMAGE_BG "images/watch_bg.png"
+/* Ambient dials stay bitmaps: a black dial, and the low battery one drops some trimmings */
 #define IMAGE_BG_AMBIENT "images/watch_bg_ambient.png"
 #define IMAGE_BG_AMBIENT_LOWBAT "images/watch_bg_ambient_low_battery.png"
 #define IMAGE_BG_PLATE "images/watch_bg_plate.png"
 #define IMAGE_HANDS_BAT "images/watch_hand_battery.png"
-#define IMAGE_HANDS_BAT_LOWBAT "images/watch_hand_battery_low_battery.png"
 #define IMAGE_HANDS_BAT_SHADOW "images/watch_hand_battery_shadow.png"
-#define IMAGE_HANDS_SEC "images/watch_hand_sec.png"
-#define IMAGE_HANDS_SEC_SHADOW "images/watch_hand_sec_shadow.png"
-#define IMAGE_HANDS_SEC_AMBIENT "images/watch_hand_sec_ambient.png"
 #define IMAGE_HANDS_MIN "images/watch_hand_min.png"
 #define IMAGE_HANDS_MIN_SHADOW "images/watch_hand_min_shadow.png"
+/*
+ * Ambient hands are white masks for the scheme tint, shaped to end above the pivot.
+ * The black outline that keeps crossing hands apart is part of each mask. It is
+ * never lit, so drawing it only where the hands cross would save no lit pixels.
+ * TODO: outline only where the hands cross, which needs masks without the outline
+ * and a crop from both ends of the hand.
+ */
 #define IMAGE_HANDS_MIN_AMBIENT "images/watch_hand_min_ambient.png"
-#define IMAGE_HANDS_MIN_AMBIENT_LOWBAT "images/watch_hand_min_ambient_low_battery.png"
 #define IMAGE_HANDS_HOUR "images/watch_hand_hr.png"
 #define IMAGE_HANDS_HOUR_SHADOW "images/watch_hand_hr_shadow.png"
 #define IMAGE_HANDS_HOUR_AMBIENT "images/watch_hand_hr_ambient.png"
-#define IMAGE_HANDS_HOUR_AMBIENT_LOWBAT "images/watch_hand_hr_ambient_low_battery.png"
-#define IMAGE_HANDS_MODULE_CALENDAR "images/watch_hand_module_calendar.png"
-#define IMAGE_HANDS_MODULE_CALENDAR_SHADOW "images/watch_hand_module_calendar_shadow.png"
+/* The GMT hand shares the battery needle, tinted */
+#define IMAGE_HANDS_GMT IMAGE_HANDS_BAT
+/* The timer hand shares the white minute hand mask, tinted */
+#define IMAGE_HANDS_CHRONO IMAGE_HANDS_MIN_AMBIENT
+#define IMAGE_MOONPHASE_DISC "images/watch_moonphase_disc.png"
+#define IMAGE_MOONPHASE_WINDOW "images/watch_moonphase_window.png"
 
 #define LOW_BATTERY_LEVEL 25
 
@@ -38,6 +46,10 @@ typedef enum {
 	PARTS_TYPE_HANDS_BAT = 10,
 	PARTS_TYPE_HANDS_BAT_SHADOW = 11,
 	PARTS_TYPE_BG_PLATE= 12,
+	PARTS_TYPE_MOONPHASE_DISC = 13,
+	PARTS_TYPE_MOONPHASE_WINDOW = 14,
+	PARTS_TYPE_HANDS_GMT = 15,
+	PARTS_TYPE_HANDS_CHRONO = 16,
 	PARTS_TYPE_MAX,
 } parts_type_e;
 
@@ -52,7 +64,13 @@ void data_initialize(void);
 void data_finalize(void);
 
 void data_get_resource_path(const char *file_in, char *file_path_out, int file_path_max);
-int data_get_hour_plus_angle(int minute, int second);
+void data_get_profile_resource_path(const char *file_in, char *file_path_out, int file_path_max);
+void data_set_resolution(int width, int height);
+int data_scale(int value);
+double data_get_scale_factor(void);
+int data_get_hour_angle_fx(int hour, int minute, int second, int step);
+double data_get_hour_fx_degree(int fx);
+void data_get_hand_tip(double degree, int radius, int *x, int *y);
 double data_get_minute_plus_angle(int second);
 char *data_get_parts_image_path(parts_type_e type);
 void data_get_parts_position(parts_type_e type, int *x, int *y);
@@ -61,6 +79,8 @@ int data_get_parts_height_size(parts_type_e type);
 
 int data_get_juliandate(int day, int month, int year);
 float data_get_moonphase(int day, int month, int year);
+int data_get_moonphase_step(float phase);
+bool data_compute_moonphase(time_t now, complication_value_s *value_out, void *user_data);
 
 /**
  * @brief Get the TopLeft position of object A as it would be if centered on object B
@@ -73,6 +93,7 @@ static int get_a_centered_on_b(int sizeA, int sizeB)
 }
 
 bool set_object_background_image(Evas_Object* obj, const char* image);
+bool set_object_image(Evas_Object* obj, const char* image);
 
 char* get_day_of_week(int day);
 
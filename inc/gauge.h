@@ -0,0 +1,44 @@
+#if !defined(_GAUGE_H)
+#define _GAUGE_H
+
+#include <stdbool.h>
+
+/* Time for the smoothed level to cover 63% of a step in the raw percent, in seconds */
+#define GAUGE_SMOOTHING_TAU 120.0
+
+/* Percent above the low battery level the smoothed level must reach to leave the low state */
+#define GAUGE_LOW_HYSTERESIS 3
+
+/* Shortest span a discharge rate is measured over, in seconds */
+#define GAUGE_RATE_MIN_SPAN 300.0
+
+/* A rise in the raw percent this big is taken as charging, smaller ones as noise */
+#define GAUGE_RATE_RISE 2
+
+/* Weight of a new measure in the discharge rate */
+#define GAUGE_RATE_WEIGHT 0.3
+
+/*
+ * A model of the battery fed with the raw percent on every tick: an
+ * exponentially smoothed level, a low state with hysteresis, and a
+ * discharge rate, from which a time to empty is estimated. It does not
+ * depend on EFL.
+ */
+
+/*
+ * Initialize the gauge component
+ */
+void gauge_initialize(void);
+
+/*
+ * Finalize the gauge component
+ */
+void gauge_finalize(void);
+
+void gauge_update(double now, int percent, bool charging);
+double gauge_get_level(void);
+bool gauge_is_low(int low_level);
+double gauge_get_rate(void);
+int gauge_get_time_to_empty(void);
+
+#endif
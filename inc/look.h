@@ -18,6 +18,12 @@
 #define WEEKDAY_ANGLE 51
 #define BATTERY_START_ANGLE 195
 #define BATTERY_ANGLE 0.6f
+#define MOONPHASE_ANGLE 180
+#define GMT_HOUR_ANGLE 15
+
+/* The hour hand angle is kept in whole steps of one second of its turn */
+#define HOUR_FX_PER_DEGREE 120
+#define HOUR_FX_TURN (12 * 60 * 60)
 
 /* Layout */
 #define BASE_WIDTH 360
@@ -29,14 +35,24 @@
 #define BATTERY_OFFSET_Y 15
 
 #define MODULE_MOONPHASE_SIZE 240
+#define MODULE_MOONPHASE_WINDOW_SIZE 80
+#define MODULE_MOONPHASE_TOP_PADDING 72
+#define MODULE_MOONPHASE_STEPS 30
 #define MODULE_DAY_NUM_SIZE 100
 #define MODULE_DAY_NUM_RIGHT_PADDING 15
+/* Close to the old Edje SPRING jiggle: about 2.5 Hz, a peak near 5 degrees */
+#define MODULE_DAY_SPRING_STIFFNESS 250.0
+#define MODULE_DAY_SPRING_DAMPING 5.0
+#define MODULE_DAY_SPRING_KICK 80.0
 #define MODULE_MONTH_SIZE 128
 #define MODULE_WEEKDAY_SIZE MODULE_MONTH_SIZE
 
 #define BG_PLATE_WIDTH 120
 #define BG_PLATE_HEIGHT 120
 
+/* Farthest a press on the plate may move and still count as a tap */
+#define CHRONO_TAP_SLOP 12
+
 #define HANDS_SEC_WIDTH 30
 #define HANDS_SEC_HEIGHT 360
 #define HANDS_MIN_WIDTH 30
@@ -48,6 +64,10 @@
 #define HANDS_MODULE_CALENDAR_WIDTH 20
 #define HANDS_MODULE_CALENDAR_HEIGHT 128
 
+/* Ambient hour and minute hands have no tail, nothing below the pivot is lit.
+ * Only this crop is done, their outline is still drawn whole, see data.h. */
+#define HANDS_AMBIENT_VISIBLE_HEIGHT (BASE_HEIGHT / 2)
+
 #define HANDS_BAT_Y_PADDING 44
 #define HANDS_BAT_SHADOW_PADDING 3
 #define HANDS_SEC_SHADOW_PADDING 5
@@ -0,0 +1,54 @@
+#if !defined(_MEMREPORT_H)
+#define _MEMREPORT_H
+
+#include <stdbool.h>
+
+#define MEMREPORT_ENTRY_MAX 128
+#define MEMREPORT_NAME_MAX 96
+
+/* app_control extra data to ask for a report, "log" or a file name in the data directory */
+#define MEMREPORT_KEY "memory_report"
+#define MEMREPORT_TO_LOG "log"
+
+/*
+ * A table of what the face keeps in memory. Decoded images are counted
+ * once each, as the image cache shares them; objects showing a cached
+ * image only name it, and count bytes for pixels they own themselves.
+ * Edje groups list how many objects use them.
+ *
+ * The table itself does not depend on EFL, so the same report can be
+ * made offline, see tools/mem_report.c.
+ */
+
+typedef enum {
+	MEMREPORT_KIND_IMAGE = 0,
+	MEMREPORT_KIND_OBJECT,
+	MEMREPORT_KIND_GROUP,
+	MEMREPORT_KIND_MAX,
+} memreport_kind_e;
+
+/*
+ * Called for each line of the report, without the newline
+ */
+typedef void (*memreport_line_cb)(const char *line, void *data);
+
+/*
+ * Start a new, empty report
+ */
+void memreport_begin(void);
+
+void memreport_add_image(const char *name, int w, int h, const char *colorspace, long bytes);
+void memreport_add_object(const char *name, const char *type, int w, int h, const char *source, long bytes);
+void memreport_add_group(const char *name, const char *file);
+long memreport_get_total(void);
+void memreport_print(memreport_line_cb line_cb, void *data);
+bool memreport_write(const char *path);
+
+/*
+ * Fill the report from the watch canvas and the groups of the Edje file,
+ * and send it to the log or a file in the data directory. EFL only, see
+ * memreport_efl.c.
+ */
+bool memreport_dump(const char *edj_path, const char *target);
+
+#endif
@@ -0,0 +1,32 @@
+#if !defined(_PRELOAD_H)
+#define _PRELOAD_H
+
+#include <stdbool.h>
+
+#define PRELOAD_MAX 16
+
+typedef enum {
+	PRELOAD_PRIORITY_LOW = 0,
+	PRELOAD_PRIORITY_NORMAL,
+	PRELOAD_PRIORITY_HIGH,
+} preload_priority_e;
+
+/*
+ * Called once the image is decoded, with the image as passed to preload_image()
+ */
+typedef void (*preload_done_cb)(const char *image, void *data);
+
+/*
+ * Initialize the preload component
+ */
+void preload_initialize(void);
+
+/*
+ * Finalize the preload component, releasing the decoded images
+ */
+void preload_finalize(void);
+
+void preload_image(const char *image, preload_priority_e priority, preload_done_cb done_cb, void *data);
+bool preload_is_ready(const char *image);
+
+#endif
@@ -0,0 +1,48 @@
+#if !defined(_RENDER_H)
+#define _RENDER_H
+
+#include <stdbool.h>
+
+/*
+ * Nothing here depends on EFL, so a face can be drawn through the
+ * software backend on any host.
+ */
+
+typedef struct _render_object *render_object_h;
+
+/*
+ * A drawing backend. Objects are drawn in the order they are added.
+ */
+typedef struct _render_backend {
+	const char *name;
+	render_object_h (*image_add)(const char *image_path, int x, int y, int w, int h);
+	void (*set_transform)(render_object_h obj, double degree, int cx, int cy, int visible_h);
+	void (*set_color)(render_object_h obj, int r, int g, int b, int a);
+	void (*set_visible)(render_object_h obj, bool visible);
+	void (*set_text)(render_object_h obj, const char *part_name, const char *text);
+	void (*del)(render_object_h obj);
+	/* Optional, holds back side effects of the calls until unfrozen */
+	void (*set_frozen)(bool frozen);
+	/* Optional, works out ahead of time a transform set_transform will be asked for */
+	void (*prepare_transform)(render_object_h obj, double degree, int cx, int cy, int visible_h);
+} render_backend_s;
+
+/* Draws through Elementary and Evas, objects are the Evas_Object themselves */
+extern const render_backend_s render_backend_efl;
+
+/* Draws into a memory frame, host tools only, see tools/soft/render_soft.h */
+extern const render_backend_s render_backend_soft;
+
+void render_set_backend(const render_backend_s *backend);
+const render_backend_s *render_get_backend(void);
+
+render_object_h render_image_add(const char *image_path, int x, int y, int w, int h);
+void render_set_transform(render_object_h obj, double degree, int cx, int cy, int visible_h);
+void render_set_color(render_object_h obj, int r, int g, int b, int a);
+void render_set_visible(render_object_h obj, bool visible);
+void render_set_text(render_object_h obj, const char *part_name, const char *text);
+void render_del(render_object_h obj);
+void render_set_frozen(bool frozen);
+void render_prepare_transform(render_object_h obj, double degree, int cx, int cy, int visible_h);
+
+#endif
@@ -0,0 +1,36 @@
+#if !defined(_SCENE_H)
+#define _SCENE_H
+
+#include <stdbool.h>
+
+#include "render.h"
+
+#define SCENE_NODE_MAX 24
+
+/* How often the writes and calls per commit are logged, in commits */
+#define SCENE_REPORT_COMMITS 600
+
+/*
+ * The tick handlers write the state they want into the scene, and
+ * scene_commit() issues only the render calls that change something,
+ * in one frozen batch. Transforms of hidden objects wait until shown.
+ * A transform expected on the next tick can be prepared while idle.
+ */
+
+/*
+ * Initialize the scene component
+ */
+void scene_initialize(void);
+
+/*
+ * Finalize the scene component
+ */
+void scene_finalize(void);
+
+void scene_set_transform(render_object_h obj, double degree, int cx, int cy, int visible_h);
+void scene_prepare_transform(render_object_h obj, double degree, int cx, int cy, int visible_h);
+void scene_set_visible(render_object_h obj, bool visible);
+void scene_invalidate(render_object_h obj);
+int scene_commit(void);
+
+#endif
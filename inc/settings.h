@@ -0,0 +1,91 @@
+#if !defined(_SETTINGS_H)
+#define _SETTINGS_H
+
+#include <app.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define SETTINGS_FILE "settings.bin"
+
+/* app_control extra data keys, all values are strings */
+#define SETTINGS_KEY_LOW_BATTERY_LEVEL "low_battery_level" /* "0" to "100" */
+#define SETTINGS_KEY_SECOND_MODE "second_mode" /* "sweep" or "off" */
+#define SETTINGS_KEY_SHADOWS "shadows" /* "auto", "off", "hard" or "soft" */
+#define SETTINGS_KEY_AMBIENT_COLOR "ambient_color" /* "#rrggbb" */
+#define SETTINGS_KEY_COMPLICATIONS "complications" /* "on" or "off" */
+#define SETTINGS_KEY_HOUR_STEP "hour_step" /* "minute", "10s" or "continuous" */
+#define SETTINGS_KEY_BATTERY_READOUT "battery_readout" /* "on" or "off" */
+
+typedef enum {
+	SETTINGS_SECOND_SWEEP = 0,
+	SETTINGS_SECOND_OFF = 1,
+} settings_second_e;
+
+/*
+ * Hard shadows are the hand sprite tinted black, soft ones the pre-blurred
+ * shadow images. Auto uses soft shadows, and hard ones on low battery
+ */
+typedef enum {
+	SETTINGS_SHADOW_AUTO = 0,
+	SETTINGS_SHADOW_OFF = 1,
+	SETTINGS_SHADOW_HARD = 2,
+	SETTINGS_SHADOW_SOFT = 3,
+} settings_shadow_e;
+
+/*
+ * How often the hour hand moves. It is only redrawn when its tip moves
+ * to another pixel, so a finer step costs no more map updates
+ */
+typedef enum {
+	SETTINGS_HOUR_MINUTE = 0,
+	SETTINGS_HOUR_10S = 1,
+	SETTINGS_HOUR_CONTINUOUS = 2,
+} settings_hour_step_e;
+
+typedef enum {
+	SETTINGS_CHANGED_LOW_BATTERY = 1 << 0,
+	SETTINGS_CHANGED_SECOND = 1 << 1,
+	SETTINGS_CHANGED_SHADOWS = 1 << 2,
+	SETTINGS_CHANGED_AMBIENT_COLOR = 1 << 3,
+	SETTINGS_CHANGED_COMPLICATIONS = 1 << 4,
+	SETTINGS_CHANGED_HOUR_STEP = 1 << 5,
+	SETTINGS_CHANGED_BATTERY_READOUT = 1 << 6,
+	SETTINGS_CHANGED_ALL = (1 << 7) - 1,
+} settings_changed_e;
+
+/*
+ * The file is this struct as is, mapped without parsing. Any change to
+ * the layout needs a new version, older files are then ignored.
+ */
+typedef struct _settings {
+	uint32_t magic;
+	uint32_t version;
+	int32_t low_battery_level;
+	int32_t second_mode;
+	uint8_t shadows;
+	uint8_t complications;
+	uint8_t ambient_color[3];
+	uint8_t hour_step;
+	uint8_t battery_readout;
+	uint8_t reserved[1];
+} settings_s;
+
+/*
+ * Called with the settings_changed_e flags of the values that changed
+ */
+typedef void (*settings_changed_cb)(unsigned int changed, void *user_data);
+
+/*
+ * Initialize the settings component, mapping the saved settings
+ */
+void settings_initialize(settings_changed_cb changed_cb, void *user_data);
+
+/*
+ * Finalize the settings component
+ */
+void settings_finalize(void);
+
+const settings_s *settings_get(void);
+bool settings_update(app_control_h app_control);
+
+#endif
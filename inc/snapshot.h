@@ -0,0 +1,20 @@
+#if !defined(_SNAPSHOT_H)
+#define _SNAPSHOT_H
+
+#include <Elementary.h>
+#include <stdbool.h>
+
+/* The frame and its state, in one Eet file Evas loads the frame from */
+#define SNAPSHOT_FILE "snapshot.eet"
+#define SNAPSHOT_FRAME_KEY "frame"
+#define SNAPSHOT_STATE_KEY "state"
+
+/* Older frames show the wrong time for too long to be worth drawing, in seconds */
+#define SNAPSHOT_MAX_AGE 600
+
+bool snapshot_save(Evas_Object *win);
+void snapshot_cancel(void);
+bool snapshot_show(Evas_Object *win, int width, int height);
+void snapshot_hide(void);
+
+#endif
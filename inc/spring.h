@@ -0,0 +1,36 @@
+#if !defined(_SPRING_H)
+#define _SPRING_H
+
+#include <stdbool.h>
+
+#define SPRING_MAX 4
+
+/* Integration step, and the most steps one frame may take, in seconds */
+#define SPRING_STEP (1.0 / 240.0)
+#define SPRING_MAX_STEPS 8
+
+/* Motion below this, measured at the radius, is put to sleep, in pixels */
+#define SPRING_REST_PIXELS 0.5
+
+typedef struct _spring *spring_h;
+
+/*
+ * Called with the new angle, in degrees, on every frame the spring moves
+ */
+typedef void (*spring_apply_cb)(double angle, void *data);
+
+/*
+ * Initialize the spring component
+ */
+void spring_initialize(void);
+
+/*
+ * Finalize the spring component
+ */
+void spring_finalize(void);
+
+spring_h spring_add(double stiffness, double damping, double radius, spring_apply_cb apply_cb, void *data);
+void spring_del(spring_h spring);
+void spring_kick(spring_h spring, double velocity);
+
+#endif
@@ -3,9 +3,34 @@
 
 #define EDJ_FILE "edje/main.edj"
 
+/* Edje message interface, keep in sync with res/edje/main.edc */
+#define MSG_ID_HAND_STATE 1
+#define MSG_HAND_STATE_COUNT 3
+#define MSG_ID_MINUTE_STATE 2
+#define MSG_MINUTE_STATE_COUNT 3
+/* Set with the hand state to the colour of its scheme */
+#define SCHEME_COLOR_CLASS "scheme"
+
+typedef enum {
+	VIEW_MODE_NORMAL = 0,
+	VIEW_MODE_AMBIENT = 1,
+} view_mode_e;
+
+typedef enum {
+	VIEW_SCHEME_DEFAULT = 0,
+	VIEW_SCHEME_AMBIENT = 1,
+	VIEW_SCHEME_AMBIENT_LOWBAT = 2,
+	VIEW_SCHEME_LOWBAT = 3,
+	VIEW_SCHEME_GMT = 4,
+	VIEW_SCHEME_CHRONO = 5,
+	VIEW_SCHEME_MAX,
+} view_scheme_e;
+
 void view_set_module_day_layout(Evas_Object *layout);
 void view_set_module_second_layout(Evas_Object *layout);
 void view_set_module_minute_layout(Evas_Object *layout);
+void view_set_moonphase(Evas_Object *disc, Evas_Object *window);
+void view_set_moonphase_visible(bool visible);
 Evas_Object *view_get_bg(void);
 Evas_Object *view_get_bg_plate(void);
 Evas_Object *view_get_module_day_layout(void);
@@ -17,13 +42,23 @@ Evas_Object *view_get_module_minute_layout(void);
  */
 void view_set_text(Evas_Object *parent, const char *part_name, const char *text);
 void view_rotate_hand(Evas_Object *hand, double degree, Evas_Coord cx, Evas_Coord cy);
-//void view_rotate_moonphase(float degree);
+void view_rotate_hand_cropped(Evas_Object *hand, double degree, Evas_Coord cx, Evas_Coord cy, Evas_Coord visible_h);
+void view_prepare_hand_map(Evas_Object *hand, double degree, Evas_Coord cx, Evas_Coord cy, Evas_Coord visible_h);
+void view_clear_prepared_maps(void);
+void view_set_scheme_color(Evas_Object *obj, view_scheme_e scheme);
+void view_set_scheme_rgb(view_scheme_e scheme, int r, int g, int b);
+void view_send_hand_state(Evas_Object *layout, int angle, view_mode_e mode, view_scheme_e scheme);
+void view_send_minute_state(Evas_Object *layout, int angle, view_mode_e mode, bool shadow);
+void view_rotate_moonphase(float degree);
+void view_rotate_module(Evas_Object *layout, double degree);
 Evas_Object *view_create_layout(Evas_Object *parent, const char *file_path, const char *group_name, void *user_data);
 Evas_Object *view_create_bg(Evas_Object *win, const char *image_path, int width, int height);
 Evas_Object *view_create_bg_plate(Evas_Object *bg, const char *image_path, int width, int height);
 void view_set_module_property(Evas_Object *layout, int x, int y, int w, int h);
+void view_set_module_scale(Evas_Object *layout, double scale);
 Evas_Object *view_create_module_layout(Evas_Object *parent, const char *file_path, const char *group_name);
 void view_set_opacity_to_parts(Evas_Object *parts);
+void view_set_shadow_tint(Evas_Object *parts);
 Evas_Object *view_create_parts(Evas_Object *parent, const char *image_path, int x, int y, int w, int h);
 
 void view_create_base_gui(int width, int height);
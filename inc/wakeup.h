@@ -0,0 +1,42 @@
+#if !defined(_WAKEUP_H)
+#define _WAKEUP_H
+
+#include <Elementary.h>
+#include <time.h>
+#include <stdbool.h>
+
+#define WAKEUP_FRAME_MAX 4
+
+/* How often the wakeup rates are logged, in seconds */
+#define WAKEUP_REPORT_PERIOD 600
+
+typedef enum {
+	WAKEUP_SOURCE_TIME_TICK = 0,
+	WAKEUP_SOURCE_AMBIENT_TICK,
+	WAKEUP_SOURCE_FRAME,
+	WAKEUP_SOURCE_COMPLICATION,
+	WAKEUP_SOURCE_INPUT,
+	WAKEUP_SOURCE_MAX,
+} wakeup_source_e;
+
+typedef struct _wakeup_frame *wakeup_frame_h;
+
+/*
+ * Initialize the wakeup component
+ */
+void wakeup_initialize(void);
+
+/*
+ * Finalize the wakeup component
+ */
+void wakeup_finalize(void);
+
+void wakeup_set_ambient(bool ambient);
+void wakeup_count(wakeup_source_e source);
+void wakeup_report(time_t now);
+
+void wakeup_set_animated(bool animated);
+wakeup_frame_h wakeup_frame_add(double interval, Ecore_Task_Cb frame_cb, const void *data);
+void wakeup_frame_del(wakeup_frame_h frame);
+
+#endif
@@ -0,0 +1,158 @@
+#include <Elementary.h>
+#include <dlog.h>
+
+#include "look.h"
+#include "chrono.h"
+#include "wakeup.h"
+
+static struct chrono_info {
+	chrono_state_e state;
+	double started;
+	double elapsed;
+	bool active;
+	wakeup_frame_h frame;
+	chrono_update_cb update_cb;
+} s_info = {
+	.state = CHRONO_STATE_RESET,
+	.started = 0.0f,
+	.elapsed = 0.0f,
+	.active = false,
+	.frame = NULL,
+	.update_cb = NULL,
+};
+
+static void _update_frame(void);
+static Eina_Bool _frame_cb(void *data);
+
+/**
+ * @brief Get the time since boot, including time spent suspended.
+ * CLOCK_MONOTONIC (and so ecore_time_get) stops while the device sleeps in ambient.
+ */
+static double _get_boottime(void)
+{
+	struct timespec ts = { 0, };
+
+	clock_gettime(CLOCK_BOOTTIME, &ts);
+
+	return ts.tv_sec + (ts.tv_nsec / 1000000000.0);
+}
+
+/**
+ * @brief Initialization function for chrono module.
+ * @param[in] update_cb The function to call when the display should change
+ */
+void chrono_initialize(chrono_update_cb update_cb)
+{
+	s_info.update_cb = update_cb;
+	s_info.state = CHRONO_STATE_RESET;
+	s_info.elapsed = 0.0f;
+}
+
+/**
+ * @brief Finalization function for chrono module.
+ */
+void chrono_finalize(void)
+{
+	if (s_info.frame)
+	{
+		wakeup_frame_del(s_info.frame);
+		s_info.frame = NULL;
+	}
+
+	s_info.update_cb = NULL;
+}
+
+/**
+ * @brief Step the timer: start, stop, then reset.
+ */
+void chrono_toggle(void)
+{
+	switch (s_info.state) {
+	case CHRONO_STATE_RESET:
+		s_info.started = _get_boottime();
+		s_info.state = CHRONO_STATE_RUNNING;
+		break;
+	case CHRONO_STATE_RUNNING:
+		s_info.elapsed += _get_boottime() - s_info.started;
+		s_info.state = CHRONO_STATE_STOPPED;
+		break;
+	case CHRONO_STATE_STOPPED:
+	default:
+		s_info.elapsed = 0.0f;
+		s_info.state = CHRONO_STATE_RESET;
+		break;
+	}
+
+	_update_frame();
+
+	if (s_info.update_cb)
+		s_info.update_cb(s_info.state, chrono_get_elapsed());
+}
+
+/**
+ * @brief Allow or stop frames. The timer keeps counting while inactive.
+ * @param[in] active True while the watch is visible and not in ambient
+ */
+void chrono_set_active(bool active)
+{
+	if (s_info.active == active)
+		return;
+
+	s_info.active = active;
+	_update_frame();
+
+	// Catch the display up after ambient or pause, a reset timer has nothing to draw
+	if (active && s_info.state != CHRONO_STATE_RESET && s_info.update_cb)
+		s_info.update_cb(s_info.state, chrono_get_elapsed());
+}
+
+/**
+ * @brief Get the timer state.
+ */
+chrono_state_e chrono_get_state(void)
+{
+	return s_info.state;
+}
+
+/**
+ * @brief Get the elapsed time in seconds.
+ */
+double chrono_get_elapsed(void)
+{
+	if (s_info.state == CHRONO_STATE_RUNNING)
+		return s_info.elapsed + (_get_boottime() - s_info.started);
+
+	return s_info.elapsed;
+}
+
+/**
+ * @brief Take frames only while the timer runs and can be seen.
+ */
+static void _update_frame(void)
+{
+	bool needed = s_info.active && s_info.state == CHRONO_STATE_RUNNING;
+
+	if (needed && s_info.frame == NULL)
+	{
+		s_info.frame = wakeup_frame_add(CHRONO_FRAME_TIME, _frame_cb, NULL);
+		if (s_info.frame == NULL)
+			dlog_print(DLOG_ERROR, LOG_TAG, "Failed to add chrono frame");
+	}
+	else if (!needed && s_info.frame)
+	{
+		wakeup_frame_del(s_info.frame);
+		s_info.frame = NULL;
+	}
+}
+
+/**
+ * @brief Push one frame of the running timer.
+ * @param[in] data The user data
+ */
+static Eina_Bool _frame_cb(void *data)
+{
+	if (s_info.update_cb)
+		s_info.update_cb(s_info.state, chrono_get_elapsed());
+
+	return ECORE_CALLBACK_RENEW;
+}
@@ -0,0 +1,270 @@
+#include <Elementary.h>
+#include <dlog.h>
+
+#include "look.h"
+#include "complication.h"
+#include "wakeup.h"
+
+typedef struct _complication_slot {
+	const complication_provider_s *provider;
+	complication_value_s *value;
+	Ecore_Thread *thread;
+	time_t next_due;
+	double cost;
+} complication_slot_s;
+
+typedef struct _complication_job {
+	complication_slot_s *slot;
+	time_t now;
+	complication_value_s *old_value;
+	double cost;
+} complication_job_s;
+
+static struct complication_info {
+	complication_slot_s slots[COMPLICATION_MAX];
+	int count;
+	time_t now;
+	Ecore_Idler *idler;
+} s_info = {
+	.count = 0,
+	.now = 0,
+	.idler = NULL,
+};
+
+static Eina_Bool _schedule_idler_cb(void *data);
+static void _compute_thread_cb(void *data, Ecore_Thread *thread);
+static void _compute_end_cb(void *data, Ecore_Thread *thread);
+static void _compute_cancel_cb(void *data, Ecore_Thread *thread);
+
+/**
+ * @brief Initialization function for complication module.
+ */
+void complication_initialize(void)
+{
+	memset(s_info.slots, 0, sizeof(s_info.slots));
+	s_info.count = 0;
+}
+
+/**
+ * @brief Finalization function for complication module.
+ */
+void complication_finalize(void)
+{
+	int i = 0;
+
+	if (s_info.idler)
+	{
+		ecore_idler_del(s_info.idler);
+		s_info.idler = NULL;
+	}
+
+	for (i = 0; i < s_info.count; i++)
+	{
+		/* A running job frees its own value from the cancel callback */
+		if (s_info.slots[i].thread)
+		{
+			ecore_thread_cancel(s_info.slots[i].thread);
+			continue;
+		}
+
+		free(__atomic_exchange_n(&s_info.slots[i].value, NULL, __ATOMIC_ACQ_REL));
+	}
+}
+
+/**
+ * @brief Register a complication provider.
+ * @param[in] provider The provider, it must stay valid until finalize
+ * @return The complication id, or -1 on failure
+ */
+int complication_register(const complication_provider_s *provider)
+{
+	complication_slot_s *slot = NULL;
+
+	if (provider == NULL || provider->compute == NULL)
+	{
+		dlog_print(DLOG_ERROR, LOG_TAG, "provider is invalid");
+		return -1;
+	}
+
+	if (s_info.count >= COMPLICATION_MAX)
+	{
+		dlog_print(DLOG_ERROR, LOG_TAG, "Too many complications");
+		return -1;
+	}
+
+	slot = &s_info.slots[s_info.count];
+	slot->provider = provider;
+	slot->value = NULL;
+	slot->thread = NULL;
+	slot->next_due = 0;
+	slot->cost = 0.0f;
+
+	return s_info.count++;
+}
+
+/**
+ * @brief Check for due providers. Cheap enough to call from every tick,
+ * the computation itself is started later from an idler.
+ * @param[in] now The current UTC timestamp
+ */
+void complication_update(time_t now)
+{
+	int i = 0;
+
+	s_info.now = now;
+
+	if (s_info.idler)
+		return;
+
+	for (i = 0; i < s_info.count; i++)
+	{
+		if (s_info.slots[i].thread == NULL && now >= s_info.slots[i].next_due)
+		{
+			s_info.idler = ecore_idler_add(_schedule_idler_cb, NULL);
+			return;
+		}
+	}
+}
+
+/**
+ * @brief Get the latest value of a complication.
+ * @param[in] id The complication id
+ * @return The value, or NULL if nothing was computed yet. It stays valid
+ * until the main loop runs again, so do not keep it.
+ */
+const complication_value_s *complication_get_value(int id)
+{
+	if (id < 0 || id >= s_info.count)
+	{
+		dlog_print(DLOG_ERROR, LOG_TAG, "complication id error : %d", id);
+		return NULL;
+	}
+
+	return __atomic_load_n(&s_info.slots[id].value, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * @brief Start the due providers, deferring any that would exceed the tick budget.
+ * @param[in] data The user data
+ */
+static Eina_Bool _schedule_idler_cb(void *data)
+{
+	complication_slot_s *slot = NULL;
+	complication_job_s *job = NULL;
+	double spent = 0.0f;
+	int i = 0;
+
+	s_info.idler = NULL;
+
+	for (i = 0; i < s_info.count; i++)
+	{
+		slot = &s_info.slots[i];
+
+		if (slot->thread || s_info.now < slot->next_due)
+			continue;
+
+		/*
+		 * Use the last measured cost as the estimate. A provider that is
+		 * over budget on its own still runs when it is the first one
+		 */
+		if (spent > 0.0f && spent + slot->cost > COMPLICATION_TICK_BUDGET)
+		{
+			dlog_print(DLOG_DEBUG, LOG_TAG, "complication %s deferred", slot->provider->name);
+			continue;
+		}
+
+		job = calloc(1, sizeof(complication_job_s));
+		if (job == NULL)
+		{
+			dlog_print(DLOG_ERROR, LOG_TAG, "Failed to allocate job");
+			break;
+		}
+
+		job->slot = slot;
+		job->now = s_info.now;
+
+		/* Align to the period so every provider wakes on a boundary */
+		slot->next_due = ((s_info.now / slot->provider->period) + 1) * slot->provider->period;
+		/* On failure the cancel callback has freed the job already */
+		slot->thread = ecore_thread_run(_compute_thread_cb, _compute_end_cb, _compute_cancel_cb, job);
+		if (slot->thread == NULL)
+		{
+			dlog_print(DLOG_ERROR, LOG_TAG, "Failed to run complication %s", slot->provider->name);
+			continue;
+		}
+
+		spent += slot->cost;
+	}
+
+	return ECORE_CALLBACK_CANCEL;
+}
+
+/**
+ * @brief Compute and publish a new value. Runs on a worker thread.
+ * @param[in] data The job
+ * @param[in] thread The thread
+ */
+static void _compute_thread_cb(void *data, Ecore_Thread *thread)
+{
+	complication_job_s *job = data;
+	const complication_provider_s *provider = job->slot->provider;
+	complication_value_s *value = NULL;
+	double start = ecore_time_get();
+
+	value = calloc(1, sizeof(complication_value_s));
+	if (value == NULL)
+		return;
+
+	value->computed_at = job->now;
+
+	if (!provider->compute(job->now, value, provider->user_data))
+	{
+		free(value);
+		return;
+	}
+
+	/* The old value is freed on the main loop, where readers run */
+	job->old_value = __atomic_exchange_n(&job->slot->value, value, __ATOMIC_ACQ_REL);
+	job->cost = ecore_time_get() - start;
+}
+
+/**
+ * @brief Finish a job on the main loop.
+ * @param[in] data The job
+ * @param[in] thread The thread
+ */
+static void _compute_end_cb(void *data, Ecore_Thread *thread)
+{
+	complication_job_s *job = data;
+
+	// Ending a job wakes the main loop on its own
+	wakeup_count(WAKEUP_SOURCE_COMPLICATION);
+
+	job->slot->thread = NULL;
+	job->slot->cost = job->cost;
+
+	if (job->cost > COMPLICATION_TICK_BUDGET)
+		dlog_print(DLOG_WARN, LOG_TAG, "complication %s took %.1f ms", job->slot->provider->name, job->cost * 1000.0f);
+
+	free(job->old_value);
+	free(job);
+}
+
+/**
+ * @brief Drop a job cancelled by finalize, or one that failed to start.
+ * @param[in] data The job
+ * @param[in] thread The thread, NULL if it failed to start
+ */
+static void _compute_cancel_cb(void *data, Ecore_Thread *thread)
+{
+	complication_job_s *job = data;
+
+	job->slot->thread = NULL;
+
+	/* A job that never started keeps the value shown until the next period */
+	if (thread)
+		free(__atomic_exchange_n(&job->slot->value, NULL, __ATOMIC_ACQ_REL));
+
+	free(job->old_value);
+	free(job);
+}
@@ -2,18 +2,47 @@
 #include <Elementary.h>
 #include <efl_extension.h>
 #include <dlog.h>
+#include <math.h>
 
 #include "look.h"
 #include "data.h"
+#include "view.h"
 
 #define MINIMUM_DAY_DIFFERENCE 32
 
+/* New moon of 6 January 2000, 18:14 UTC */
+#define MOONPHASE_NEW_MOON_JD 2451550.1
+#define MOONPHASE_SYNODIC_MONTH 29.530588853
+
 typedef struct _date_info {
 	int year;
 	int month;
 	int day;
 } date_info_s;
 
+typedef struct _resolution_profile {
+	int size;
+	const char *dir;
+} resolution_profile_s;
+
+/*
+ * Display sizes with pre-scaled assets (see tools/scale_assets.sh).
+ * The first entry is the design size the original assets are drawn at.
+ */
+static const resolution_profile_s s_profiles[] = {
+	{ BASE_WIDTH, "" },
+	{ 396, "396/" },
+	{ 450, "450/" },
+};
+
+static struct data_info {
+	const resolution_profile_s *profile;
+	int size;
+} s_info = {
+	.profile = &s_profiles[0],
+	.size = BASE_WIDTH,
+};
+
 /**
  * @brief Get path of resource.
  * @param[in] file_in File name
@@ -29,6 +58,81 @@ void data_get_resource_path(const char *file_in, char *file_path_out, int file_p
 	}
 }
 
+/**
+ * @brief Get path of resource for the active resolution profile.
+ * @param[in] file_in File name, e.g. "images/watch_bg.png"
+ * @param[out] file_path_out The point to which save full path of the resource
+ * @param[in] file_path_max Size of file name include path
+ */
+void data_get_profile_resource_path(const char *file_in, char *file_path_out, int file_path_max)
+{
+	char file[PATH_MAX] = { 0, };
+	const char *name = strrchr(file_in, '/');
+	int dir_len = 0;
+
+	/* "images/watch_bg.png" -> "images/450/watch_bg.png" */
+	name = name ? name + 1 : file_in;
+	dir_len = name - file_in;
+	snprintf(file, sizeof(file), "%.*s%s%s", dir_len, file_in, s_info.profile->dir, name);
+
+	data_get_resource_path(file, file_path_out, file_path_max);
+}
+
+/**
+ * @brief Select the resolution profile for the window size.
+ * @param[in] width The width of the window
+ * @param[in] height The height of the window
+ */
+void data_set_resolution(int width, int height)
+{
+	/* A profile is only used when both its images and its theme were generated */
+	const char *files[] = { IMAGE_BG, EDJ_FILE };
+	char path[PATH_MAX] = { 0, };
+	int size = (width < height) ? width : height;
+	int i = 0;
+	int j = 0;
+
+	s_info.size = size;
+	s_info.profile = &s_profiles[0];
+
+	for (i = 1; i < (int)(sizeof(s_profiles) / sizeof(s_profiles[0])); i++) {
+		if (s_profiles[i].size != size)
+			continue;
+
+		s_info.profile = &s_profiles[i];
+
+		/* Fall back to the design assets if this profile was not generated */
+		for (j = 0; j < (int)(sizeof(files) / sizeof(files[0])); j++) {
+			data_get_profile_resource_path(files[j], path, sizeof(path));
+			if (access(path, R_OK) != 0) {
+				dlog_print(DLOG_WARN, LOG_TAG, "No %s for %dpx, scaling %dpx assets", files[j], size, BASE_WIDTH);
+				s_info.profile = &s_profiles[0];
+				break;
+			}
+		}
+		break;
+	}
+
+	dlog_print(DLOG_INFO, LOG_TAG, "resolution %dx%d, assets for %dpx", width, height, s_info.profile->size);
+}
+
+/**
+ * @brief Scale a layout value from the design size to the display size.
+ * @param[in] value The value at BASE_WIDTH
+ */
+int data_scale(int value)
+{
+	return ((value * s_info.size) + (BASE_WIDTH / 2)) / BASE_WIDTH;
+}
+
+/**
+ * @brief Get the scale factor from the design size to the display size.
+ */
+double data_get_scale_factor(void)
+{
+	return (double)s_info.size / BASE_WIDTH;
+}
+
 /**
  * @brief Initialization function for data module.
  */
@@ -52,16 +156,44 @@ void data_finalize(void)
 }
 
 /**
- * @brief Get plus angle for the hour hand.
+ * @brief Get the hour hand angle in fixed point, see HOUR_FX_PER_DEGREE.
+ * @param[in] hour Current hour, in either hour format
  * @param[in] minute Current minute
  * @param[in] second Current second
+ * @param[in] step The seconds the hand moves by, e.g. 60 to move once a minute
  */
-int data_get_hour_plus_angle(int minute, int second)
+int data_get_hour_angle_fx(int hour, int minute, int second, int step)
 {
-	double minutes = minute + ((second/60) * 0.5);
-	double angle = minutes * 0.5;
+	int fx = ((hour % 12) * 3600) + (minute * 60) + second;
+
+	if (step > 1)
+		fx -= fx % step;
+
+	return fx;
+}
 
-	return angle;
+/**
+ * @brief Convert a fixed point hour hand angle to degrees.
+ * @param[in] fx The angle, see data_get_hour_angle_fx()
+ */
+double data_get_hour_fx_degree(int fx)
+{
+	return (double)fx / HOUR_FX_PER_DEGREE;
+}
+
+/**
+ * @brief Get the pixel the tip of a hand is at, relative to its pivot.
+ * @param[in] degree The hand angle, clockwise from 12 o'clock
+ * @param[in] radius The distance from the pivot to the tip, in pixels
+ * @param[out] x The tip column
+ * @param[out] y The tip row
+ */
+void data_get_hand_tip(double degree, int radius, int *x, int *y)
+{
+	double rad = degree * M_PI / 180.0;
+
+	*x = (int)lround(radius * sin(rad));
+	*y = (int)lround(-radius * cos(rad));
 }
 
 /**
@@ -82,45 +214,48 @@ char *data_get_parts_image_path(parts_type_e type)
 	char image_path[PATH_MAX] = { 0, };
 	char *resource_image = NULL;
 
+	/*
+	 * The second hand and its shadow are drawn by the layout_module_second
+	 * Edje group, so their images only live in main.edj. The calendar
+	 * hands have no image and are not made.
+	 */
 	switch (type) {
-	case PARTS_TYPE_HANDS_SEC:
-		resource_image = IMAGE_HANDS_SEC;
-		break;
 	case PARTS_TYPE_HANDS_MIN:
 		resource_image = IMAGE_HANDS_MIN;
 		break;
 	case PARTS_TYPE_HANDS_HOUR:
 		resource_image = IMAGE_HANDS_HOUR;
 		break;
-	case PARTS_TYPE_HANDS_MODULE_MONTH:
-	case PARTS_TYPE_HANDS_MODULE_WEEKDAY:
-		resource_image = IMAGE_HANDS_MODULE_CALENDAR;
-		break;
-	case PARTS_TYPE_HANDS_SEC_SHADOW:
-		resource_image = IMAGE_HANDS_SEC_SHADOW;
-		break;
 	case PARTS_TYPE_HANDS_MIN_SHADOW:
 		resource_image = IMAGE_HANDS_MIN_SHADOW;
 		break;
 	case PARTS_TYPE_HANDS_HOUR_SHADOW:
 		resource_image = IMAGE_HANDS_HOUR_SHADOW;
 		break;
-	case PARTS_TYPE_HANDS_MODULE_MONTH_SHADOW:
-	case PARTS_TYPE_HANDS_MODULE_WEEKDAY_SHADOW:
-		resource_image = IMAGE_HANDS_MODULE_CALENDAR_SHADOW;
-		break;
 	case PARTS_TYPE_HANDS_BAT:
 		resource_image = IMAGE_HANDS_BAT;
 		break;
+	case PARTS_TYPE_HANDS_GMT:
+		resource_image = IMAGE_HANDS_GMT;
+		break;
+	case PARTS_TYPE_HANDS_CHRONO:
+		resource_image = IMAGE_HANDS_CHRONO;
+		break;
 	case PARTS_TYPE_HANDS_BAT_SHADOW:
 		resource_image = IMAGE_HANDS_BAT_SHADOW;
 		break;
+	case PARTS_TYPE_MOONPHASE_DISC:
+		resource_image = IMAGE_MOONPHASE_DISC;
+		break;
+	case PARTS_TYPE_MOONPHASE_WINDOW:
+		resource_image = IMAGE_MOONPHASE_WINDOW;
+		break;
 	default:
 		dlog_print(DLOG_ERROR, LOG_TAG, "type error : %d", type);
 		return NULL;
 	}
 
-	data_get_resource_path(resource_image, image_path, sizeof(image_path));
+	data_get_profile_resource_path(resource_image, image_path, sizeof(image_path));
 
 	return strdup(image_path);
 }
@@ -140,6 +275,7 @@ void data_get_parts_position(parts_type_e type, int *x, int *y)
 		*y = 0;
 		break;
 	case PARTS_TYPE_HANDS_MIN:
+	case PARTS_TYPE_HANDS_CHRONO:
 		*x = (BASE_WIDTH / 2) - (HANDS_MIN_WIDTH / 2);
 		*y = 0;
 		break;
@@ -164,14 +300,22 @@ void data_get_parts_position(parts_type_e type, int *x, int *y)
 		*y = get_a_centered_on_b(HANDS_BAT_HEIGHT, BASE_HEIGHT) - HANDS_BAT_Y_PADDING;
 		break;
 	case PARTS_TYPE_HANDS_BAT_SHADOW:
+	case PARTS_TYPE_HANDS_GMT:
 		*x = get_a_centered_on_b(HANDS_BAT_WIDTH, BASE_WIDTH);
 		*y = get_a_centered_on_b(HANDS_BAT_HEIGHT, BASE_HEIGHT) - HANDS_BAT_Y_PADDING;
 		break;
+	case PARTS_TYPE_MOONPHASE_DISC:
+	case PARTS_TYPE_MOONPHASE_WINDOW:
+		*x = get_a_centered_on_b(MODULE_MOONPHASE_WINDOW_SIZE, BASE_WIDTH);
+		*y = MODULE_MOONPHASE_TOP_PADDING;
+		break;
 	default:
 		dlog_print(DLOG_ERROR, LOG_TAG, "type error : %d", type);
-		break;
+		return;
 	}
 
+	*x = data_scale(*x);
+	*y = data_scale(*y);
 }
 
 
@@ -186,7 +330,7 @@ bool set_object_background_image(Evas_Object* obj, const char* image)
 	char path[PATH_MAX] = { 0, };
 	int ret = 0;
 
-	data_get_resource_path(image, path, sizeof(path));
+	data_get_profile_resource_path(image, path, sizeof(path));
 
 	ret = elm_bg_file_set(obj, path, NULL);
 	if (ret != EINA_TRUE)
@@ -198,6 +342,28 @@ bool set_object_background_image(Evas_Object* obj, const char* image)
 	return true;
 }
 
+/**
+ * @brief Set the image of a part.
+ * @param[in] obj The part
+ * @param[in] image The image, relative to the profile resources
+ */
+bool set_object_image(Evas_Object* obj, const char* image)
+{
+	char path[PATH_MAX] = { 0, };
+	int ret = 0;
+
+	data_get_profile_resource_path(image, path, sizeof(path));
+
+	ret = elm_image_file_set(obj, path, NULL);
+	if (ret != EINA_TRUE)
+	{
+		dlog_print(DLOG_ERROR, LOG_TAG, "Failed to set image");
+		return false;
+	}
+
+	return true;
+}
+
 /**
  * @brief Get a width size of the part.
  * @param[in] type The part type
@@ -213,6 +379,7 @@ int data_get_parts_width_size(parts_type_e type)
 		break;
 	case PARTS_TYPE_HANDS_MIN:
 	case PARTS_TYPE_HANDS_MIN_SHADOW:
+	case PARTS_TYPE_HANDS_CHRONO:
 		parts_width = HANDS_MIN_WIDTH;
 		break;
 	case PARTS_TYPE_HANDS_HOUR:
@@ -221,6 +388,7 @@ int data_get_parts_width_size(parts_type_e type)
 		break;
 	case PARTS_TYPE_HANDS_BAT:
 	case PARTS_TYPE_HANDS_BAT_SHADOW:
+	case PARTS_TYPE_HANDS_GMT:
 		parts_width = HANDS_BAT_WIDTH;
 		break;
 	case PARTS_TYPE_HANDS_MODULE_MONTH:
@@ -229,12 +397,16 @@ int data_get_parts_width_size(parts_type_e type)
 	case PARTS_TYPE_HANDS_MODULE_WEEKDAY_SHADOW:
 		parts_width = HANDS_MODULE_CALENDAR_WIDTH;
 		break;
+	case PARTS_TYPE_MOONPHASE_DISC:
+	case PARTS_TYPE_MOONPHASE_WINDOW:
+		parts_width = MODULE_MOONPHASE_WINDOW_SIZE;
+		break;
 	default:
 		dlog_print(DLOG_ERROR, LOG_TAG, "type error : %d", type);
 		break;
 	}
 
-	return parts_width;
+	return data_scale(parts_width);
 }
 
 /**
@@ -252,6 +424,7 @@ int data_get_parts_height_size(parts_type_e type)
 		break;
 	case PARTS_TYPE_HANDS_MIN:
 	case PARTS_TYPE_HANDS_MIN_SHADOW:
+	case PARTS_TYPE_HANDS_CHRONO:
 		parts_height = HANDS_MIN_HEIGHT;
 		break;
 	case PARTS_TYPE_HANDS_HOUR:
@@ -260,6 +433,7 @@ int data_get_parts_height_size(parts_type_e type)
 		break;
 	case PARTS_TYPE_HANDS_BAT:
 	case PARTS_TYPE_HANDS_BAT_SHADOW:
+	case PARTS_TYPE_HANDS_GMT:
 		parts_height = HANDS_BAT_HEIGHT;
 		break;
 	case PARTS_TYPE_HANDS_MODULE_MONTH:
@@ -268,14 +442,81 @@ int data_get_parts_height_size(parts_type_e type)
 	case PARTS_TYPE_HANDS_MODULE_WEEKDAY_SHADOW:
 		parts_height = HANDS_MODULE_CALENDAR_HEIGHT;
 		break;
+	case PARTS_TYPE_MOONPHASE_DISC:
+		parts_height = MODULE_MOONPHASE_WINDOW_SIZE;
+		break;
+	case PARTS_TYPE_MOONPHASE_WINDOW:
+		/* The window only covers the top half of the disc */
+		parts_height = MODULE_MOONPHASE_WINDOW_SIZE / 2;
+		break;
 	default:
 		dlog_print(DLOG_ERROR, LOG_TAG, "type error : %d", type);
 		break;
 	}
 
-	return parts_height;
+	return data_scale(parts_height);
 }
 
+/**
+ * @brief Get the Julian day number of a Gregorian date.
+ * @param[in] day The day of the month
+ * @param[in] month The month, 1 to 12
+ * @param[in] year The year
+ */
+int data_get_juliandate(int day, int month, int year)
+{
+	int a = (14 - month) / 12;
+	int y = year + 4800 - a;
+	int m = month + (12 * a) - 3;
+
+	return day + (((153 * m) + 2) / 5) + (365 * y) + (y / 4) - (y / 100) + (y / 400) - 32045;
+}
+
+/**
+ * @brief Get the moon phase of a date at noon UTC.
+ * @param[in] day The day of the month
+ * @param[in] month The month, 1 to 12
+ * @param[in] year The year
+ * @return The phase, 0.0 is the new moon and 0.5 the full moon
+ */
+float data_get_moonphase(int day, int month, int year)
+{
+	double lunations = (data_get_juliandate(day, month, year) - MOONPHASE_NEW_MOON_JD) / MOONPHASE_SYNODIC_MONTH;
+	double phase = lunations - (long)lunations;
+
+	if (phase < 0.0f)
+		phase += 1.0f;
+
+	return phase;
+}
+
+/**
+ * @brief Get the step of the moon phase disc.
+ * @param[in] phase The phase, 0.0 to 1.0
+ */
+int data_get_moonphase_step(float phase)
+{
+	return (int)(phase * MODULE_MOONPHASE_STEPS) % MODULE_MOONPHASE_STEPS;
+}
+
+/**
+ * @brief Compute the moon phase complication. Called once a day.
+ * @param[in] now The current UTC timestamp
+ * @param[out] value_out The phase and its disc step
+ * @param[in] user_data The user data
+ */
+bool data_compute_moonphase(time_t now, complication_value_s *value_out, void *user_data)
+{
+	struct tm tm_now = { 0, };
+
+	if (gmtime_r(&now, &tm_now) == NULL)
+		return false;
+
+	value_out->value = data_get_moonphase(tm_now.tm_mday, tm_now.tm_mon + 1, tm_now.tm_year + 1900);
+	value_out->step = data_get_moonphase_step(value_out->value);
+
+	return true;
+}
 
 char* get_day_of_week(int day)
 {
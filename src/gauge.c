@@ -0,0 +1,160 @@
+#include <math.h>
+#include <string.h>
+
+#include "gauge.h"
+
+static struct gauge_info {
+	bool sampled;
+	double last_time;
+	double level;
+	int percent;
+	bool charging;
+	bool low;
+	double anchor_time;
+	int anchor_percent;
+	double rate; /* percent per hour, 0 while not known */
+} s_info = {
+	.sampled = false,
+	.last_time = 0.0f,
+	.level = 0.0f,
+	.percent = 0,
+	.charging = false,
+	.low = false,
+	.anchor_time = 0.0f,
+	.anchor_percent = 0,
+	.rate = 0.0f,
+};
+
+/**
+ * @brief Start measuring the discharge rate again from a sample.
+ */
+static void _set_anchor(double now, int percent)
+{
+	s_info.anchor_time = now;
+	s_info.anchor_percent = percent;
+}
+
+/**
+ * @brief Initialization function for gauge module.
+ */
+void gauge_initialize(void)
+{
+	memset(&s_info, 0, sizeof(s_info));
+}
+
+/**
+ * @brief Finalization function for gauge module.
+ */
+void gauge_finalize(void)
+{
+	gauge_initialize();
+}
+
+/**
+ * @brief Feed the gauge with a reading of the battery.
+ * @param[in] now The time of the reading, in seconds
+ * @param[in] percent The raw battery percent
+ * @param[in] charging True while the battery is charging
+ */
+void gauge_update(double now, int percent, bool charging)
+{
+	double measure = 0.0f;
+
+	// The first reading, or the clock was set back
+	if (!s_info.sampled || now < s_info.last_time)
+	{
+		s_info.sampled = true;
+		s_info.level = percent;
+		s_info.rate = 0.0f;
+		_set_anchor(now, percent);
+	}
+	else
+	{
+		// Weighted by the time since the last reading, as ticks come every second or every minute
+		s_info.level += (percent - s_info.level) * (1.0 - exp(-(now - s_info.last_time) / GAUGE_SMOOTHING_TAU));
+	}
+
+	s_info.last_time = now;
+	s_info.percent = percent;
+	s_info.charging = charging;
+
+	// Measured from one drop of the raw percent to another, restarted by charging
+	if (charging || percent >= s_info.anchor_percent + GAUGE_RATE_RISE)
+	{
+		s_info.rate = 0.0f;
+		_set_anchor(now, percent);
+	}
+	else if (percent < s_info.anchor_percent && now - s_info.anchor_time >= GAUGE_RATE_MIN_SPAN)
+	{
+		measure = (s_info.anchor_percent - percent) * 3600.0 / (now - s_info.anchor_time);
+		if (s_info.rate > 0.0f)
+			s_info.rate += GAUGE_RATE_WEIGHT * (measure - s_info.rate);
+		else
+			s_info.rate = measure;
+		_set_anchor(now, percent);
+	}
+}
+
+/**
+ * @brief Get the smoothed battery level.
+ * @return The level in percent, or -1 before the first reading
+ */
+double gauge_get_level(void)
+{
+	return s_info.sampled ? s_info.level : -1.0f;
+}
+
+/**
+ * @brief Check the low battery state. It is entered at the low level and
+ * only left GAUGE_LOW_HYSTERESIS percent above it, so it does not flicker.
+ * @param[in] low_level The low battery level, in percent
+ */
+bool gauge_is_low(int low_level)
+{
+	if (!s_info.sampled)
+		return s_info.low;
+
+	if (!s_info.low && s_info.level <= low_level)
+		s_info.low = true;
+	else if (s_info.low && s_info.level > low_level + GAUGE_LOW_HYSTERESIS)
+		s_info.low = false;
+
+	return s_info.low;
+}
+
+/**
+ * @brief Get the discharge rate.
+ * @return The rate in percent per hour, or 0 while not known
+ */
+double gauge_get_rate(void)
+{
+	double span = s_info.last_time - s_info.anchor_time;
+	double bound = 0.0f;
+
+	if (s_info.charging || s_info.rate <= 0.0f)
+		return 0.0f;
+
+	// A drop not seen for longer than the rate allows means it has slowed down
+	if (span > 0.0f)
+	{
+		bound = (s_info.anchor_percent - s_info.percent + 1) * 3600.0 / span;
+		if (bound < s_info.rate)
+			return bound;
+	}
+
+	return s_info.rate;
+}
+
+/**
+ * @brief Estimate the time until the battery is empty.
+ * @return The time in minutes, or -1 while charging or not known
+ */
+int gauge_get_time_to_empty(void)
+{
+	double rate = gauge_get_rate();
+
+	if (rate <= 0.0f)
+		return -1;
+
+	return (int)lround((s_info.level / rate) * 60.0);
+}
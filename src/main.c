@@ -4,12 +4,25 @@
 #include <watch_app_efl.h>
 #include <system_settings.h>
 #include <efl_extension.h>
+#include <Ecore_Input.h>
 #include <dlog.h>
 #include <device/battery.h>
+#include <limits.h>
 
 #include "look.h"
 #include "view.h"
 #include "data.h"
+#include "complication.h"
+#include "chrono.h"
+#include "snapshot.h"
+#include "wakeup.h"
+#include "spring.h"
+#include "render.h"
+#include "settings.h"
+#include "scene.h"
+#include "preload.h"
+#include "memreport.h"
+#include "gauge.h"
 
 static struct main_info {
 	int sec_min_restart;
@@ -20,6 +33,42 @@ static struct main_info {
 	bool low_battery;
 	bool smooth_tick;
 	int cur_min;
+	double min_degree;
+	bool minute_anchored;
+	int hour_fx;
+	int hour_tip_x;
+	int hour_tip_y;
+	double hour_degree;
+	int moonphase_id;
+	int cur_moonphase_step;
+	bool utc_offset_valid;
+	bool dst;
+	int utc_offset;
+	int cur_gmt_min;
+	Ecore_Event_Handler *chrono_press_handler;
+	Ecore_Event_Handler *chrono_tap_handler;
+	bool chrono_pressed;
+	int chrono_press_x;
+	int chrono_press_y;
+	Ecore_Idler *hydrate_idler;
+	double create_time;
+	bool warm_start;
+	bool first_frame_pending;
+	spring_h day_spring;
+	Ecore_Idler *mode_idler;
+	Ecore_Idler *lookahead_idler;
+	int lookahead_min;
+	double lookahead_hour_degree;
+	bool lookahead_ambient;
+	bool preloading;
+	double mode_start_time;
+	double mode_critical_ms;
+	int bat_tip_x;
+	int bat_tip_y;
+	char readout[8];
+	int chrono_minutes;
+	settings_shadow_e shadow_tier;
+	settings_shadow_e shadow_images;
 } s_info = {
 	.sec_min_restart = 0,
 	.cur_day = 0,
@@ -28,12 +77,88 @@ static struct main_info {
 	.ambient = false,
 	.low_battery = false,
 	.smooth_tick = false,
-	.cur_min = 0
+	.cur_min = 0,
+	.min_degree = 0.0f,
+	.minute_anchored = false,
+	.hour_fx = -1,
+	.hour_tip_x = INT_MIN,
+	.hour_tip_y = INT_MIN,
+	.hour_degree = 0.0f,
+	.moonphase_id = -1,
+	.cur_moonphase_step = -1,
+	.utc_offset_valid = false,
+	.dst = false,
+	.utc_offset = 0,
+	.cur_gmt_min = -1,
+	.chrono_press_handler = NULL,
+	.chrono_tap_handler = NULL,
+	.chrono_pressed = false,
+	.chrono_press_x = 0,
+	.chrono_press_y = 0,
+	.hydrate_idler = NULL,
+	.create_time = 0.0f,
+	.warm_start = false,
+	.first_frame_pending = true,
+	.day_spring = NULL,
+	.mode_idler = NULL,
+	.lookahead_idler = NULL,
+	.lookahead_min = -1,
+	.lookahead_hour_degree = -1.0f,
+	.lookahead_ambient = false,
+	.preloading = false,
+	.mode_start_time = 0.0f,
+	.mode_critical_ms = 0.0f,
+	.bat_tip_x = INT_MIN,
+	.bat_tip_y = INT_MIN,
+	.readout = { 0, },
+	.chrono_minutes = -1,
+	.shadow_tier = SETTINGS_SHADOW_SOFT,
+	.shadow_images = SETTINGS_SHADOW_SOFT
 };
 
+static const complication_provider_s s_moonphase_provider = {
+	.name = "moonphase",
+	.period = COMPLICATION_PERIOD_DAY,
+	.compute = data_compute_moonphase,
+	.user_data = NULL,
+};
+
+static view_scheme_e _get_scheme(void);
+static void _apply_scheme(Evas_Object *bg);
+static void _rotate_hands(Evas_Object *bg, const char *hand_key, const char *shadow_key, double degree, int shadow_padding);
+static void _prepare_hands(Evas_Object *bg, const char *hand_key, const char *shadow_key, double degree, int shadow_padding);
+static int _get_hour_step(void);
+static bool _get_hour_tip_moved(int fx, int *tip_x, int *tip_y);
+static void _set_hour(int hour, int min, int sec);
+static void _schedule_lookahead(void);
+static Eina_Bool _lookahead_cb(void *data);
+static void _set_minute_swallowed(Evas_Object *bg, bool swallowed);
+static void _anchor_minute(void);
+static void _set_smooth_tick(bool smooth_tick);
 static void _set_time(int hour, int min, int sec);
 static void _set_date(int day, int month, int day_of_week);
-static void _set_battery(int bat);
+static bool _read_battery(time_t timestamp);
+static void _set_battery(void);
+static void _set_battery_readout(void);
+static void _set_moonphase(void);
+static void _set_gmt(watch_time_h watch_time);
+static void _set_chrono(chrono_state_e state, double elapsed);
+static void _set_chrono_minutes(int minutes);
+static Eina_Bool _chrono_press_cb(void *data, int type, void *event);
+static Eina_Bool _chrono_tap_cb(void *data, int type, void *event);
+static Eina_Bool _hydrate_cb(void *data);
+static void _watch_first_frame(void);
+static bool _set_image(Evas_Object *obj, const char *image, bool background);
+static void _preload_variants(void);
+static Eina_Bool _mode_deferred_cb(void *data);
+static void _mode_frame_cb(void *data, Evas *e, void *event_info);
+static void _save_snapshot(void);
+static void _report_memory(app_control_h app_control);
+static void _day_spring_cb(double angle, void *data);
+static void _day_clicked_cb(void *data, Evas_Object *obj, const char *emission, const char *source);
+static void _set_shadows_visible(Evas_Object *bg, bool visible);
+static void _apply_shadow_tier(Evas_Object *bg);
+static void _settings_changed_cb(unsigned int changed, void *user_data);
 static Evas_Object *_create_parts(parts_type_e type);
 static void _create_base_gui(int width, int height);
 
@@ -69,6 +194,9 @@ void region_changed(app_event_info_h event_info, void* user_data)
 	/*
 	 * Takes necessary actions when region setting is changed
 	 */
+
+	//	Flag UTC offset to be resolved on the next tick
+	s_info.utc_offset_valid = false;
 }
 
 /**
@@ -122,6 +250,19 @@ static bool app_create(int width, int height, void* user_data)
 	 */
 
 	app_event_handler_h handlers[5] = { NULL, };
+	Evas_Object *win = NULL;
+
+	s_info.create_time = ecore_time_get();
+
+	/*
+	 * Count wakeups from the start
+	 */
+	wakeup_initialize();
+
+	/*
+	 * Map the saved settings before anything is drawn
+	 */
+	settings_initialize(_settings_changed_cb, NULL);
 
 	/*
 	 * Register callbacks for each system event
@@ -143,6 +284,50 @@ static bool app_create(int width, int height, void* user_data)
 
 	dlog_print(DLOG_DEBUG, LOG_TAG, "%s", __func__);
 
+	/*
+	 * Pick the layout and assets for this display
+	 */
+	data_set_resolution(width, height);
+	render_set_backend(&render_backend_efl);
+
+	/*
+	 * Prepare the complication providers before the first tick
+	 */
+	complication_initialize();
+
+	/*
+	 * Image variants are decoded in the background after the first frame
+	 */
+	preload_initialize();
+
+	/*
+	 * The timer keeps counting whether or not it is drawn
+	 */
+	chrono_initialize(_set_chrono);
+	spring_initialize();
+	scene_initialize();
+	gauge_initialize();
+
+	/*
+	 * Show the last frame at once and build the scene when idle
+	 */
+	if (watch_app_get_elm_win(&win) == APP_ERROR_NONE)
+	{
+		evas_object_resize(win, width, height);
+		evas_object_show(win);
+
+		s_info.warm_start = snapshot_show(win, width, height);
+		if (s_info.warm_start)
+		{
+			s_info.hydrate_idler = ecore_idler_add(_hydrate_cb, NULL);
+			if (s_info.hydrate_idler)
+				return true;
+
+			snapshot_hide();
+			s_info.warm_start = false;
+		}
+	}
+
 	/*
 	 * Create base GUI
 	 */
@@ -162,6 +347,8 @@ static void app_control(app_control_h app_control, void *user_data)
 	/*
 	 * Handle the launch request.
 	 */
+	settings_update(app_control);
+	_report_memory(app_control);
 }
 
 /**
@@ -174,12 +361,15 @@ static void app_pause(void *user_data)
 	 * Take necessary actions when application becomes invisible.
 	 */
 
-	s_info.smooth_tick = false;
+	_set_smooth_tick(false);
+
+	chrono_set_active(false);
+
+	_save_snapshot();
 
 	/* //TODO: Commented out because this might trigger a hangup
 
 	edje_object_signal_emit(view_get_module_second_layout(),"second_stop_tick","");
-	edje_object_signal_emit(view_get_module_minute_layout(),"minute_stop_tick","");
 	*/
 
 }
@@ -195,7 +385,15 @@ static void app_resume(void *user_data)
 	 */
 
 	//	Flag smooth tick for restart
-	s_info.smooth_tick = false;
+	_set_smooth_tick(false);
+
+	//	The minute sweep may have drifted while invisible
+	s_info.minute_anchored = false;
+
+	//	The time zone may have been changed while invisible
+	s_info.utc_offset_valid = false;
+
+	chrono_set_active(!s_info.ambient);
 
 }
 
@@ -205,6 +403,47 @@ static void app_resume(void *user_data)
  */
 static void app_terminate(void *user_data)
 {
+	if (s_info.hydrate_idler)
+	{
+		ecore_idler_del(s_info.hydrate_idler);
+		s_info.hydrate_idler = NULL;
+	}
+
+	// No frame is drawn from here on, the one saved last stays
+	snapshot_cancel();
+
+	if (s_info.mode_idler)
+	{
+		ecore_idler_del(s_info.mode_idler);
+		s_info.mode_idler = NULL;
+	}
+
+	if (s_info.lookahead_idler)
+	{
+		ecore_idler_del(s_info.lookahead_idler);
+		s_info.lookahead_idler = NULL;
+	}
+
+	if (s_info.chrono_press_handler)
+	{
+		ecore_event_handler_del(s_info.chrono_press_handler);
+		s_info.chrono_press_handler = NULL;
+	}
+
+	if (s_info.chrono_tap_handler)
+	{
+		ecore_event_handler_del(s_info.chrono_tap_handler);
+		s_info.chrono_tap_handler = NULL;
+	}
+
+	chrono_finalize();
+	spring_finalize();
+	scene_finalize();
+	gauge_finalize();
+	complication_finalize();
+	preload_finalize();
+	wakeup_finalize();
+	settings_finalize();
 	view_destroy_base_gui();
 }
 
@@ -222,7 +461,13 @@ void app_time_tick(watch_time_h watch_time, void* user_data)
 	int month = 0;
 	int day = 0;
 	int day_of_week = 0;
-	int battery_level = 0;
+	time_t timestamp = 0;
+
+	wakeup_count(WAKEUP_SOURCE_TIME_TICK);
+
+	// Drawn by the idler that builds the scene
+	if (s_info.hydrate_idler)
+		return;
 
 	watch_time_get_hour(watch_time, &hour);
 	watch_time_get_minute(watch_time, &min);
@@ -231,17 +476,23 @@ void app_time_tick(watch_time_h watch_time, void* user_data)
 	watch_time_get_month(watch_time, &month);
 	watch_time_get_year(watch_time, &year);
 	watch_time_get_day_of_week(watch_time, &day_of_week);
+	watch_time_get_utc_timestamp(watch_time, &timestamp);
 
-	int ret = device_battery_get_percent(&battery_level);
-	if (ret != 0)
-	{
-		dlog_print(DLOG_ERROR, LOG_TAG, "Failed to get battery level");
+	if (!_read_battery(timestamp))
 		return;
-	}
 
 	_set_time(hour, min, sec);
 	_set_date(day, month, day_of_week);
-	_set_battery(battery_level);
+	_set_battery();
+	_set_moonphase();
+	_set_gmt(watch_time);
+	scene_commit();
+	_watch_first_frame();
+	_schedule_lookahead();
+
+	if (settings_get()->complications)
+		complication_update(timestamp);
+	wakeup_report(timestamp);
 }
 
 /**
@@ -253,36 +504,54 @@ void app_ambient_tick(watch_time_h watch_time, void* user_data)
 {
 	int hour = 0;
 	int min = 0;
-	int battery_level = 0;
+	time_t timestamp = 0;
+
+	wakeup_count(WAKEUP_SOURCE_AMBIENT_TICK);
+
+	if (s_info.hydrate_idler)
+		return;
 
 	watch_time_get_hour(watch_time, &hour);
 	watch_time_get_minute(watch_time, &min);
+	watch_time_get_utc_timestamp(watch_time, &timestamp);
 
 	_set_time(hour, min, 0);
-
-	int ret = device_battery_get_percent(&battery_level);
-	if (ret != 0)
-	{
-		dlog_print(DLOG_ERROR, LOG_TAG, "Failed to get battery level");
+	scene_commit();
+	_watch_first_frame();
+	_schedule_lookahead();
+	if (settings_get()->complications)
+		complication_update(timestamp);
+	wakeup_report(timestamp);
+
+	if (!_read_battery(timestamp))
 		return;
-	}
 
-	_set_battery(battery_level);
+	_set_battery();
+	scene_commit();
 }
 
 /**
  * @brief Called when the device enters or exits the ambient mode.
+ * Only what the first frame of the new mode shows is changed here, the
+ * rest is left to _mode_deferred_cb() once that frame is out.
  * @param[in] ambient_mode If @c true the device enters the ambient mode, otherwise @c false
  * @param[in] user_data The user data to be passed to the callback functions
  */
 void app_ambient_changed(bool ambient_mode, void* user_data)
 {
+	double start = ecore_time_get();
+
 	s_info.ambient = ambient_mode;
+	wakeup_set_ambient(ambient_mode);
 
 	Evas_Object *bg = NULL;
 	Evas_Object *object = NULL;
 	Evas_Object *hands = NULL;
 
+	// Applied by the idler that builds the scene
+	if (s_info.hydrate_idler)
+		return;
+
 	bg = view_get_bg();
 	if (bg == NULL)
 	{
@@ -292,85 +561,189 @@ void app_ambient_changed(bool ambient_mode, void* user_data)
 
 	if (ambient_mode) // Ambient
 	{
-		// Set Watchface
-		set_object_background_image(bg, (s_info.low_battery ? IMAGE_BG_AMBIENT_LOWBAT : IMAGE_BG_AMBIENT));
+		/*
+		 * Set Watchface. Not a tint of the normal dial, which is opaque grey
+		 * throughout where the ambient one is black. The low battery dial
+		 * drops some of the ambient trimmings as well as turning them red.
+		 */
+		if (!_set_image(bg, (s_info.low_battery ? IMAGE_BG_AMBIENT_LOWBAT : IMAGE_BG_AMBIENT), true))
+			dlog_print(DLOG_ERROR, LOG_TAG, "Failed to set the ambient watchface");
 
 		object = view_get_bg_plate();
-		evas_object_hide(object);
+		scene_set_visible((render_object_h)object, false);
+
+		// Set Moon Phase
+		view_set_moonphase_visible(false);
 
 		// Set Day
 		object = view_get_module_day_layout();
-		edje_object_signal_emit(object,"set_ambient","");
+		view_send_hand_state(object, 0, VIEW_MODE_AMBIENT, _get_scheme());
 
 		if (s_info.low_battery)
 		{
-			evas_object_hide(object);
+			scene_set_visible((render_object_h)object, false);
 		}
 
 		//Set Battery Hand
 		hands = evas_object_data_get(bg, "__HANDS_BAT__");
-		evas_object_hide(hands);
+		scene_set_visible((render_object_h)hands, false);
 		hands = evas_object_data_get(bg, "__HANDS_BAT_SHADOW__");
-		evas_object_hide(hands);
+		scene_set_visible((render_object_h)hands, false);
+
+		//Set GMT Hand
+		hands = evas_object_data_get(bg, "__HANDS_GMT__");
+		scene_set_visible((render_object_h)hands, false);
+
+		//Set Chrono Hand, stopped by the deferred stage
+		hands = evas_object_data_get(bg, "__HANDS_CHRONO__");
+		scene_set_visible((render_object_h)hands, false);
+		_set_chrono_minutes(-1);
+
+		/*
+		 * The ambient hands have their own shape, not just a colour: no
+		 * counterweight below the pivot, and mostly the bright lume insert
+		 * where the normal hands are mostly dark body. The swap hits images
+		 * _preload_variants() keeps decoded.
+		 */
 
-		//Set Minute Hand
-		set_object_background_image(evas_object_data_get(bg, "__HANDS_MIN__"), (s_info.low_battery ? IMAGE_HANDS_MIN_AMBIENT_LOWBAT : IMAGE_HANDS_MIN_AMBIENT));
+		//Set Minute Hand, back from the minute module so it can be cropped
+		_set_minute_swallowed(bg, false);
+		if (!_set_image(evas_object_data_get(bg, "__HANDS_MIN__"), IMAGE_HANDS_MIN_AMBIENT, false))
+			dlog_print(DLOG_ERROR, LOG_TAG, "Failed to set the ambient minute hand");
 
 		hands = evas_object_data_get(bg, "__HANDS_MIN_SHADOW__");
-		evas_object_hide(hands);
+		scene_set_visible((render_object_h)hands, false);
 
 		//Set Hour Hand
-		set_object_background_image(evas_object_data_get(bg, "__HANDS_HOUR__"), (s_info.low_battery ? IMAGE_HANDS_HOUR_AMBIENT_LOWBAT : IMAGE_HANDS_HOUR_AMBIENT));
+		if (!_set_image(evas_object_data_get(bg, "__HANDS_HOUR__"), IMAGE_HANDS_HOUR_AMBIENT, false))
+			dlog_print(DLOG_ERROR, LOG_TAG, "Failed to set the ambient hour hand");
 
 		hands = evas_object_data_get(bg, "__HANDS_HOUR_SHADOW__");
-		evas_object_hide(hands);
+		scene_set_visible((render_object_h)hands, false);
 
-		//Set Second Hand
+		//Set Second Hand, its sweep is stopped by the deferred stage
 		object = view_get_module_second_layout();
-		edje_object_signal_emit(object,"second_set_ambient","");
-		evas_object_hide(object);
+		scene_set_visible((render_object_h)object, false);
 
-		/*TODO: Commented out as smooth tick is re-implemented
-		//Set Minute Hand
-		object = view_get_module_minute_layout();
-		edje_object_signal_emit(object,"minute_set_ambient","");
-		*/
+		_set_smooth_tick(false);
 
-		s_info.smooth_tick = false;
+		_apply_scheme(bg);
 
+		// Crop the hour and minute hands to their lit part
+		_rotate_hands(bg, "__HANDS_MIN__", "__HANDS_MIN_SHADOW__", s_info.min_degree, HANDS_MIN_SHADOW_PADDING);
+		_rotate_hands(bg, "__HANDS_HOUR__", "__HANDS_HOUR_SHADOW__", s_info.hour_degree, HANDS_HOUR_SHADOW_PADDING);
 	}
 	else // Non-ambient
 	{
 		// Set Watchface
-		set_object_background_image(bg, IMAGE_BG);
+		if (!_set_image(bg, IMAGE_BG, true))
+			dlog_print(DLOG_ERROR, LOG_TAG, "Failed to set the watchface");
 		object = view_get_bg_plate();
-		evas_object_show(object);
+		scene_set_visible((render_object_h)object, true);
 
 		//Set Day
 		object = view_get_module_day_layout();
-		evas_object_show(object);
-		edje_object_signal_emit(object,"set_default","");
+		scene_set_visible((render_object_h)object, true);
+		view_send_hand_state(object, 0, VIEW_MODE_NORMAL, _get_scheme());
 
 		//Set Battery Hand
 		hands = evas_object_data_get(bg, "__HANDS_BAT__");
-		evas_object_show(hands);
-		hands = evas_object_data_get(bg, "__HANDS_BAT_SHADOW__");
-		evas_object_show(hands);
+		scene_set_visible((render_object_h)hands, true);
 
 		//Set Second Hand
-		hands = view_get_module_second_layout();
-		evas_object_show(hands);
+		if (settings_get()->second_mode != SETTINGS_SECOND_OFF)
+		{
+			hands = view_get_module_second_layout();
+			scene_set_visible((render_object_h)hands, true);
+		}
 
-		//Set Minute Hand
-		set_object_background_image(evas_object_data_get(bg, "__HANDS_MIN__"), IMAGE_HANDS_MIN);
-		hands = evas_object_data_get(bg, "__HANDS_MIN_SHADOW__");
-		evas_object_show(hands);
+		//Set Minute Hand, swept by the minute module again
+		if (!_set_image(evas_object_data_get(bg, "__HANDS_MIN__"), IMAGE_HANDS_MIN, false))
+			dlog_print(DLOG_ERROR, LOG_TAG, "Failed to set the minute hand");
+		_set_minute_swallowed(bg, true);
 
 		//Set Hour Hand
-		set_object_background_image(evas_object_data_get(bg, "__HANDS_HOUR__"), IMAGE_HANDS_HOUR);
-		hands = evas_object_data_get(bg, "__HANDS_HOUR_SHADOW__");
-		evas_object_show(hands);
+		if (!_set_image(evas_object_data_get(bg, "__HANDS_HOUR__"), IMAGE_HANDS_HOUR, false))
+			dlog_print(DLOG_ERROR, LOG_TAG, "Failed to set the hour hand");
+
+		//Set Shadows
+		_set_shadows_visible(bg, s_info.shadow_tier != SETTINGS_SHADOW_OFF);
+
+		_apply_scheme(bg);
+
+		// Restore the full hands and their shadows, the next tick anchors the minute at its second
+		_anchor_minute();
+		s_info.minute_anchored = false;
+		_rotate_hands(bg, "__HANDS_HOUR__", "__HANDS_HOUR_SHADOW__", s_info.hour_degree, HANDS_HOUR_SHADOW_PADDING);
+	}
+
+	scene_commit();
+
+	// A switch before the last one is drawn is measured from the last one
+	s_info.mode_start_time = start;
+	s_info.mode_critical_ms = (ecore_time_get() - start) * 1000.0;
+	evas_event_callback_del(evas_object_evas_get(bg), EVAS_CALLBACK_RENDER_POST, _mode_frame_cb);
+	evas_event_callback_add(evas_object_evas_get(bg), EVAS_CALLBACK_RENDER_POST, _mode_frame_cb, NULL);
+
+	// Idlers run after the frame is rendered
+	if (s_info.mode_idler == NULL)
+		s_info.mode_idler = ecore_idler_add(_mode_deferred_cb, NULL);
+	_schedule_lookahead();
+}
+
+/**
+ * @brief Finish the last mode switch with what its first frame could do without.
+ * Applies the mode current when it runs, so a switch back in between is handled.
+ * @param[in] data The user data
+ */
+static Eina_Bool _mode_deferred_cb(void *data)
+{
+	Evas_Object *bg = NULL;
+
+	s_info.mode_idler = NULL;
+
+	bg = view_get_bg();
+	if (bg == NULL)
+		return ECORE_CALLBACK_CANCEL;
+
+	if (s_info.ambient)
+	{
+		//Stop the second hand sweep
+		view_send_hand_state(view_get_module_second_layout(), 0, VIEW_MODE_AMBIENT, _get_scheme());
+
+		//Keep the timer counting on without frames until the watch wakes
+		chrono_set_active(false);
+	}
+	else
+	{
+		// Set Moon Phase
+		view_set_moonphase_visible(settings_get()->complications);
+
+		//Set GMT Hand
+		scene_set_visible(evas_object_data_get(bg, "__HANDS_GMT__"), true);
+
+		//Set Chrono Hand, caught up on its first frame
+		chrono_set_active(true);
+
+		scene_commit();
 	}
+
+	return ECORE_CALLBACK_CANCEL;
+}
+
+/**
+ * @brief Report the latency of the last mode switch once its first frame is rendered.
+ * @param[in] data The user data
+ * @param[in] e The canvas
+ * @param[in] event_info The event information
+ */
+static void _mode_frame_cb(void *data, Evas *e, void *event_info)
+{
+	evas_event_callback_del(e, EVAS_CALLBACK_RENDER_POST, _mode_frame_cb);
+
+	dlog_print(DLOG_INFO, LOG_TAG, "ambient: %s frame after %.1f ms (critical stage %.1f ms)",
+			s_info.ambient ? "enter" : "exit",
+			(ecore_time_get() - s_info.mode_start_time) * 1000.0, s_info.mode_critical_ms);
 }
 
 /**
@@ -400,6 +773,32 @@ int main(int argc, char *argv[])
 	return ret;
 }
 
+/**
+ * @brief Get the colour scheme for the current mode.
+ */
+static view_scheme_e _get_scheme(void)
+{
+	if (!s_info.ambient)
+		return VIEW_SCHEME_DEFAULT;
+
+	return s_info.low_battery ? VIEW_SCHEME_AMBIENT_LOWBAT : VIEW_SCHEME_AMBIENT;
+}
+
+/**
+ * @brief Tint the hands and the day window with the colour scheme for the current mode.
+ * @param[in] bg The bg object holding the hands
+ */
+static void _apply_scheme(Evas_Object *bg)
+{
+	view_scheme_e scheme = _get_scheme();
+
+	view_send_hand_state(view_get_module_day_layout(), 0, s_info.ambient ? VIEW_MODE_AMBIENT : VIEW_MODE_NORMAL, scheme);
+
+	view_set_scheme_color(evas_object_data_get(bg, "__HANDS_MIN__"), scheme);
+	view_set_scheme_color(evas_object_data_get(bg, "__HANDS_HOUR__"), scheme);
+	view_set_scheme_color(evas_object_data_get(bg, "__HANDS_BAT__"), s_info.low_battery ? VIEW_SCHEME_LOWBAT : VIEW_SCHEME_DEFAULT);
+}
+
 /**
  * @brief Set time at the watch.
  * @pram[in] hour The hour number
@@ -410,8 +809,6 @@ static void _set_time(int hour, int min, int sec)
 {
 	Evas_Object *bg = NULL;
 	Evas_Object *hands = NULL;
-	Evas_Object *hands_shadow = NULL;
-	double degree = 0.0f;
 
 	bg = view_get_bg();
 	if (bg == NULL)
@@ -423,43 +820,284 @@ static void _set_time(int hour, int min, int sec)
 	/*
 	 * Rotate hands at the watch
 	 */
-	if (!s_info.ambient && !s_info.smooth_tick)
+	if (!s_info.ambient && !s_info.smooth_tick && settings_get()->second_mode != SETTINGS_SECOND_OFF)
 	{
-		s_info.smooth_tick = true;
-		degree = sec * SEC_ANGLE;
+		_set_smooth_tick(true);
 		hands = view_get_module_second_layout();
-		view_rotate_hand(hands, degree, (BASE_WIDTH / 2), (BASE_HEIGHT / 2));
-		edje_object_signal_emit(hands,"second_start_tick","");
+		view_send_hand_state(hands, sec * SEC_ANGLE, VIEW_MODE_NORMAL, _get_scheme());
+	}
+
+	s_info.min_degree = (min * MIN_ANGLE) + data_get_minute_plus_angle(sec);
+	if (s_info.ambient)
+		_rotate_hands(bg, "__HANDS_MIN__", "__HANDS_MIN_SHADOW__", s_info.min_degree, HANDS_MIN_SHADOW_PADDING);
+	else if (!s_info.minute_anchored || s_info.cur_min != min)
+		_anchor_minute();
+
+	s_info.cur_min = min;
+
+	_set_hour(hour, min, sec);
+}
+
+/**
+ * @brief Get the seconds the hour hand moves by. Ambient ticks come once a minute.
+ */
+static int _get_hour_step(void)
+{
+	if (s_info.ambient)
+		return 60;
+
+	switch (settings_get()->hour_step) {
+	case SETTINGS_HOUR_CONTINUOUS:
+		return 1;
+	case SETTINGS_HOUR_10S:
+		return 10;
+	default:
+		return 60;
+	}
+}
+
+/**
+ * @brief Check if the hour hand tip would be on another pixel at an angle.
+ * @param[in] fx The angle, see data_get_hour_angle_fx()
+ * @param[out] tip_x The tip column at that angle
+ * @param[out] tip_y The tip row at that angle
+ */
+static bool _get_hour_tip_moved(int fx, int *tip_x, int *tip_y)
+{
+	data_get_hand_tip(data_get_hour_fx_degree(fx), data_scale(BASE_HEIGHT / 2), tip_x, tip_y);
+
+	return *tip_x != s_info.hour_tip_x || *tip_y != s_info.hour_tip_y;
+}
+
+/**
+ * @brief Move the hour hand by its step, redrawing it only once its tip changes pixel.
+ * @param[in] hour Current hour
+ * @param[in] min Current minute
+ * @param[in] sec Current second
+ */
+static void _set_hour(int hour, int min, int sec)
+{
+	int fx = data_get_hour_angle_fx(hour, min, sec, _get_hour_step());
+	int tip_x = 0, tip_y = 0;
+
+	if (fx == s_info.hour_fx)
+		return;
+
+	s_info.hour_fx = fx;
+	if (!_get_hour_tip_moved(fx, &tip_x, &tip_y))
+		return;
+
+	s_info.hour_tip_x = tip_x;
+	s_info.hour_tip_y = tip_y;
+	s_info.hour_degree = data_get_hour_fx_degree(fx);
+	_rotate_hands(view_get_bg(), "__HANDS_HOUR__", "__HANDS_HOUR_SHADOW__", s_info.hour_degree, HANDS_HOUR_SHADOW_PADDING);
+}
+
+/**
+ * @brief Rotate a hand and its shadow.
+ * @param[in] bg The bg object holding the hands
+ * @param[in] hand_key The data key of the hand
+ * @param[in] shadow_key The data key of the shadow hand, or NULL
+ * @param[in] degree The degree you want to rotate
+ * @param[in] shadow_padding The shadow offset at the design size
+ */
+static void _rotate_hands(Evas_Object *bg, const char *hand_key, const char *shadow_key, double degree, int shadow_padding)
+{
+	Evas_Coord cx = data_scale(BASE_WIDTH / 2);
+	Evas_Coord cy = data_scale(BASE_HEIGHT / 2);
+	Evas_Coord visible_h = 0;
+
+	/* In ambient only the part above the pivot is lit, so only that is mapped */
+	if (s_info.ambient)
+		visible_h = data_scale(HANDS_AMBIENT_VISIBLE_HEIGHT);
+
+	scene_set_transform(evas_object_data_get(bg, hand_key), degree, cx, cy, visible_h);
+
+	/* The scene holds back the transform of a hidden shadow until it is shown */
+	if (shadow_key)
+		scene_set_transform(evas_object_data_get(bg, shadow_key), degree, cx, cy + data_scale(shadow_padding), 0);
+}
+
+/**
+ * @brief Prepare the transforms of a hand and its shadow for a later _rotate_hands().
+ * @param[in] bg The watch bg
+ * @param[in] hand_key The bg data key of the hand
+ * @param[in] shadow_key The bg data key of its shadow, can be NULL
+ * @param[in] degree The degree the hand will be rotated
+ * @param[in] shadow_padding The shadow offset below the hand, at the base size
+ */
+static void _prepare_hands(Evas_Object *bg, const char *hand_key, const char *shadow_key, double degree, int shadow_padding)
+{
+	Evas_Coord cx = data_scale(BASE_WIDTH / 2);
+	Evas_Coord cy = data_scale(BASE_HEIGHT / 2);
+	Evas_Coord visible_h = 0;
+
+	// Same geometry as _rotate_hands(), or the prepared map is not used
+	if (s_info.ambient)
+		visible_h = data_scale(HANDS_AMBIENT_VISIBLE_HEIGHT);
+
+	scene_prepare_transform(evas_object_data_get(bg, hand_key), degree, cx, cy, visible_h);
+	if (shadow_key)
+		scene_prepare_transform(evas_object_data_get(bg, shadow_key), degree, cx, cy + data_scale(shadow_padding), 0);
+}
+
+/**
+ * @brief Prepare the next hand positions once the current tick is drawn.
+ */
+static void _schedule_lookahead(void)
+{
+	if (s_info.lookahead_idler || s_info.hydrate_idler)
+		return;
+
+	s_info.lookahead_idler = ecore_idler_add(_lookahead_cb, NULL);
+}
+
+/**
+ * @brief Work out the next hand transforms while idle, so the tick that
+ * moves a hand only sets them.
+ * The minute hand is swept by its module out of ambient, and an unchanged
+ * battery hand issues nothing, so only the hour hand is left outside ambient.
+ * @param[in] data The user data
+ */
+static Eina_Bool _lookahead_cb(void *data)
+{
+	Evas_Object *bg = NULL;
+	int step = _get_hour_step();
+	int fx = s_info.hour_fx;
+	int tip_x = 0, tip_y = 0;
+	int i = 0;
+
+	s_info.lookahead_idler = NULL;
+
+	// Again once a hand has moved, or a mode switch has changed the crop
+	if (s_info.lookahead_min == s_info.cur_min && s_info.lookahead_hour_degree == s_info.hour_degree &&
+			s_info.lookahead_ambient == s_info.ambient)
+		return ECORE_CALLBACK_CANCEL;
+
+	bg = view_get_bg();
+	if (bg == NULL || fx < 0)
+		return ECORE_CALLBACK_CANCEL;
+
+	s_info.lookahead_min = s_info.cur_min;
+	s_info.lookahead_hour_degree = s_info.hour_degree;
+	s_info.lookahead_ambient = s_info.ambient;
+
+	// The first step that takes the hour hand tip to another pixel
+	fx -= fx % step;
+	for (i = 0; i < HOUR_FX_TURN / step; i++)
+	{
+		fx = (fx + step) % HOUR_FX_TURN;
+		if (_get_hour_tip_moved(fx, &tip_x, &tip_y))
+			break;
 	}
 
-	degree = (min * MIN_ANGLE) + data_get_minute_plus_angle(sec);
-	hands = evas_object_data_get(bg, "__HANDS_MIN__");
-	view_rotate_hand(hands, degree, (BASE_WIDTH / 2), (BASE_HEIGHT / 2));
-	hands_shadow = evas_object_data_get(bg, "__HANDS_MIN_SHADOW__");
-	view_rotate_hand(hands_shadow, degree, (BASE_WIDTH / 2), (BASE_HEIGHT / 2) + HANDS_MIN_SHADOW_PADDING);
+	_prepare_hands(bg, "__HANDS_HOUR__", "__HANDS_HOUR_SHADOW__", data_get_hour_fx_degree(fx), HANDS_HOUR_SHADOW_PADDING);
+
+	// The minute changes on the tick at second 0
+	if (s_info.ambient)
+		_prepare_hands(bg, "__HANDS_MIN__", "__HANDS_MIN_SHADOW__", ((s_info.cur_min + 1) % 60) * MIN_ANGLE, HANDS_MIN_SHADOW_PADDING);
+
+	return ECORE_CALLBACK_CANCEL;
+}
+
+/**
+ * @brief Move the minute hand and its shadow into the minute module, or back onto the bg.
+ * The module turns them in normal mode, in ambient they are cropped by _rotate_hands().
+ * @param[in] bg The bg object holding the hands
+ * @param[in] swallowed True to move them into the module
+ */
+static void _set_minute_swallowed(Evas_Object *bg, bool swallowed)
+{
+	Evas_Object *layout = view_get_module_minute_layout();
+	Evas_Object *hand = evas_object_data_get(bg, "__HANDS_MIN__");
+	Evas_Object *shadow = evas_object_data_get(bg, "__HANDS_MIN_SHADOW__");
+
+	if (layout == NULL)
+		return;
+
+	// Whoever holds them moves them, so the scene forgets what it set
+	scene_invalidate((render_object_h)hand);
+	scene_invalidate((render_object_h)shadow);
 
-	if (s_info.cur_min != min)
+	if (swallowed)
 	{
-		s_info.cur_min = min;
+		elm_object_part_content_set(layout, "minute_hand_shadow", shadow);
+		elm_object_part_content_set(layout, "minute_hand", hand);
+		return;
+	}
+
+	// Stop the sweep before the module lets go of the hands
+	view_send_minute_state(layout, (int)((s_info.min_degree * 10.0) + 0.5), VIEW_MODE_AMBIENT, false);
+	elm_object_part_content_unset(layout, "minute_hand_shadow");
+	elm_object_part_content_unset(layout, "minute_hand");
+
+	// Back where the module stacks them, above the moon phase and below the hour hand
+	evas_object_stack_below(shadow, layout);
+	evas_object_stack_below(hand, layout);
+}
+
+/**
+ * @brief Flag whether the second hand sweep is running.
+ * While it is, the animator runs anyway, and the frame clients take their frames on its ticks.
+ * @param[in] smooth_tick True once the sweep is started, false to restart it on the next tick
+ */
+static void _set_smooth_tick(bool smooth_tick)
+{
+	s_info.smooth_tick = smooth_tick;
+	wakeup_set_animated(smooth_tick);
+}
+
+/**
+ * @brief Anchor the minute module at the current minute angle.
+ * It sweeps the hand on to the next whole minute by itself, so the hand is
+ * only anchored once a minute, on resume and when its shadow changes.
+ */
+static void _anchor_minute(void)
+{
+	view_send_minute_state(view_get_module_minute_layout(), (int)((s_info.min_degree * 10.0) + 0.5),
+			VIEW_MODE_NORMAL, s_info.shadow_tier != SETTINGS_SHADOW_OFF);
+	s_info.minute_anchored = true;
+}
+
+/**
+ * @brief Read the battery and feed the gauge with it.
+ * @param[in] timestamp The time of the tick
+ */
+static bool _read_battery(time_t timestamp)
+{
+	int battery_level = 0;
+	bool charging = false;
 
-		degree = (hour * HOUR_ANGLE) + data_get_hour_plus_angle(min, sec);
-		hands = evas_object_data_get(bg, "__HANDS_HOUR__");
-		view_rotate_hand(hands, degree, (BASE_WIDTH / 2), (BASE_HEIGHT / 2));
-		hands_shadow = evas_object_data_get(bg, "__HANDS_HOUR_SHADOW__");
-		view_rotate_hand(hands_shadow, degree, (BASE_WIDTH / 2), (BASE_HEIGHT / 2) + HANDS_HOUR_SHADOW_PADDING);
+	int ret = device_battery_get_percent(&battery_level);
+	if (ret != 0)
+	{
+		dlog_print(DLOG_ERROR, LOG_TAG, "Failed to get battery level");
+		return false;
 	}
+
+	// Only restarts the discharge rate, so a failure is not worth dropping the tick
+	if (device_battery_is_charging(&charging) != 0)
+		charging = false;
+
+	gauge_update((double)timestamp, battery_level, charging);
+
+	return true;
 }
 
 /**
- * @brief Set battery level of the watch.
- * @pram[in] bat The battery level
+ * @brief Set battery level of the watch, from the smoothed level of the gauge.
  */
-static void _set_battery(int bat)
+static void _set_battery(void)
 {
 	Evas_Object *bg = NULL;
 	Evas_Object *hands = NULL;
 	Evas_Object *hands_shadow = NULL;
+	Evas_Coord cx = data_scale(BASE_WIDTH / 2);
+	Evas_Coord cy = data_scale(BASE_HEIGHT / 2);
 	double degree = 0.0f;
+	bool low = gauge_is_low(settings_get()->low_battery_level);
+	int radius = 0;
+	int tip_x = 0, tip_y = 0;
 
 	bg = view_get_bg();
 	if (bg == NULL)
@@ -474,73 +1112,704 @@ static void _set_battery(int bat)
 	 */
 
 	// Low Battery
-	if (bat <= LOW_BATTERY_LEVEL && !s_info.low_battery)
+	if (low && !s_info.low_battery)
 	{
 		s_info.low_battery = true;
 
-		set_object_background_image(evas_object_data_get(bg, "__HANDS_BAT__"), IMAGE_HANDS_BAT_LOWBAT);
+		_apply_scheme(bg);
+		_apply_shadow_tier(bg);
 
 		if (s_info.ambient)
 		{
-			set_object_background_image(bg, IMAGE_BG_AMBIENT_LOWBAT);
-			evas_object_hide(view_get_module_day_layout());
-			set_object_background_image(evas_object_data_get(bg, "__HANDS_MIN__"), IMAGE_HANDS_MIN_AMBIENT_LOWBAT);
-			set_object_background_image(evas_object_data_get(bg, "__HANDS_HOUR__"), IMAGE_HANDS_HOUR_AMBIENT_LOWBAT);
+			if (!_set_image(bg, IMAGE_BG_AMBIENT_LOWBAT, true))
+				dlog_print(DLOG_ERROR, LOG_TAG, "Failed to set the ambient watchface");
+			scene_set_visible((render_object_h)view_get_module_day_layout(), false);
 		}
 	}
 	// Regular Battery
-	else if (bat > LOW_BATTERY_LEVEL && s_info.low_battery)
+	else if (!low && s_info.low_battery)
 	{
 		s_info.low_battery = false;
 
-		set_object_background_image(evas_object_data_get(bg, "__HANDS_BAT__"), IMAGE_HANDS_BAT);
+		_apply_scheme(bg);
+		_apply_shadow_tier(bg);
 
 		if (s_info.ambient)
 		{
-			set_object_background_image(bg, IMAGE_BG_AMBIENT);
-			evas_object_show(view_get_module_day_layout());
-			set_object_background_image(evas_object_data_get(bg, "__HANDS_MIN__"), IMAGE_HANDS_MIN_AMBIENT);
-			set_object_background_image(evas_object_data_get(bg, "__HANDS_HOUR__"), IMAGE_HANDS_HOUR_AMBIENT);
+			if (!_set_image(bg, IMAGE_BG_AMBIENT, true))
+				dlog_print(DLOG_ERROR, LOG_TAG, "Failed to set the ambient watchface");
+			scene_set_visible((render_object_h)view_get_module_day_layout(), true);
 		}
 	}
 
-	// Rotate battery hand
+	// Rotate battery hand, once its tip moves to another pixel
 	if (!s_info.ambient)
 	{
-		degree = BATTERY_START_ANGLE + (bat * BATTERY_ANGLE);
-		hands = evas_object_data_get(bg, "__HANDS_BAT__");
-		view_rotate_hand(hands, degree, (BASE_WIDTH / 2), (BASE_HEIGHT / 2));
-		hands_shadow = evas_object_data_get(bg, "__HANDS_BAT_SHADOW__");
-		view_rotate_hand(hands_shadow, degree, (BASE_WIDTH / 2), (BASE_HEIGHT / 2) + HANDS_BAT_SHADOW_PADDING);
+		degree = BATTERY_START_ANGLE + (gauge_get_level() * BATTERY_ANGLE);
+		radius = data_scale((BASE_HEIGHT / 2) - (get_a_centered_on_b(HANDS_BAT_HEIGHT, BASE_HEIGHT) - HANDS_BAT_Y_PADDING));
+		data_get_hand_tip(degree, radius, &tip_x, &tip_y);
+
+		if (tip_x != s_info.bat_tip_x || tip_y != s_info.bat_tip_y)
+		{
+			s_info.bat_tip_x = tip_x;
+			s_info.bat_tip_y = tip_y;
+
+			hands = evas_object_data_get(bg, "__HANDS_BAT__");
+			scene_set_transform((render_object_h)hands, degree, cx, cy, 0);
+			hands_shadow = evas_object_data_get(bg, "__HANDS_BAT_SHADOW__");
+			scene_set_transform((render_object_h)hands_shadow, degree, cx, cy + data_scale(HANDS_BAT_SHADOW_PADDING), 0);
+		}
 	}
+
+	_set_battery_readout();
 }
 
 /**
- * @brief Set date at the watch.
- * @pram[in] day The day number
- * @pram[in] month The month number
- * @pram[in] day_of_week The day of week number
+ * @brief Show the time to empty in the day window, if the readout is on.
  */
-static void _set_date(int day, int month, int day_of_week)
+static void _set_battery_readout(void)
 {
-	Evas_Object *bg = NULL;
-	Evas_Object *module_layout = NULL;
-	char txt_day_num[32] = { 0, };
-	char txt_day_txt[4] = { 0, };
+	char readout[sizeof(s_info.readout)] = { 0, };
+	int minutes = 0;
 
-	/*
-	 * Set day at the watch
-	 */
-	if (s_info.cur_day != day) {
-		module_layout = view_get_module_day_layout();
+	if (!settings_get()->battery_readout || s_info.chrono_minutes >= 0)
+		return;
 
-		snprintf(txt_day_num, sizeof(txt_day_num), "%d", day);
-		view_set_text(module_layout, "txt.day.num", txt_day_num);
+	// Three characters, as the weekday it replaces
+	minutes = gauge_get_time_to_empty();
+	if (minutes < 0)
+		snprintf(readout, sizeof(readout), "--");
+	else if (minutes < 60)
+		snprintf(readout, sizeof(readout), "%dM", minutes);
+	else if (minutes < 100 * 60)
+		snprintf(readout, sizeof(readout), "%dH", minutes / 60);
+	else
+		snprintf(readout, sizeof(readout), "99H");
+
+	if (!strcmp(readout, s_info.readout))
+		return;
+
+	snprintf(s_info.readout, sizeof(s_info.readout), "%s", readout);
+	view_set_text(view_get_module_day_layout(), "txt.day.txt", s_info.readout);
+}
+
+/**
+ * @brief Turn the moon phase disc when the published phase step changes.
+ */
+static void _set_moonphase(void)
+{
+	const complication_value_s *value = NULL;
+
+	if (s_info.moonphase_id < 0 || !settings_get()->complications)
+		return;
+
+	value = complication_get_value(s_info.moonphase_id);
+	if (value == NULL || value->step == s_info.cur_moonphase_step)
+		return;
+
+	s_info.cur_moonphase_step = value->step;
+
+	/*
+	 * The disc carries two moons, so it turns half a circle per lunation.
+	 * The new moon sits behind the left hump of the window
+	 */
+	view_rotate_moonphase(((float)value->step * MOONPHASE_ANGLE / MODULE_MOONPHASE_STEPS) - (MOONPHASE_ANGLE / 2));
+}
+
+/**
+ * @brief Resolve the offset of local time from UTC, in minutes.
+ * @param[in] watch_time The watch time handle
+ */
+static void _resolve_utc_offset(watch_time_h watch_time)
+{
+	struct tm utc = { 0, };
+	int hour24 = 0;
+	int min = 0;
+	int offset = 0;
+
+	if (watch_time_get_utc_time(watch_time, &utc) != APP_ERROR_NONE)
+	{
+		dlog_print(DLOG_ERROR, LOG_TAG, "Failed to get UTC time");
+		return;
+	}
+
+	watch_time_get_hour24(watch_time, &hour24);
+	watch_time_get_minute(watch_time, &min);
+	watch_time_get_dst_status(watch_time, &s_info.dst);
+
+	// Offsets run from UTC-12 to UTC+14
+	offset = ((hour24 * 60) + min) - ((utc.tm_hour * 60) + utc.tm_min);
+	if (offset > 14 * 60)
+		offset -= 24 * 60;
+	else if (offset < -12 * 60)
+		offset += 24 * 60;
+
+	s_info.utc_offset = offset;
+	s_info.utc_offset_valid = true;
+}
+
+/**
+ * @brief Set the GMT hand, once a minute.
+ * @param[in] watch_time The watch time handle
+ */
+static void _set_gmt(watch_time_h watch_time)
+{
+	Evas_Object *bg = NULL;
+	bool dst = false;
+	int hour24 = 0;
+	int min = 0;
+	int gmt_min = 0;
+
+	watch_time_get_minute(watch_time, &min);
+	if (s_info.utc_offset_valid && min == s_info.cur_gmt_min)
+		return;
 
-		snprintf(txt_day_txt, sizeof(txt_day_txt), "%s", get_day_of_week(day_of_week));
+	bg = view_get_bg();
+	if (bg == NULL)
+	{
+		dlog_print(DLOG_ERROR, LOG_TAG, "Failed to get bg");
+		return;
+	}
+
+	// A DST boundary moves local time but not UTC
+	watch_time_get_dst_status(watch_time, &dst);
+	if (!s_info.utc_offset_valid || dst != s_info.dst)
+		_resolve_utc_offset(watch_time);
+
+	watch_time_get_hour24(watch_time, &hour24);
+	gmt_min = (((hour24 * 60) + min - s_info.utc_offset) + (24 * 60)) % (24 * 60);
+	s_info.cur_gmt_min = min;
+
+	_rotate_hands(bg, "__HANDS_GMT__", NULL, (gmt_min * GMT_HOUR_ANGLE) / 60.0f, 0);
+}
+
+/**
+ * @brief Set the timer hand, one turn a minute.
+ * @param[in] state The timer state
+ * @param[in] elapsed The elapsed time in seconds
+ */
+static void _set_chrono(chrono_state_e state, double elapsed)
+{
+	Evas_Object *bg = NULL;
+	Evas_Object *hands = NULL;
+	double sec = 0.0f;
+
+	bg = view_get_bg();
+	if (bg == NULL)
+	{
+		dlog_print(DLOG_ERROR, LOG_TAG, "Failed to get bg");
+		return;
+	}
+
+	hands = evas_object_data_get(bg, "__HANDS_CHRONO__");
+	if (state == CHRONO_STATE_RESET || s_info.ambient)
+	{
+		scene_set_visible((render_object_h)hands, false);
+		_set_chrono_minutes(-1);
+	}
+	else
+	{
+		sec = elapsed - (60 * (long)(elapsed / 60));
+		_rotate_hands(bg, "__HANDS_CHRONO__", NULL, sec * SEC_ANGLE, 0);
+		scene_set_visible((render_object_h)hands, true);
+		_set_chrono_minutes((int)(elapsed / 60));
+	}
+
+	scene_commit();
+}
+
+/**
+ * @brief Count the whole minutes of the timer in the day window, in place of the weekday.
+ * The timer hand only goes round once a minute, so this is its minute readout.
+ * @param[in] minutes The minutes to show, or -1 to give the window back
+ */
+static void _set_chrono_minutes(int minutes)
+{
+	Evas_Object *module_layout = view_get_module_day_layout();
+	char txt_day_txt[4] = { 0, };
+	char *weekday = NULL;
+
+	if (minutes == s_info.chrono_minutes)
+		return;
+
+	s_info.chrono_minutes = minutes;
+
+	if (minutes >= 0)
+	{
+		// Three characters, as the weekday it replaces
+		snprintf(txt_day_txt, sizeof(txt_day_txt), "%d'", (minutes < CHRONO_MINUTES_MAX) ? minutes : CHRONO_MINUTES_MAX);
 		view_set_text(module_layout, "txt.day.txt", txt_day_txt);
+	}
+	else if (settings_get()->battery_readout)
+	{
+		s_info.readout[0] = '\0';
+		_set_battery_readout();
+	}
+	else if (s_info.cur_day != 0)
+	{
+		weekday = get_day_of_week(s_info.cur_weekday);
+		snprintf(txt_day_txt, sizeof(txt_day_txt), "%s", weekday ? weekday : "");
+		free(weekday);
+		view_set_text(module_layout, "txt.day.txt", txt_day_txt);
+	}
+}
+
+/**
+ * @brief Remember where a press started, so the release can tell a tap from a drag.
+ * @param[in] data The user data
+ * @param[in] type The event type
+ * @param[in] event The mouse button event
+ */
+static Eina_Bool _chrono_press_cb(void *data, int type, void *event)
+{
+	Ecore_Event_Mouse_Button *ev = event;
+
+	s_info.chrono_pressed = true;
+	s_info.chrono_press_x = ev->x;
+	s_info.chrono_press_y = ev->y;
+
+	return ECORE_CALLBACK_PASS_ON;
+}
+
+/**
+ * @brief Step the timer when the plate is tapped.
+ * Taps are read from the window, so the hands stacked over the plate do not swallow them.
+ * A release that moved farther than CHRONO_TAP_SLOP from its press ends a drag, not a tap.
+ * @param[in] data The user data
+ * @param[in] type The event type
+ * @param[in] event The mouse button event
+ */
+static Eina_Bool _chrono_tap_cb(void *data, int type, void *event)
+{
+	Ecore_Event_Mouse_Button *ev = event;
+	int radius = data_scale(BG_PLATE_WIDTH / 2);
+	int slop = data_scale(CHRONO_TAP_SLOP);
+	bool pressed = s_info.chrono_pressed;
+	int dx = 0;
+	int dy = 0;
+
+	wakeup_count(WAKEUP_SOURCE_INPUT);
+
+	s_info.chrono_pressed = false;
+
+	if (s_info.ambient || !pressed)
+		return ECORE_CALLBACK_PASS_ON;
+
+	dx = ev->x - s_info.chrono_press_x;
+	dy = ev->y - s_info.chrono_press_y;
+	if ((dx * dx) + (dy * dy) > slop * slop)
+		return ECORE_CALLBACK_PASS_ON;
+
+	dx = ev->x - data_scale(BASE_WIDTH / 2);
+	dy = ev->y - data_scale(BASE_HEIGHT / 2);
+	if ((dx * dx) + (dy * dy) > radius * radius)
+		return ECORE_CALLBACK_PASS_ON;
+
+	chrono_toggle();
+
+	return ECORE_CALLBACK_PASS_ON;
+}
+
+/**
+ * @brief Build the real scene behind the last frame, then replace it.
+ * @param[in] data The user data
+ */
+static Eina_Bool _hydrate_cb(void *data)
+{
+	Evas_Object *win = NULL;
+	watch_time_h watch_time = NULL;
+	int width = 0, height = 0;
+
+	s_info.hydrate_idler = NULL;
+
+	if (watch_app_get_elm_win(&win) != APP_ERROR_NONE)
+	{
+		dlog_print(DLOG_ERROR, LOG_TAG, "Failed to get window");
+		snapshot_hide();
+		return ECORE_CALLBACK_CANCEL;
+	}
+
+	evas_object_geometry_get(win, NULL, NULL, &width, &height);
+	_create_base_gui(width, height);
+
+	if (s_info.ambient)
+		app_ambient_changed(true, NULL);
+
+	// Draw now rather than on the next tick, so no stale frame is shown in between
+	if (watch_time_get_current_time(&watch_time) == APP_ERROR_NONE)
+	{
+		if (s_info.ambient)
+			app_ambient_tick(watch_time, NULL);
+		else
+			app_time_tick(watch_time, NULL);
+
+		watch_time_delete(watch_time);
+	}
+
+	snapshot_hide();
+
+	return ECORE_CALLBACK_CANCEL;
+}
+
+/**
+ * @brief Report the startup time once the first correct frame is on screen.
+ * @param[in] data The user data
+ * @param[in] e The canvas
+ * @param[in] event_info The event information
+ */
+static void _first_frame_cb(void *data, Evas *e, void *event_info)
+{
+	evas_event_callback_del(e, EVAS_CALLBACK_RENDER_POST, _first_frame_cb);
+
+	dlog_print(DLOG_INFO, LOG_TAG, "startup: first correct frame after %.1f ms (%s start)",
+			(ecore_time_get() - s_info.create_time) * 1000.0,
+			s_info.warm_start ? "warm" : "cold");
+
+	_preload_variants();
+}
+
+/**
+ * @brief Decode the images the parts switch to, in the order they are likely needed.
+ * Images on screen now are decoded already, they are held for when switched back to.
+ */
+static void _preload_variants(void)
+{
+	static const struct {
+		const char *image;
+		preload_priority_e priority;
+	} variants[] = {
+		{ IMAGE_BG_AMBIENT, PRELOAD_PRIORITY_HIGH },
+		{ IMAGE_HANDS_MIN_AMBIENT, PRELOAD_PRIORITY_HIGH },
+		{ IMAGE_HANDS_HOUR_AMBIENT, PRELOAD_PRIORITY_HIGH },
+		{ IMAGE_BG, PRELOAD_PRIORITY_HIGH },
+		{ IMAGE_HANDS_MIN, PRELOAD_PRIORITY_HIGH },
+		{ IMAGE_HANDS_HOUR, PRELOAD_PRIORITY_HIGH },
+		{ IMAGE_BG_AMBIENT_LOWBAT, PRELOAD_PRIORITY_NORMAL },
+		{ IMAGE_HANDS_BAT, PRELOAD_PRIORITY_LOW },
+		{ IMAGE_HANDS_MIN_SHADOW, PRELOAD_PRIORITY_LOW },
+		{ IMAGE_HANDS_HOUR_SHADOW, PRELOAD_PRIORITY_LOW },
+		{ IMAGE_HANDS_BAT_SHADOW, PRELOAD_PRIORITY_LOW },
+	};
+	unsigned int i = 0;
+
+	s_info.preloading = true;
+
+	for (i = 0; i < sizeof(variants) / sizeof(variants[0]); i++)
+		preload_image(variants[i].image, variants[i].priority, NULL, NULL);
+}
+
+/**
+ * @brief Swap a decoded image into a part, unless another was asked for since.
+ * @param[in] image The image
+ * @param[in] data The part
+ */
+static void _bg_image_ready_cb(const char *image, void *data)
+{
+	const char *wanted = evas_object_data_get(data, "__IMAGE__");
+
+	if (wanted && !strcmp(wanted, image))
+		set_object_background_image(data, image);
+}
+
+/**
+ * @brief See _bg_image_ready_cb().
+ */
+static void _image_ready_cb(const char *image, void *data)
+{
+	const char *wanted = evas_object_data_get(data, "__IMAGE__");
+
+	if (wanted && !strcmp(wanted, image))
+		set_object_image(data, image);
+}
+
+/**
+ * @brief Set the image of a part without decoding it on the main loop.
+ * Before the first frame it is set at once, after it once decoded in the background.
+ * @param[in] obj The part
+ * @param[in] image The image, relative to the profile resources
+ * @param[in] background True for the elm_bg, set by set_object_background_image(), false for an elm_image, set by set_object_image()
+ * @return false if the image could not be set, or queued to be set once decoded
+ */
+static bool _set_image(Evas_Object *obj, const char *image, bool background)
+{
+	if (obj == NULL)
+		return false;
+
+	evas_object_data_set(obj, "__IMAGE__", image);
+
+	if (!s_info.preloading)
+		return background ? set_object_background_image(obj, image) : set_object_image(obj, image);
+
+	// Called at once if decoded already, a failure to set it is logged then
+	preload_image(image, PRELOAD_PRIORITY_HIGH, background ? _bg_image_ready_cb : _image_ready_cb, obj);
+
+	return true;
+}
+
+/**
+ * @brief Wait for the render of the first tick that drew the scene.
+ */
+static void _watch_first_frame(void)
+{
+	Evas_Object *bg = NULL;
+
+	if (!s_info.first_frame_pending)
+		return;
+
+	bg = view_get_bg();
+	if (bg == NULL)
+		return;
+
+	s_info.first_frame_pending = false;
+	evas_event_callback_add(evas_object_evas_get(bg), EVAS_CALLBACK_RENDER_POST, _first_frame_cb, NULL);
+}
+
+/**
+ * @brief Keep the next frame drawn for the next launch.
+ */
+static void _save_snapshot(void)
+{
+	Evas_Object *win = NULL;
+
+	if (s_info.hydrate_idler || view_get_bg() == NULL)
+		return;
+
+	if (watch_app_get_elm_win(&win) != APP_ERROR_NONE)
+		return;
+
+	snapshot_save(win);
+}
+
+/**
+ * @brief Report the memory the face uses, if the launch request asks for it.
+ * @param[in] app_control The launch request, see MEMREPORT_KEY
+ */
+static void _report_memory(app_control_h app_control)
+{
+	char edj_path[PATH_MAX] = { 0, };
+	char *target = NULL;
+
+	if (app_control_get_extra_data(app_control, MEMREPORT_KEY, &target) != APP_CONTROL_ERROR_NONE || target == NULL)
+		return;
+
+	data_get_profile_resource_path(EDJ_FILE, edj_path, sizeof(edj_path));
+	if (!memreport_dump(edj_path, target))
+		dlog_print(DLOG_ERROR, LOG_TAG, "Failed to report memory to %s", target);
+
+	free(target);
+}
+
+/**
+ * @brief Draw the day module spring.
+ * @param[in] angle The spring angle in degrees
+ * @param[in] data The day module layout
+ */
+static void _day_spring_cb(double angle, void *data)
+{
+	view_rotate_module(data, angle);
+}
+
+/**
+ * @brief Jiggle the day module when it is tapped.
+ * @param[in] data The user data
+ * @param[in] obj The layout
+ * @param[in] emission The signal
+ * @param[in] source The part the signal came from
+ */
+static void _day_clicked_cb(void *data, Evas_Object *obj, const char *emission, const char *source)
+{
+	if (s_info.ambient)
+		return;
+
+	spring_kick(s_info.day_spring, MODULE_DAY_SPRING_KICK);
+}
+
+/**
+ * @brief Show or hide the shadows of the hour, minute and battery hands.
+ * @param[in] bg The bg object holding the hands
+ * @param[in] visible True to show the shadows
+ */
+static void _set_shadows_visible(Evas_Object *bg, bool visible)
+{
+	static const char *keys[] = { "__HANDS_MIN_SHADOW__", "__HANDS_HOUR_SHADOW__", "__HANDS_BAT_SHADOW__" };
+	unsigned int i = 0;
+
+	for (i = 0; i < sizeof(keys) / sizeof(keys[0]); i++)
+		scene_set_visible(evas_object_data_get(bg, keys[i]), visible);
+}
+
+/**
+ * @brief Get the shadow tier for the settings and battery state.
+ */
+static settings_shadow_e _get_shadow_tier(void)
+{
+	settings_shadow_e tier = settings_get()->shadows;
+
+	if (tier == SETTINGS_SHADOW_AUTO)
+		return s_info.low_battery ? SETTINGS_SHADOW_HARD : SETTINGS_SHADOW_SOFT;
+
+	return tier;
+}
+
+/**
+ * @brief Switch the hour, minute and battery shadows to the current tier.
+ * Turning shadows off keeps their images, for when they are turned on again.
+ * @param[in] bg The bg object holding the hands
+ */
+static void _apply_shadow_tier(Evas_Object *bg)
+{
+	static const struct {
+		const char *key;
+		const char *hand_image;
+		const char *shadow_image;
+		bool translucent;
+	} shadows[] = {
+		{ "__HANDS_MIN_SHADOW__", IMAGE_HANDS_MIN, IMAGE_HANDS_MIN_SHADOW, true },
+		{ "__HANDS_HOUR_SHADOW__", IMAGE_HANDS_HOUR, IMAGE_HANDS_HOUR_SHADOW, true },
+		{ "__HANDS_BAT_SHADOW__", IMAGE_HANDS_BAT, IMAGE_HANDS_BAT_SHADOW, false },
+	};
+	settings_shadow_e tier = _get_shadow_tier();
+	settings_shadow_e old_tier = s_info.shadow_tier;
+	Evas_Object *shadow = NULL;
+	unsigned int i = 0;
+
+	if (tier == old_tier)
+		return;
+
+	s_info.shadow_tier = tier;
+
+	// The hard tier reuses the hand images, which are decoded already
+	if (tier != SETTINGS_SHADOW_OFF && tier != s_info.shadow_images)
+	{
+		for (i = 0; i < sizeof(shadows) / sizeof(shadows[0]); i++)
+		{
+			shadow = evas_object_data_get(bg, shadows[i].key);
+			if (tier == SETTINGS_SHADOW_HARD)
+			{
+				if (!_set_image(shadow, shadows[i].hand_image, false))
+					dlog_print(DLOG_ERROR, LOG_TAG, "Failed to set the shadow %s", shadows[i].key);
+				view_set_shadow_tint(shadow);
+			}
+			else
+			{
+				if (!_set_image(shadow, shadows[i].shadow_image, false))
+					dlog_print(DLOG_ERROR, LOG_TAG, "Failed to set the shadow %s", shadows[i].key);
+				// As in _create_parts()
+				if (shadows[i].translucent)
+					view_set_opacity_to_parts(shadow);
+				else
+					evas_object_color_set(shadow, 255, 255, 255, 255);
+			}
+		}
+
+		s_info.shadow_images = tier;
+	}
+
+	if (s_info.ambient || (tier != SETTINGS_SHADOW_OFF && old_tier != SETTINGS_SHADOW_OFF))
+		return;
+
+	_set_shadows_visible(bg, tier != SETTINGS_SHADOW_OFF);
+
+	// The minute module shows or hides its own shadow
+	_anchor_minute();
+}
+
+/**
+ * @brief Apply changed settings to the parts they affect.
+ * @param[in] changed The settings_changed_e flags of the changed settings
+ * @param[in] user_data The user data
+ */
+static void _settings_changed_cb(unsigned int changed, void *user_data)
+{
+	const settings_s *settings = settings_get();
+	Evas_Object *bg = NULL;
+	Evas_Object *object = NULL;
+
+	// Applied by _create_base_gui() once the scene exists
+	bg = view_get_bg();
+	if (bg == NULL)
+		return;
+
+	if (changed & SETTINGS_CHANGED_AMBIENT_COLOR)
+	{
+		view_set_scheme_rgb(VIEW_SCHEME_AMBIENT, settings->ambient_color[0], settings->ambient_color[1], settings->ambient_color[2]);
+		_apply_scheme(bg);
+	}
+
+	if (changed & SETTINGS_CHANGED_SHADOWS)
+		_apply_shadow_tier(bg);
+
+	if (changed & SETTINGS_CHANGED_SECOND)
+	{
+		object = view_get_module_second_layout();
+		if (settings->second_mode == SETTINGS_SECOND_OFF)
+		{
+			// Stops the sweep programs as well
+			view_send_hand_state(object, 0, VIEW_MODE_AMBIENT, _get_scheme());
+			scene_set_visible((render_object_h)object, false);
+			_set_smooth_tick(false);
+		}
+		else if (!s_info.ambient)
+		{
+			scene_set_visible((render_object_h)object, true);
+			_set_smooth_tick(false);
+		}
+	}
+
+	if (changed & SETTINGS_CHANGED_COMPLICATIONS)
+	{
+		view_set_moonphase_visible(!s_info.ambient && settings->complications);
+		s_info.cur_moonphase_step = -1;
+	}
+
+	// The next tick moves the hour hand by the new step
+	if (changed & SETTINGS_CHANGED_HOUR_STEP)
+		s_info.hour_fx = -1;
+
+	// The weekday or the readout is written again on the next tick
+	if (changed & SETTINGS_CHANGED_BATTERY_READOUT)
+	{
+		s_info.readout[0] = '\0';
+		s_info.cur_day = 0;
+	}
+
+	if ((changed & (SETTINGS_CHANGED_LOW_BATTERY | SETTINGS_CHANGED_BATTERY_READOUT)) && gauge_get_level() >= 0)
+		_set_battery();
+
+	scene_commit();
+}
+
+/**
+ * @brief Set date at the watch.
+ * @pram[in] day The day number
+ * @pram[in] month The month number
+ * @pram[in] day_of_week The day of week number
+ */
+static void _set_date(int day, int month, int day_of_week)
+{
+	Evas_Object *bg = NULL;
+	Evas_Object *module_layout = NULL;
+	char txt_day_num[32] = { 0, };
+	char txt_day_txt[4] = { 0, };
+
+	/*
+	 * Set day at the watch
+	 */
+	if (s_info.cur_day != day) {
+		module_layout = view_get_module_day_layout();
+
+		snprintf(txt_day_num, sizeof(txt_day_num), "%d", day);
+		view_set_text(module_layout, "txt.day.num", txt_day_num);
+
+		// The battery readout and the timer minutes take the place of the weekday
+		if (!settings_get()->battery_readout && s_info.chrono_minutes < 0)
+		{
+			snprintf(txt_day_txt, sizeof(txt_day_txt), "%s", get_day_of_week(day_of_week));
+			view_set_text(module_layout, "txt.day.txt", txt_day_txt);
+		}
 
 		s_info.cur_day = day;
+		s_info.cur_weekday = day_of_week;
 	}
 
 	bg = view_get_bg();
@@ -557,15 +1826,9 @@ static void _set_date(int day, int month, int day_of_week)
 static Evas_Object *_create_parts(parts_type_e type)
 {
 	Evas_Object *parts = NULL;
-	Evas_Object *bg = NULL;
 	char *parts_image_path = NULL;
 	int x = 0, y = 0, w = 0, h = 0;
 
-	/*
-	 * Get the BG
-	 */
-	bg = view_get_bg();
-
 	/*
 	 * Get the information about the part
 	 */
@@ -577,7 +1840,7 @@ static Evas_Object *_create_parts(parts_type_e type)
 	/*
 	 * Create the part object
 	 */
-	parts = view_create_parts(bg, parts_image_path, x, y, w, h);
+	parts = (Evas_Object *)render_image_add(parts_image_path, x, y, w, h);
 	if (parts == NULL) {
 		dlog_print(DLOG_ERROR, LOG_TAG, "Failed to create parts : %d", type);
 	}
@@ -608,12 +1871,17 @@ static void _create_base_gui(int width, int height)
 	Evas_Object *bg_plate = NULL;
 	Evas_Object *module_day_layout = NULL;
 	Evas_Object *module_sec_layout = NULL;
+	Evas_Object *module_min_layout = NULL;
 	Evas_Object *hands_min = NULL;
 	Evas_Object *hands_min_shadow = NULL;
 	Evas_Object *hands_hour = NULL;
 	Evas_Object *hands_hour_shadow = NULL;
 	Evas_Object *hands_bat = NULL;
 	Evas_Object *hands_bat_shadow = NULL;
+	Evas_Object *hands_gmt = NULL;
+	Evas_Object *hands_chrono = NULL;
+	Evas_Object *moonphase_disc = NULL;
+	Evas_Object *moonphase_window = NULL;
 	char bg_path[PATH_MAX] = { 0, };
 	char bg_plate_path[PATH_MAX] = { 0, };
 	char edj_path[PATH_MAX] = { 0, };
@@ -633,7 +1901,7 @@ static void _create_base_gui(int width, int height)
 	/*
 	 * Get background image file path
 	 */
-	data_get_resource_path(IMAGE_BG, bg_path, sizeof(bg_path));
+	data_get_profile_resource_path(IMAGE_BG, bg_path, sizeof(bg_path));
 
 	/*
 	 * Create BG
@@ -653,15 +1921,22 @@ static void _create_base_gui(int width, int height)
 	hands_bat = _create_parts(PARTS_TYPE_HANDS_BAT);
 	evas_object_data_set(bg, "__HANDS_BAT__", hands_bat);
 
+	/*
+	 * Create the 24 hour hand showing UTC
+	 */
+	hands_gmt = _create_parts(PARTS_TYPE_HANDS_GMT);
+	view_set_scheme_color(hands_gmt, VIEW_SCHEME_GMT);
+	evas_object_data_set(bg, "__HANDS_GMT__", hands_gmt);
+
 	/*
 	 * Get background plate image file path
 	 */
-	data_get_resource_path(IMAGE_BG_PLATE, bg_plate_path, sizeof(bg_plate_path));
+	data_get_profile_resource_path(IMAGE_BG_PLATE, bg_plate_path, sizeof(bg_plate_path));
 
 	/*
 	 * Create BG Plate
 	 */
-	bg_plate = view_create_bg_plate(bg, bg_plate_path, BG_PLATE_WIDTH, BG_PLATE_HEIGHT);
+	bg_plate = view_create_bg_plate(bg, bg_plate_path, data_scale(BG_PLATE_WIDTH), data_scale(BG_PLATE_HEIGHT));
 	if (bg_plate == NULL) {
 		dlog_print(DLOG_ERROR, LOG_TAG, "Failed to create bg plate");
 		return;
@@ -670,7 +1945,7 @@ static void _create_base_gui(int width, int height)
 	/*
 	 * Get edje file path
 	 */
-	data_get_resource_path(EDJ_FILE, edj_path, sizeof(edj_path));
+	data_get_profile_resource_path(EDJ_FILE, edj_path, sizeof(edj_path));
 
 	/*
 	 * Create layout to display day number at the watch
@@ -678,10 +1953,27 @@ static void _create_base_gui(int width, int height)
 	module_day_layout = view_create_module_layout(bg, edj_path, "layout_module_day");
 	if (module_day_layout)
 	{
-		view_set_module_property(module_day_layout, BASE_WIDTH - MODULE_DAY_NUM_SIZE - MODULE_DAY_NUM_RIGHT_PADDING, (BASE_HEIGHT / 2) - (MODULE_DAY_NUM_SIZE / 2), MODULE_DAY_NUM_SIZE, MODULE_DAY_NUM_SIZE);
+		view_set_module_property(module_day_layout,
+				data_scale(BASE_WIDTH - MODULE_DAY_NUM_SIZE - MODULE_DAY_NUM_RIGHT_PADDING),
+				data_scale((BASE_HEIGHT / 2) - (MODULE_DAY_NUM_SIZE / 2)),
+				data_scale(MODULE_DAY_NUM_SIZE), data_scale(MODULE_DAY_NUM_SIZE));
+		view_set_module_scale(module_day_layout, data_get_scale_factor());
 		view_set_module_day_layout(module_day_layout);
+
+		// One map on the whole module, instead of one per part
+		s_info.day_spring = spring_add(MODULE_DAY_SPRING_STIFFNESS, MODULE_DAY_SPRING_DAMPING,
+				data_scale(MODULE_DAY_NUM_SIZE / 2), _day_spring_cb, module_day_layout);
+		elm_layout_signal_callback_add(module_day_layout, "mouse,clicked,1", "*", _day_clicked_cb, NULL);
 	}
 
+	/*
+	 * Create moon phase disc behind its window
+	 */
+	moonphase_disc = _create_parts(PARTS_TYPE_MOONPHASE_DISC);
+	moonphase_window = _create_parts(PARTS_TYPE_MOONPHASE_WINDOW);
+	view_set_moonphase(moonphase_disc, moonphase_window);
+	s_info.moonphase_id = complication_register(&s_moonphase_provider);
+
 	/*
 	 * Create hands & shadow hands to display at the watch
 	 */
@@ -691,18 +1983,52 @@ static void _create_base_gui(int width, int height)
 	hands_min = _create_parts(PARTS_TYPE_HANDS_MIN);
 	evas_object_data_set(bg, "__HANDS_MIN__", hands_min);
 
+	/*
+	 * Create layout to sweep the minute hand, which holds the hand and its shadow
+	 */
+	module_min_layout = view_create_module_layout(bg, edj_path, "layout_module_minute");
+	if (module_min_layout)
+	{
+		view_set_module_property(module_min_layout, 0, 0, data_scale(BASE_WIDTH), data_scale(BASE_HEIGHT));
+		view_set_module_scale(module_min_layout, data_get_scale_factor());
+		view_set_module_minute_layout(module_min_layout);
+		_set_minute_swallowed(bg, true);
+	}
+
 	hands_hour_shadow = _create_parts(PARTS_TYPE_HANDS_HOUR_SHADOW);
 	evas_object_data_set(bg, "__HANDS_HOUR_SHADOW__", hands_hour_shadow);
 	hands_hour = _create_parts(PARTS_TYPE_HANDS_HOUR);
 	evas_object_data_set(bg, "__HANDS_HOUR__", hands_hour);
 
+	/*
+	 * Create the timer hand, hidden until the plate is tapped
+	 */
+	hands_chrono = _create_parts(PARTS_TYPE_HANDS_CHRONO);
+	view_set_scheme_color(hands_chrono, VIEW_SCHEME_CHRONO);
+	evas_object_hide(hands_chrono);
+	evas_object_data_set(bg, "__HANDS_CHRONO__", hands_chrono);
+
+	s_info.chrono_press_handler = ecore_event_handler_add(ECORE_EVENT_MOUSE_BUTTON_DOWN, _chrono_press_cb, NULL);
+	if (s_info.chrono_press_handler == NULL)
+		dlog_print(DLOG_ERROR, LOG_TAG, "Failed to add chrono press handler");
+
+	s_info.chrono_tap_handler = ecore_event_handler_add(ECORE_EVENT_MOUSE_BUTTON_UP, _chrono_tap_cb, NULL);
+	if (s_info.chrono_tap_handler == NULL)
+		dlog_print(DLOG_ERROR, LOG_TAG, "Failed to add chrono tap handler");
+
 	/*
 	 * Create layout to display second hand on the watch
 	 */
 	module_sec_layout = view_create_module_layout(bg, edj_path, "layout_module_second");
 	if (module_sec_layout)
 	{
-		view_set_module_property(module_sec_layout, 0, 0, 360, 360);
+		view_set_module_property(module_sec_layout, 0, 0, data_scale(BASE_WIDTH), data_scale(BASE_HEIGHT));
+		view_set_module_scale(module_sec_layout, data_get_scale_factor());
 		view_set_module_second_layout(module_sec_layout);
 	}
+
+	/*
+	 * Apply the saved settings to the new parts
+	 */
+	_settings_changed_cb(SETTINGS_CHANGED_ALL, NULL);
 }
@@ -0,0 +1,270 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "memreport.h"
+
+#define MEMREPORT_LINE_MAX 320
+
+typedef struct _memreport_entry {
+	memreport_kind_e kind;
+	char name[MEMREPORT_NAME_MAX];
+	char type[16];
+	char source[MEMREPORT_NAME_MAX];
+	int w;
+	int h;
+	long bytes;
+} memreport_entry_s;
+
+static struct memreport_info {
+	memreport_entry_s entries[MEMREPORT_ENTRY_MAX];
+	int entry_cnt;
+	int dropped;
+} s_info = {
+	.entry_cnt = 0,
+	.dropped = 0,
+};
+
+static const char *s_kind_names[MEMREPORT_KIND_MAX] = { "image", "object", "group" };
+
+/**
+ * @brief Get a new entry, or NULL once the table is full.
+ */
+static memreport_entry_s *_add(memreport_kind_e kind, const char *name)
+{
+	memreport_entry_s *entry = NULL;
+
+	if (s_info.entry_cnt == MEMREPORT_ENTRY_MAX) {
+		s_info.dropped++;
+		return NULL;
+	}
+
+	entry = &s_info.entries[s_info.entry_cnt++];
+	memset(entry, 0, sizeof(*entry));
+	entry->kind = kind;
+	snprintf(entry->name, sizeof(entry->name), "%s", name ? name : "-");
+
+	return entry;
+}
+
+static memreport_entry_s *_find(memreport_kind_e kind, const char *name)
+{
+	int i = 0;
+
+	for (i = 0; i < s_info.entry_cnt; i++) {
+		if (s_info.entries[i].kind == kind && !strcmp(s_info.entries[i].name, name))
+			return &s_info.entries[i];
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Largest first, then images, objects and groups, then by name.
+ */
+static int _compare(const void *a, const void *b)
+{
+	const memreport_entry_s *ea = *(const memreport_entry_s * const *)a;
+	const memreport_entry_s *eb = *(const memreport_entry_s * const *)b;
+
+	if (ea->bytes != eb->bytes)
+		return ea->bytes > eb->bytes ? -1 : 1;
+
+	if (ea->kind != eb->kind)
+		return ea->kind < eb->kind ? -1 : 1;
+
+	return strcmp(ea->name, eb->name);
+}
+
+/**
+ * @brief The number of objects made from a group.
+ */
+static int _count_users(const char *group)
+{
+	int users = 0;
+	int i = 0;
+
+	for (i = 0; i < s_info.entry_cnt; i++) {
+		if (s_info.entries[i].kind == MEMREPORT_KIND_OBJECT && !strcmp(s_info.entries[i].source, group))
+			users++;
+	}
+
+	return users;
+}
+
+/**
+ * @brief Start a new, empty report.
+ */
+void memreport_begin(void)
+{
+	memset(s_info.entries, 0, sizeof(s_info.entries));
+	s_info.entry_cnt = 0;
+	s_info.dropped = 0;
+}
+
+/**
+ * @brief Add a decoded image. An image added again is counted once.
+ * @param[in] name The file, or file and key, of the image
+ * @param[in] w The image width in pixels
+ * @param[in] h The image height in pixels
+ * @param[in] colorspace The name of the pixel format
+ * @param[in] bytes The decoded size
+ */
+void memreport_add_image(const char *name, int w, int h, const char *colorspace, long bytes)
+{
+	memreport_entry_s *entry = NULL;
+
+	if (name == NULL || _find(MEMREPORT_KIND_IMAGE, name))
+		return;
+
+	entry = _add(MEMREPORT_KIND_IMAGE, name);
+	if (entry == NULL)
+		return;
+
+	snprintf(entry->type, sizeof(entry->type), "%s", colorspace ? colorspace : "-");
+	entry->w = w;
+	entry->h = h;
+	entry->bytes = bytes;
+}
+
+/**
+ * @brief Add an object.
+ * @param[in] name The object name, can be NULL
+ * @param[in] type The object type, e.g. "image" or "edje"
+ * @param[in] w The object width
+ * @param[in] h The object height
+ * @param[in] source The image or group it shows, can be NULL
+ * @param[in] bytes The memory it owns besides a shared image
+ */
+void memreport_add_object(const char *name, const char *type, int w, int h, const char *source, long bytes)
+{
+	memreport_entry_s *entry = _add(MEMREPORT_KIND_OBJECT, name);
+
+	if (entry == NULL)
+		return;
+
+	snprintf(entry->type, sizeof(entry->type), "%s", type ? type : "-");
+	snprintf(entry->source, sizeof(entry->source), "%s", source ? source : "");
+	entry->w = w;
+	entry->h = h;
+	entry->bytes = bytes;
+}
+
+/**
+ * @brief Add an Edje group.
+ * @param[in] name The group name
+ * @param[in] file The file it is in
+ */
+void memreport_add_group(const char *name, const char *file)
+{
+	memreport_entry_s *entry = NULL;
+	const char *base = NULL;
+
+	if (name == NULL || _find(MEMREPORT_KIND_GROUP, name))
+		return;
+
+	entry = _add(MEMREPORT_KIND_GROUP, name);
+	if (entry == NULL)
+		return;
+
+	base = file ? strrchr(file, '/') : NULL;
+	snprintf(entry->source, sizeof(entry->source), "%s", base ? base + 1 : (file ? file : ""));
+}
+
+/**
+ * @brief Get the bytes of all the entries.
+ */
+long memreport_get_total(void)
+{
+	long total = 0;
+	int i = 0;
+
+	for (i = 0; i < s_info.entry_cnt; i++)
+		total += s_info.entries[i].bytes;
+
+	return total;
+}
+
+/**
+ * @brief Print the report, largest entries first, after a line of totals.
+ * @param[in] line_cb Called for each line
+ * @param[in] data The user data passed to the callback
+ */
+void memreport_print(memreport_line_cb line_cb, void *data)
+{
+	const memreport_entry_s *sorted[MEMREPORT_ENTRY_MAX];
+	const memreport_entry_s *entry = NULL;
+	char line[MEMREPORT_LINE_MAX] = { 0, };
+	char size[24] = { 0, };
+	long bytes[MEMREPORT_KIND_MAX] = { 0, };
+	int counts[MEMREPORT_KIND_MAX] = { 0, };
+	int i = 0;
+
+	if (line_cb == NULL)
+		return;
+
+	for (i = 0; i < s_info.entry_cnt; i++) {
+		sorted[i] = &s_info.entries[i];
+		bytes[sorted[i]->kind] += sorted[i]->bytes;
+		counts[sorted[i]->kind]++;
+	}
+
+	qsort(sorted, s_info.entry_cnt, sizeof(sorted[0]), _compare);
+
+	snprintf(line, sizeof(line), "memory: %ld KiB, %d images %ld KiB, %d objects %ld KiB, %d groups",
+			memreport_get_total() / 1024,
+			counts[MEMREPORT_KIND_IMAGE], bytes[MEMREPORT_KIND_IMAGE] / 1024,
+			counts[MEMREPORT_KIND_OBJECT], bytes[MEMREPORT_KIND_OBJECT] / 1024,
+			counts[MEMREPORT_KIND_GROUP]);
+	line_cb(line, data);
+
+	if (s_info.dropped > 0) {
+		snprintf(line, sizeof(line), "memory: %d entries over MEMREPORT_ENTRY_MAX left out", s_info.dropped);
+		line_cb(line, data);
+	}
+
+	snprintf(line, sizeof(line), "%-6s %9s %9s %-10s %s", "kind", "bytes", "size", "format", "name");
+	line_cb(line, data);
+
+	for (i = 0; i < s_info.entry_cnt; i++) {
+		entry = sorted[i];
+
+		if (entry->w > 0 || entry->h > 0)
+			snprintf(size, sizeof(size), "%dx%d", entry->w, entry->h);
+		else
+			snprintf(size, sizeof(size), "-");
+
+		if (entry->kind == MEMREPORT_KIND_GROUP)
+			snprintf(line, sizeof(line), "%-6s %9ld %9s %-10s %s (%s, %d objects)", s_kind_names[entry->kind],
+					entry->bytes, size, "-", entry->name, entry->source, _count_users(entry->name));
+		else if (entry->source[0])
+			snprintf(line, sizeof(line), "%-6s %9ld %9s %-10s %s <- %s", s_kind_names[entry->kind],
+					entry->bytes, size, entry->type, entry->name, entry->source);
+		else
+			snprintf(line, sizeof(line), "%-6s %9ld %9s %-10s %s", s_kind_names[entry->kind],
+					entry->bytes, size, entry->type, entry->name);
+
+		line_cb(line, data);
+	}
+}
+
+static void _write_line_cb(const char *line, void *data)
+{
+	fprintf((FILE *)data, "%s\n", line);
+}
+
+/**
+ * @brief Write the report to a file.
+ * @param[in] path The file to write
+ */
+bool memreport_write(const char *path)
+{
+	FILE *file = fopen(path, "w");
+
+	if (file == NULL)
+		return false;
+
+	memreport_print(_write_line_cb, file);
+
+	return fclose(file) == 0;
+}
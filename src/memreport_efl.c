@@ -0,0 +1,190 @@
+#include <app_common.h>
+#include <Elementary.h>
+#include <dlog.h>
+
+#include "look.h"
+#include "view.h"
+#include "memreport.h"
+
+/**
+ * @brief Get the name of an image colorspace and its bytes per pixel.
+ */
+static const char *_colorspace_name(Evas_Colorspace colorspace, int *bpp)
+{
+	switch (colorspace) {
+	case EVAS_COLORSPACE_ARGB8888:
+		*bpp = 4;
+		return "argb8888";
+	case EVAS_COLORSPACE_RGB565_A5P:
+		*bpp = 3;
+		return "rgb565a5p";
+	case EVAS_COLORSPACE_GRY8:
+		*bpp = 1;
+		return "gry8";
+	case EVAS_COLORSPACE_AGRY88:
+		*bpp = 2;
+		return "agry88";
+	default:
+		*bpp = 4;
+		return "other";
+	}
+}
+
+/**
+ * @brief Add an image object, and the image it shows if it comes from a file.
+ */
+static void _add_image(Evas_Object *obj, const char *name, int w, int h)
+{
+	const char *file = NULL;
+	const char *key = NULL;
+	const char *base = NULL;
+	const char *colorspace = NULL;
+	char image[MEMREPORT_NAME_MAX] = { 0, };
+	int iw = 0, ih = 0;
+	int stride = 0;
+	int bpp = 0;
+	long bytes = 0;
+
+	evas_object_image_file_get(obj, &file, &key);
+	evas_object_image_size_get(obj, &iw, &ih);
+	colorspace = _colorspace_name(evas_object_image_colorspace_get(obj), &bpp);
+
+	// Not decoded yet, the stride is what it will take once it is
+	stride = evas_object_image_stride_get(obj);
+	if (stride <= 0)
+		stride = iw * bpp;
+	bytes = (long)stride * ih;
+
+	if (file == NULL) {
+		// Pixels set by the app, owned by the object alone
+		memreport_add_object(name, "image", w, h, NULL, bytes);
+		return;
+	}
+
+	base = strrchr(file, '/');
+	if (key)
+		snprintf(image, sizeof(image), "%s:%s", base ? base + 1 : file, key);
+	else
+		snprintf(image, sizeof(image), "%s", base ? base + 1 : file);
+
+	memreport_add_image(image, iw, ih, colorspace, bytes);
+	memreport_add_object(name, "image", w, h, image, 0);
+}
+
+/**
+ * @brief Add an object and, for a smart object, its members.
+ */
+static void _add_object(Evas_Object *obj)
+{
+	Eina_List *members = NULL;
+	Evas_Object *member = NULL;
+	const char *type = evas_object_type_get(obj);
+	const char *name = evas_object_name_get(obj);
+	const char *file = NULL;
+	const char *group = NULL;
+	int w = 0, h = 0;
+
+	evas_object_geometry_get(obj, NULL, NULL, &w, &h);
+
+	if (type && !strcmp(type, "image")) {
+		_add_image(obj, name, w, h);
+	} else if (type && !strcmp(type, "edje")) {
+		edje_object_file_get(obj, &file, &group);
+		memreport_add_object(name, type, w, h, group, 0);
+	} else {
+		memreport_add_object(name, type, w, h, NULL, 0);
+	}
+
+	if (evas_object_smart_smart_get(obj) == NULL)
+		return;
+
+	members = evas_object_smart_members_get(obj);
+	EINA_LIST_FREE(members, member)
+		_add_object(member);
+}
+
+/**
+ * @brief Add every object of the canvas, bottom to top.
+ */
+static void _add_canvas(Evas *e)
+{
+	Evas_Object *obj = NULL;
+
+	// Smart members are reached through their parent
+	for (obj = evas_object_bottom_get(e); obj; obj = evas_object_above_get(obj)) {
+		if (evas_object_smart_parent_get(obj) == NULL)
+			_add_object(obj);
+	}
+}
+
+/**
+ * @brief Add the groups of an Edje file.
+ */
+static void _add_groups(const char *edj_path)
+{
+	Eina_List *groups = NULL;
+	Eina_List *l = NULL;
+	const char *group = NULL;
+
+	groups = edje_file_collection_list(edj_path);
+	if (groups == NULL) {
+		dlog_print(DLOG_ERROR, LOG_TAG, "No groups in %s", edj_path);
+		return;
+	}
+
+	EINA_LIST_FOREACH(groups, l, group)
+		memreport_add_group(group, edj_path);
+
+	edje_file_collection_list_free(groups);
+}
+
+static void _log_line_cb(const char *line, void *data)
+{
+	dlog_print(DLOG_INFO, LOG_TAG, "%s", line);
+}
+
+/**
+ * @brief Report the memory of the watch canvas and the Edje groups.
+ * @param[in] edj_path The Edje file of the face
+ * @param[in] target MEMREPORT_TO_LOG, or a file name in the app data directory
+ */
+bool memreport_dump(const char *edj_path, const char *target)
+{
+	Evas_Object *bg = view_get_bg();
+	char path[PATH_MAX] = { 0, };
+	char *data_path = NULL;
+
+	if (bg == NULL || target == NULL)
+		return false;
+
+	// A name only, so a request cannot write outside the data directory
+	if (strcmp(target, MEMREPORT_TO_LOG) && (strchr(target, '/') || target[0] == '.')) {
+		dlog_print(DLOG_ERROR, LOG_TAG, "Bad memory report file %s", target);
+		return false;
+	}
+
+	memreport_begin();
+	_add_canvas(evas_object_evas_get(bg));
+	_add_groups(edj_path);
+
+	if (!strcmp(target, MEMREPORT_TO_LOG)) {
+		memreport_print(_log_line_cb, NULL);
+		return true;
+	}
+
+	data_path = app_get_data_path();
+	if (data_path == NULL)
+		return false;
+
+	snprintf(path, sizeof(path), "%s%s", data_path, target);
+	free(data_path);
+
+	if (!memreport_write(path)) {
+		dlog_print(DLOG_ERROR, LOG_TAG, "Failed to write %s", path);
+		return false;
+	}
+
+	dlog_print(DLOG_INFO, LOG_TAG, "Memory report written to %s", path);
+
+	return true;
+}
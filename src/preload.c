@@ -0,0 +1,273 @@
+#include <Elementary.h>
+#include <dlog.h>
+
+#include "look.h"
+#include "data.h"
+#include "view.h"
+#include "preload.h"
+
+#define PRELOAD_WAITER_MAX 4
+
+typedef enum {
+	PRELOAD_STATE_QUEUED = 0,
+	PRELOAD_STATE_LOADING,
+	PRELOAD_STATE_READY,
+	PRELOAD_STATE_FAILED,
+} preload_state_e;
+
+typedef struct _preload_waiter {
+	preload_done_cb done_cb;
+	void *data;
+} preload_waiter_s;
+
+/*
+ * A hidden image object holds each decoded image in the Evas cache, so
+ * parts set to the same file later use it without decoding again
+ */
+typedef struct _preload_entry {
+	const char *image;
+	Evas_Object *holder;
+	preload_state_e state;
+	preload_priority_e priority;
+	unsigned int order;
+	preload_waiter_s waiters[PRELOAD_WAITER_MAX];
+	int waiter_cnt;
+} preload_entry_s;
+
+static struct preload_info {
+	preload_entry_s entries[PRELOAD_MAX];
+	int entry_cnt;
+	preload_entry_s *loading;
+	unsigned int order;
+} s_info = {
+	.entry_cnt = 0,
+	.loading = NULL,
+	.order = 0,
+};
+
+static void _pump(void);
+
+/**
+ * @brief Tell the waiters of an entry that it is done with.
+ */
+static void _notify(preload_entry_s *entry)
+{
+	preload_waiter_s waiters[PRELOAD_WAITER_MAX];
+	int waiter_cnt = entry->waiter_cnt;
+	int i = 0;
+
+	// A callback may ask for more images
+	memcpy(waiters, entry->waiters, sizeof(waiters));
+	entry->waiter_cnt = 0;
+
+	for (i = 0; i < waiter_cnt; i++)
+		waiters[i].done_cb(entry->image, waiters[i].data);
+}
+
+/**
+ * @brief Called on the main loop once the decode thread is done with an image.
+ */
+static void _preloaded_cb(void *data, Evas *e, Evas_Object *obj, void *event_info)
+{
+	preload_entry_s *entry = data;
+
+	entry->state = PRELOAD_STATE_READY;
+	if (s_info.loading == entry)
+		s_info.loading = NULL;
+
+	_notify(entry);
+	_pump();
+}
+
+/**
+ * @brief Start decoding an entry in the background.
+ */
+static bool _start(preload_entry_s *entry)
+{
+	char path[PATH_MAX] = { 0, };
+	Evas_Object *bg = view_get_bg();
+
+	if (bg == NULL)
+		return false;
+
+	data_get_profile_resource_path(entry->image, path, sizeof(path));
+
+	entry->holder = evas_object_image_add(evas_object_evas_get(bg));
+	if (entry->holder == NULL)
+	{
+		dlog_print(DLOG_ERROR, LOG_TAG, "Failed to add preload image");
+		return false;
+	}
+
+	// Named so a memory report tells it from the parts
+	evas_object_name_set(entry->holder, "preload");
+	evas_object_image_file_set(entry->holder, path, NULL);
+	if (evas_object_image_load_error_get(entry->holder) != EVAS_LOAD_ERROR_NONE)
+	{
+		dlog_print(DLOG_ERROR, LOG_TAG, "Failed to preload %s", path);
+		evas_object_del(entry->holder);
+		entry->holder = NULL;
+		return false;
+	}
+
+	entry->state = PRELOAD_STATE_LOADING;
+	s_info.loading = entry;
+
+	evas_object_event_callback_add(entry->holder, EVAS_CALLBACK_IMAGE_PRELOADED, _preloaded_cb, entry);
+	evas_object_image_preload(entry->holder, EINA_FALSE);
+
+	return true;
+}
+
+/**
+ * @brief Start the most urgent queued entry, one at a time.
+ */
+static void _pump(void)
+{
+	preload_entry_s *next = NULL;
+	preload_entry_s *entry = NULL;
+	int i = 0;
+
+	while (s_info.loading == NULL)
+	{
+		next = NULL;
+		for (i = 0; i < s_info.entry_cnt; i++)
+		{
+			entry = &s_info.entries[i];
+			if (entry->state != PRELOAD_STATE_QUEUED)
+				continue;
+
+			// Higher priority first, then first asked
+			if (next == NULL || entry->priority > next->priority ||
+					(entry->priority == next->priority && entry->order < next->order))
+				next = entry;
+		}
+
+		if (next == NULL || _start(next))
+			return;
+
+		next->state = PRELOAD_STATE_FAILED;
+		_notify(next);
+	}
+}
+
+static preload_entry_s *_find(const char *image)
+{
+	int i = 0;
+
+	for (i = 0; i < s_info.entry_cnt; i++)
+	{
+		if (!strcmp(s_info.entries[i].image, image))
+			return &s_info.entries[i];
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Initialization function for preload module.
+ */
+void preload_initialize(void)
+{
+	memset(s_info.entries, 0, sizeof(s_info.entries));
+	s_info.entry_cnt = 0;
+	s_info.loading = NULL;
+	s_info.order = 0;
+}
+
+/**
+ * @brief Finalization function for preload module. Waiters are not called.
+ */
+void preload_finalize(void)
+{
+	int i = 0;
+
+	for (i = 0; i < s_info.entry_cnt; i++)
+	{
+		if (s_info.entries[i].holder)
+		{
+			evas_object_event_callback_del(s_info.entries[i].holder, EVAS_CALLBACK_IMAGE_PRELOADED, _preloaded_cb);
+			evas_object_del(s_info.entries[i].holder);
+		}
+	}
+
+	preload_initialize();
+}
+
+/**
+ * @brief Decode an image in the background and keep it decoded.
+ * Asking again for a queued image raises its priority.
+ * @param[in] image The image, relative to the profile resources. It is kept, not copied.
+ * @param[in] priority The priority in the queue
+ * @param[in] done_cb Called once the image is decoded, at once if it is already. Can be NULL.
+ * @param[in] data The user data passed to the callback
+ */
+void preload_image(const char *image, preload_priority_e priority, preload_done_cb done_cb, void *data)
+{
+	preload_entry_s *entry = NULL;
+	int i = 0;
+
+	if (image == NULL)
+		return;
+
+	entry = _find(image);
+	if (entry == NULL)
+	{
+		if (s_info.entry_cnt == PRELOAD_MAX)
+		{
+			dlog_print(DLOG_ERROR, LOG_TAG, "Preload queue is full");
+			if (done_cb)
+				done_cb(image, data);
+			return;
+		}
+
+		entry = &s_info.entries[s_info.entry_cnt++];
+		memset(entry, 0, sizeof(*entry));
+		entry->image = image;
+		entry->state = PRELOAD_STATE_QUEUED;
+		entry->priority = priority;
+		entry->order = s_info.order++;
+	}
+	else if (entry->state == PRELOAD_STATE_QUEUED && priority > entry->priority)
+	{
+		entry->priority = priority;
+	}
+
+	if (done_cb)
+	{
+		for (i = 0; i < entry->waiter_cnt; i++)
+		{
+			if (entry->waiters[i].done_cb == done_cb && entry->waiters[i].data == data)
+				break;
+		}
+
+		// The same waiter asking twice is called once
+		if (entry->state == PRELOAD_STATE_READY || entry->state == PRELOAD_STATE_FAILED)
+		{
+			done_cb(image, data);
+		}
+		else if (i == entry->waiter_cnt && entry->waiter_cnt < PRELOAD_WAITER_MAX)
+		{
+			entry->waiters[entry->waiter_cnt].done_cb = done_cb;
+			entry->waiters[entry->waiter_cnt].data = data;
+			entry->waiter_cnt++;
+		}
+		else if (i == entry->waiter_cnt)
+		{
+			dlog_print(DLOG_ERROR, LOG_TAG, "Too many waiting for %s", image);
+		}
+	}
+
+	_pump();
+}
+
+/**
+ * @brief Check if an image is decoded, so setting it will not block.
+ * @param[in] image The image, relative to the profile resources
+ */
+bool preload_is_ready(const char *image)
+{
+	preload_entry_s *entry = _find(image);
+
+	return entry && entry->state == PRELOAD_STATE_READY;
+}
@@ -0,0 +1,143 @@
+#include <stddef.h>
+
+#include "render.h"
+
+static struct render_info {
+	const render_backend_s *backend;
+} s_info = {
+	.backend = NULL,
+};
+
+/**
+ * @brief Set the backend all following calls go to.
+ * Objects belong to the backend that made them, so set it before adding any.
+ * @param[in] backend The backend
+ */
+void render_set_backend(const render_backend_s *backend)
+{
+	s_info.backend = backend;
+}
+
+/**
+ * @brief Get the current backend.
+ */
+const render_backend_s *render_get_backend(void)
+{
+	return s_info.backend;
+}
+
+/**
+ * @brief Add an image object.
+ * @param[in] image_path The image path
+ * @param[in] x The x coordinate of the object
+ * @param[in] y The y coordinate of the object
+ * @param[in] w The width of the object, the image is scaled to it
+ * @param[in] h The height of the object, the image is scaled to it
+ * @return The object, or NULL on failure
+ */
+render_object_h render_image_add(const char *image_path, int x, int y, int w, int h)
+{
+	if (s_info.backend == NULL || image_path == NULL)
+		return NULL;
+
+	return s_info.backend->image_add(image_path, x, y, w, h);
+}
+
+/**
+ * @brief Rotate an object around a point, drawing only its top rows.
+ * @param[in] obj The object
+ * @param[in] degree The degree to rotate, clockwise
+ * @param[in] cx The x coordinate of the center of rotation
+ * @param[in] cy The y coordinate of the center of rotation
+ * @param[in] visible_h The rows from the top to draw, 0 for all
+ */
+void render_set_transform(render_object_h obj, double degree, int cx, int cy, int visible_h)
+{
+	if (s_info.backend == NULL || obj == NULL)
+		return;
+
+	s_info.backend->set_transform(obj, degree, cx, cy, visible_h);
+}
+
+/**
+ * @brief Multiply an object by a premultiplied colour.
+ * @param[in] obj The object
+ * @param[in] r The red component
+ * @param[in] g The green component
+ * @param[in] b The blue component
+ * @param[in] a The alpha component
+ */
+void render_set_color(render_object_h obj, int r, int g, int b, int a)
+{
+	if (s_info.backend == NULL || obj == NULL)
+		return;
+
+	s_info.backend->set_color(obj, r, g, b, a);
+}
+
+/**
+ * @brief Show or hide an object.
+ * @param[in] obj The object
+ * @param[in] visible True to show the object
+ */
+void render_set_visible(render_object_h obj, bool visible)
+{
+	if (s_info.backend == NULL || obj == NULL)
+		return;
+
+	s_info.backend->set_visible(obj, visible);
+}
+
+/**
+ * @brief Set the text of a part of an object.
+ * @param[in] obj The object
+ * @param[in] part_name The part name
+ * @param[in] text The text
+ */
+void render_set_text(render_object_h obj, const char *part_name, const char *text)
+{
+	if (s_info.backend == NULL || obj == NULL)
+		return;
+
+	s_info.backend->set_text(obj, part_name, text);
+}
+
+/**
+ * @brief Delete an object.
+ * @param[in] obj The object
+ */
+void render_del(render_object_h obj)
+{
+	if (s_info.backend == NULL || obj == NULL)
+		return;
+
+	s_info.backend->del(obj);
+}
+
+/**
+ * @brief Freeze the backend around a batch of calls, if it supports it.
+ * @param[in] frozen True before the batch, false after it
+ */
+void render_set_frozen(bool frozen)
+{
+	if (s_info.backend == NULL || s_info.backend->set_frozen == NULL)
+		return;
+
+	s_info.backend->set_frozen(frozen);
+}
+
+/**
+ * @brief Let the backend work out a transform ahead of the call that sets it, if it supports it.
+ * @param[in] obj The object
+ * @param[in] degree The degree it will be rotated, clockwise
+ * @param[in] cx The x coordinate of the center of rotation
+ * @param[in] cy The y coordinate of the center of rotation
+ * @param[in] visible_h The rows from the top to draw, 0 for all
+ */
+void render_prepare_transform(render_object_h obj, double degree, int cx, int cy, int visible_h)
+{
+	if (s_info.backend == NULL || s_info.backend->prepare_transform == NULL || obj == NULL)
+		return;
+
+	s_info.backend->prepare_transform(obj, degree, cx, cy, visible_h);
+}
@@ -0,0 +1,93 @@
+#include <Elementary.h>
+#include <dlog.h>
+
+#include "look.h"
+#include "view.h"
+#include "render.h"
+
+/**
+ * @brief Add an image part on the watch bg.
+ */
+static render_object_h _image_add(const char *image_path, int x, int y, int w, int h)
+{
+	return (render_object_h)view_create_parts(view_get_bg(), image_path, x, y, w, h);
+}
+
+/**
+ * @brief Map the object, see view_rotate_hand_cropped().
+ */
+static void _set_transform(render_object_h obj, double degree, int cx, int cy, int visible_h)
+{
+	view_rotate_hand_cropped((Evas_Object *)obj, degree, cx, cy, visible_h);
+}
+
+/**
+ * @brief Make the map ahead of time, see view_prepare_hand_map().
+ */
+static void _prepare_transform(render_object_h obj, double degree, int cx, int cy, int visible_h)
+{
+	view_prepare_hand_map((Evas_Object *)obj, degree, cx, cy, visible_h);
+}
+
+/**
+ * @brief Set the object colour.
+ */
+static void _set_color(render_object_h obj, int r, int g, int b, int a)
+{
+	evas_object_color_set((Evas_Object *)obj, r, g, b, a);
+}
+
+/**
+ * @brief Show or hide the object.
+ */
+static void _set_visible(render_object_h obj, bool visible)
+{
+	if (visible)
+		evas_object_show((Evas_Object *)obj);
+	else
+		evas_object_hide((Evas_Object *)obj);
+}
+
+/**
+ * @brief Set the text of a layout part.
+ */
+static void _set_text(render_object_h obj, const char *part_name, const char *text)
+{
+	view_set_text((Evas_Object *)obj, part_name, text);
+}
+
+/**
+ * @brief Delete the object.
+ */
+static void _del(render_object_h obj)
+{
+	evas_object_del((Evas_Object *)obj);
+}
+
+/**
+ * @brief Hold back event processing on the watch canvas while a batch is issued.
+ */
+static void _set_frozen(bool frozen)
+{
+	Evas_Object *bg = view_get_bg();
+
+	if (bg == NULL)
+		return;
+
+	if (frozen)
+		evas_event_freeze(evas_object_evas_get(bg));
+	else
+		evas_event_thaw(evas_object_evas_get(bg));
+}
+
+const render_backend_s render_backend_efl = {
+	.name = "efl",
+	.image_add = _image_add,
+	.set_transform = _set_transform,
+	.set_color = _set_color,
+	.set_visible = _set_visible,
+	.set_text = _set_text,
+	.del = _del,
+	.set_frozen = _set_frozen,
+	.prepare_transform = _prepare_transform,
+};
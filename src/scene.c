@@ -0,0 +1,279 @@
+#include <dlog.h>
+#include <string.h>
+
+#include "look.h"
+#include "scene.h"
+
+typedef struct _scene_state {
+	bool transformed;
+	double degree;
+	int cx;
+	int cy;
+	int visible_h;
+	int visible; /* -1 while not known */
+} scene_state_s;
+
+typedef struct _scene_node {
+	render_object_h obj;
+	bool dirty;
+	scene_state_s want;
+	scene_state_s applied;
+} scene_node_s;
+
+static struct scene_info {
+	scene_node_s nodes[SCENE_NODE_MAX];
+	int node_cnt;
+	bool dirty;
+	unsigned int commits;
+	unsigned int writes;
+	unsigned int calls;
+} s_info = {
+	.node_cnt = 0,
+	.dirty = false,
+	.commits = 0,
+	.writes = 0,
+	.calls = 0,
+};
+
+static const scene_state_s s_unknown = {
+	.transformed = false,
+	.visible = -1,
+};
+
+/**
+ * @brief Get the node of an object, adding it the first time.
+ * @return The node, or NULL if the scene is full
+ */
+static scene_node_s *_get_node(render_object_h obj)
+{
+	scene_node_s *node = NULL;
+	int i = 0;
+
+	for (i = 0; i < s_info.node_cnt; i++)
+	{
+		if (s_info.nodes[i].obj == obj)
+			return &s_info.nodes[i];
+	}
+
+	if (s_info.node_cnt == SCENE_NODE_MAX)
+	{
+		dlog_print(DLOG_ERROR, LOG_TAG, "Scene is full");
+		return NULL;
+	}
+
+	node = &s_info.nodes[s_info.node_cnt++];
+	node->obj = obj;
+	node->dirty = false;
+	node->want = s_unknown;
+	node->applied = s_unknown;
+
+	return node;
+}
+
+static bool _same_transform(const scene_state_s *a, const scene_state_s *b)
+{
+	return a->transformed == b->transformed && a->degree == b->degree &&
+			a->cx == b->cx && a->cy == b->cy && a->visible_h == b->visible_h;
+}
+
+/**
+ * @brief Log the writes and the render calls they took, per commit.
+ */
+static void _report(void)
+{
+	dlog_print(DLOG_INFO, LOG_TAG, "scene: %.1f writes, %.1f calls per commit",
+			(double)s_info.writes / s_info.commits, (double)s_info.calls / s_info.commits);
+
+	s_info.commits = 0;
+	s_info.writes = 0;
+	s_info.calls = 0;
+}
+
+/**
+ * @brief Initialization function for scene module.
+ */
+void scene_initialize(void)
+{
+	memset(s_info.nodes, 0, sizeof(s_info.nodes));
+	s_info.node_cnt = 0;
+	s_info.dirty = false;
+	s_info.commits = 0;
+	s_info.writes = 0;
+	s_info.calls = 0;
+}
+
+/**
+ * @brief Finalization function for scene module. Writes not committed are dropped.
+ */
+void scene_finalize(void)
+{
+	scene_initialize();
+}
+
+/**
+ * @brief Set the transform an object should have, see render_set_transform().
+ * @param[in] obj The object
+ * @param[in] degree The degree to rotate, clockwise
+ * @param[in] cx The x coordinate of the center of rotation
+ * @param[in] cy The y coordinate of the center of rotation
+ * @param[in] visible_h The rows from the top to draw, 0 for all
+ */
+void scene_set_transform(render_object_h obj, double degree, int cx, int cy, int visible_h)
+{
+	scene_node_s *node = NULL;
+
+	if (obj == NULL)
+		return;
+
+	s_info.writes++;
+
+	node = _get_node(obj);
+	if (node == NULL)
+	{
+		render_set_transform(obj, degree, cx, cy, visible_h);
+		return;
+	}
+
+	node->want.transformed = true;
+	node->want.degree = degree;
+	node->want.cx = cx;
+	node->want.cy = cy;
+	node->want.visible_h = visible_h;
+	node->dirty = true;
+	s_info.dirty = true;
+}
+
+/**
+ * @brief Let the backend work out a transform the next commit will likely issue.
+ * Nothing is done for a transform already applied, or held back on a hidden object.
+ * @param[in] obj The object
+ * @param[in] degree The degree to rotate, clockwise
+ * @param[in] cx The x coordinate of the center of rotation
+ * @param[in] cy The y coordinate of the center of rotation
+ * @param[in] visible_h The rows from the top to draw, 0 for all
+ */
+void scene_prepare_transform(render_object_h obj, double degree, int cx, int cy, int visible_h)
+{
+	scene_node_s *node = NULL;
+	scene_state_s next = { 0, };
+
+	if (obj == NULL)
+		return;
+
+	node = _get_node(obj);
+	if (node)
+	{
+		next.transformed = true;
+		next.degree = degree;
+		next.cx = cx;
+		next.cy = cy;
+		next.visible_h = visible_h;
+
+		if (node->want.visible == 0 || _same_transform(&next, &node->applied))
+			return;
+	}
+
+	render_prepare_transform(obj, degree, cx, cy, visible_h);
+}
+
+/**
+ * @brief Set whether an object should be shown.
+ * @param[in] obj The object
+ * @param[in] visible True to show the object
+ */
+void scene_set_visible(render_object_h obj, bool visible)
+{
+	scene_node_s *node = NULL;
+
+	if (obj == NULL)
+		return;
+
+	s_info.writes++;
+
+	node = _get_node(obj);
+	if (node == NULL)
+	{
+		render_set_visible(obj, visible);
+		return;
+	}
+
+	node->want.visible = visible;
+	node->dirty = true;
+	s_info.dirty = true;
+}
+
+/**
+ * @brief Forget the state of an object, for when something else has changed it.
+ * Nothing is issued for it until it is written again.
+ * @param[in] obj The object
+ */
+void scene_invalidate(render_object_h obj)
+{
+	int i = 0;
+
+	for (i = 0; i < s_info.node_cnt; i++)
+	{
+		if (s_info.nodes[i].obj == obj)
+		{
+			s_info.nodes[i].dirty = false;
+			s_info.nodes[i].want = s_unknown;
+			s_info.nodes[i].applied = s_unknown;
+			return;
+		}
+	}
+}
+
+/**
+ * @brief Issue the render calls for the state written since the last commit.
+ * @return The number of render calls issued
+ */
+int scene_commit(void)
+{
+	scene_node_s *node = NULL;
+	bool shown = false;
+	int calls = 0;
+	int i = 0;
+
+	if (s_info.dirty)
+	{
+		render_set_frozen(true);
+
+		for (i = 0; i < s_info.node_cnt; i++)
+		{
+			node = &s_info.nodes[i];
+			if (!node->dirty)
+				continue;
+
+			node->dirty = false;
+
+			// A hidden object keeps its old transform until it is shown again
+			shown = node->want.visible != 0;
+			if (shown && node->want.transformed && !_same_transform(&node->want, &node->applied))
+			{
+				render_set_transform(node->obj, node->want.degree, node->want.cx, node->want.cy, node->want.visible_h);
+				node->applied.transformed = true;
+				node->applied.degree = node->want.degree;
+				node->applied.cx = node->want.cx;
+				node->applied.cy = node->want.cy;
+				node->applied.visible_h = node->want.visible_h;
+				calls++;
+			}
+
+			if (node->want.visible >= 0 && node->want.visible != node->applied.visible)
+			{
+				render_set_visible(node->obj, node->want.visible);
+				node->applied.visible = node->want.visible;
+				calls++;
+			}
+		}
+
+		render_set_frozen(false);
+		s_info.dirty = false;
+	}
+
+	s_info.calls += calls;
+	if (++s_info.commits == SCENE_REPORT_COMMITS)
+		_report();
+
+	return calls;
+}
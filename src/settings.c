@@ -0,0 +1,345 @@
+#include <app_common.h>
+#include <Elementary.h>
+#include <dlog.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "look.h"
+#include "data.h"
+#include "settings.h"
+
+#define SETTINGS_MAGIC 0x53455454 /* "SETT" */
+#define SETTINGS_VERSION 4
+
+static const settings_s s_defaults = {
+	.magic = SETTINGS_MAGIC,
+	.version = SETTINGS_VERSION,
+	.low_battery_level = LOW_BATTERY_LEVEL,
+	.second_mode = SETTINGS_SECOND_SWEEP,
+	.shadows = SETTINGS_SHADOW_AUTO,
+	.complications = 1,
+	/* Same as VIEW_SCHEME_AMBIENT */
+	.ambient_color = { 97, 244, 97 },
+	.hour_step = SETTINGS_HOUR_MINUTE,
+	.battery_readout = 0,
+};
+
+static struct settings_info {
+	const settings_s *mapped;
+	settings_changed_cb changed_cb;
+	void *user_data;
+} s_info = {
+	.mapped = NULL,
+	.changed_cb = NULL,
+	.user_data = NULL,
+};
+
+/**
+ * @brief Get the path of a file in the app data directory.
+ * @param[in] file_in File name
+ * @param[out] file_path_out The point to which save full path of the file
+ * @param[in] file_path_max Size of file name include path
+ */
+static void _get_data_path(const char *file_in, char *file_path_out, int file_path_max)
+{
+	char *data_path = app_get_data_path();
+
+	/* Leave the path empty rather than fall back to the working directory */
+	if (data_path && data_path[0])
+		snprintf(file_path_out, file_path_max, "%s%s", data_path, file_in);
+	free(data_path);
+}
+
+/**
+ * @brief Check the values of mapped settings, which were not parsed on the way in.
+ * @param[in] settings The settings to check
+ */
+static bool _valid(const settings_s *settings)
+{
+	if (settings->low_battery_level < 0 || settings->low_battery_level > 100)
+		return false;
+	if (settings->second_mode != SETTINGS_SECOND_SWEEP && settings->second_mode != SETTINGS_SECOND_OFF)
+		return false;
+	if (settings->shadows > SETTINGS_SHADOW_SOFT)
+		return false;
+	if (settings->hour_step > SETTINGS_HOUR_CONTINUOUS)
+		return false;
+
+	return settings->complications <= 1 && settings->battery_readout <= 1;
+}
+
+/**
+ * @brief Map the settings file read-only. A missing, stale or corrupt file leaves the defaults.
+ */
+static void _map(void)
+{
+	char path[PATH_MAX] = { 0, };
+	struct stat st = { 0, };
+	const settings_s *mapped = NULL;
+	int fd = -1;
+
+	_get_data_path(SETTINGS_FILE, path, sizeof(path));
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return;
+
+	if (fstat(fd, &st) == 0 && st.st_size == sizeof(settings_s)) {
+		mapped = mmap(NULL, sizeof(settings_s), PROT_READ, MAP_PRIVATE, fd, 0);
+		if (mapped == MAP_FAILED)
+			mapped = NULL;
+	}
+	close(fd);
+
+	if (mapped == NULL) {
+		dlog_print(DLOG_ERROR, LOG_TAG, "Failed to map %s", path);
+		return;
+	}
+
+	if (mapped->magic != SETTINGS_MAGIC || mapped->version != SETTINGS_VERSION) {
+		munmap((void *)mapped, sizeof(settings_s));
+		return;
+	}
+
+	if (!_valid(mapped)) {
+		dlog_print(DLOG_ERROR, LOG_TAG, "Invalid settings in %s, using the defaults", path);
+		munmap((void *)mapped, sizeof(settings_s));
+		return;
+	}
+
+	s_info.mapped = mapped;
+}
+
+static void _unmap(void)
+{
+	if (s_info.mapped) {
+		munmap((void *)s_info.mapped, sizeof(settings_s));
+		s_info.mapped = NULL;
+	}
+}
+
+/**
+ * @brief Save the settings, replacing the old file only once complete.
+ * @param[in] settings The settings to save
+ */
+static bool _save(const settings_s *settings)
+{
+	char path[PATH_MAX] = { 0, };
+	char tmp_path[PATH_MAX] = { 0, };
+	FILE *file = NULL;
+	size_t written = 0;
+
+	_get_data_path(SETTINGS_FILE, path, sizeof(path));
+	if (path[0] == '\0') {
+		dlog_print(DLOG_ERROR, LOG_TAG, "No data path to save the settings to");
+		return false;
+	}
+	snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+
+	file = fopen(tmp_path, "wb");
+	if (file == NULL) {
+		dlog_print(DLOG_ERROR, LOG_TAG, "Failed to open %s", tmp_path);
+		return false;
+	}
+
+	/* The rename must not land before the data, or a power cut leaves an empty file */
+	written = fwrite(settings, sizeof(*settings), 1, file);
+	if (written == 1 && (fflush(file) != 0 || fsync(fileno(file)) != 0))
+		written = 0;
+
+	if (fclose(file) != 0 || written != 1) {
+		dlog_print(DLOG_ERROR, LOG_TAG, "Failed to write %s", tmp_path);
+		unlink(tmp_path);
+		return false;
+	}
+
+	return rename(tmp_path, path) == 0;
+}
+
+/**
+ * @brief Read an on/off value.
+ */
+static bool _parse_switch(const char *value, uint8_t *out)
+{
+	if (!strcmp(value, "on"))
+		*out = 1;
+	else if (!strcmp(value, "off"))
+		*out = 0;
+	else
+		return false;
+
+	return true;
+}
+
+/**
+ * @brief Read one extra data value into the settings.
+ * @return false if the value is not valid for the key
+ */
+static bool _parse(const char *key, const char *value, settings_s *settings)
+{
+	char *end = NULL;
+	long level = 0;
+	unsigned long rgb = 0;
+
+	if (!strcmp(key, SETTINGS_KEY_LOW_BATTERY_LEVEL)) {
+		level = strtol(value, &end, 10);
+		if (end == value || *end != '\0' || level < 0 || level > 100)
+			return false;
+		settings->low_battery_level = level;
+	} else if (!strcmp(key, SETTINGS_KEY_SECOND_MODE)) {
+		if (!strcmp(value, "sweep"))
+			settings->second_mode = SETTINGS_SECOND_SWEEP;
+		else if (!strcmp(value, "off"))
+			settings->second_mode = SETTINGS_SECOND_OFF;
+		else
+			return false;
+	} else if (!strcmp(key, SETTINGS_KEY_SHADOWS)) {
+		if (!strcmp(value, "auto"))
+			settings->shadows = SETTINGS_SHADOW_AUTO;
+		else if (!strcmp(value, "off"))
+			settings->shadows = SETTINGS_SHADOW_OFF;
+		else if (!strcmp(value, "hard"))
+			settings->shadows = SETTINGS_SHADOW_HARD;
+		else if (!strcmp(value, "soft"))
+			settings->shadows = SETTINGS_SHADOW_SOFT;
+		else
+			return false;
+	} else if (!strcmp(key, SETTINGS_KEY_COMPLICATIONS)) {
+		return _parse_switch(value, &settings->complications);
+	} else if (!strcmp(key, SETTINGS_KEY_BATTERY_READOUT)) {
+		return _parse_switch(value, &settings->battery_readout);
+	} else if (!strcmp(key, SETTINGS_KEY_AMBIENT_COLOR)) {
+		if (value[0] != '#' || strlen(value) != 7)
+			return false;
+		rgb = strtoul(value + 1, &end, 16);
+		if (*end != '\0')
+			return false;
+		settings->ambient_color[0] = rgb >> 16;
+		settings->ambient_color[1] = rgb >> 8;
+		settings->ambient_color[2] = rgb;
+	} else if (!strcmp(key, SETTINGS_KEY_HOUR_STEP)) {
+		if (!strcmp(value, "minute"))
+			settings->hour_step = SETTINGS_HOUR_MINUTE;
+		else if (!strcmp(value, "10s"))
+			settings->hour_step = SETTINGS_HOUR_10S;
+		else if (!strcmp(value, "continuous"))
+			settings->hour_step = SETTINGS_HOUR_CONTINUOUS;
+		else
+			return false;
+	}
+
+	return true;
+}
+
+/**
+ * @brief Get the settings_changed_e flags of the values that differ.
+ */
+static unsigned int _diff(const settings_s *a, const settings_s *b)
+{
+	unsigned int changed = 0;
+
+	if (a->low_battery_level != b->low_battery_level)
+		changed |= SETTINGS_CHANGED_LOW_BATTERY;
+	if (a->second_mode != b->second_mode)
+		changed |= SETTINGS_CHANGED_SECOND;
+	if (a->shadows != b->shadows)
+		changed |= SETTINGS_CHANGED_SHADOWS;
+	if (memcmp(a->ambient_color, b->ambient_color, sizeof(a->ambient_color)))
+		changed |= SETTINGS_CHANGED_AMBIENT_COLOR;
+	if (a->complications != b->complications)
+		changed |= SETTINGS_CHANGED_COMPLICATIONS;
+	if (a->hour_step != b->hour_step)
+		changed |= SETTINGS_CHANGED_HOUR_STEP;
+	if (a->battery_readout != b->battery_readout)
+		changed |= SETTINGS_CHANGED_BATTERY_READOUT;
+
+	return changed;
+}
+
+/**
+ * @brief Initialization function for settings module.
+ * @param[in] changed_cb Called when app_control changes a setting
+ * @param[in] user_data The user data passed to the callback
+ */
+void settings_initialize(settings_changed_cb changed_cb, void *user_data)
+{
+	s_info.changed_cb = changed_cb;
+	s_info.user_data = user_data;
+
+	_map();
+}
+
+/**
+ * @brief Finalization function for settings module.
+ */
+void settings_finalize(void)
+{
+	_unmap();
+
+	s_info.changed_cb = NULL;
+	s_info.user_data = NULL;
+}
+
+/**
+ * @brief Get the settings in effect, the saved ones or the defaults.
+ */
+const settings_s *settings_get(void)
+{
+	return s_info.mapped ? s_info.mapped : &s_defaults;
+}
+
+/**
+ * @brief Apply the settings carried as extra data by a launch request.
+ * Nothing is written unless a value changes.
+ * @param[in] app_control The launch request
+ * @return true if any setting changed
+ */
+bool settings_update(app_control_h app_control)
+{
+	static const char *keys[] = {
+		SETTINGS_KEY_LOW_BATTERY_LEVEL,
+		SETTINGS_KEY_SECOND_MODE,
+		SETTINGS_KEY_SHADOWS,
+		SETTINGS_KEY_AMBIENT_COLOR,
+		SETTINGS_KEY_COMPLICATIONS,
+		SETTINGS_KEY_HOUR_STEP,
+		SETTINGS_KEY_BATTERY_READOUT,
+	};
+	settings_s old = *settings_get();
+	settings_s settings = old;
+	unsigned int changed = 0;
+	char *value = NULL;
+	unsigned int i = 0;
+
+	for (i = 0; i < sizeof(keys) / sizeof(keys[0]); i++) {
+		if (app_control_get_extra_data(app_control, keys[i], &value) != APP_CONTROL_ERROR_NONE || value == NULL)
+			continue;
+
+		if (!_parse(keys[i], value, &settings))
+			dlog_print(DLOG_ERROR, LOG_TAG, "Invalid setting %s : %s", keys[i], value);
+
+		free(value);
+		value = NULL;
+	}
+
+	if (_diff(&old, &settings) == 0)
+		return false;
+
+	if (!_save(&settings))
+		return false;
+
+	// The old mapping still holds the old file, so it is swapped only now
+	_unmap();
+	_map();
+
+	if (s_info.mapped == NULL)
+		dlog_print(DLOG_ERROR, LOG_TAG, "Saved settings could not be mapped");
+
+	changed = _diff(&old, settings_get());
+	if (changed && s_info.changed_cb)
+		s_info.changed_cb(changed, s_info.user_data);
+
+	return changed != 0;
+}
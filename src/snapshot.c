@@ -0,0 +1,578 @@
+#include <app_common.h>
+#include <Elementary.h>
+#include <Eet.h>
+#include <dlog.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#include "look.h"
+#include "snapshot.h"
+
+#define SNAPSHOT_MAGIC 0x4c4f4f4b /* "LOOK" */
+#define SNAPSHOT_VERSION 2
+
+/*
+ * Written next to the frame. It only holds what is needed to decide
+ * whether the frame can stand in for the real scene.
+ */
+typedef struct _snapshot_state {
+	uint32_t magic;
+	uint32_t version;
+	int32_t width;
+	int32_t height;
+	int64_t saved_at;
+} snapshot_state_s;
+
+/*
+ * A frame copied off the canvas, written out on a worker thread
+ */
+typedef struct _snapshot_job {
+	snapshot_state_s state;
+	uint32_t *pixels;
+	char path[PATH_MAX];
+} snapshot_job_s;
+
+/*
+ * Where a member of a mapped object lands: the map of the nearest mapped
+ * object, and the clip that applies before that map
+ */
+typedef struct _snapshot_map {
+	Evas_Object *mapped;
+	const Evas_Map *map;
+	Evas_Coord x, y, w, h;
+} snapshot_map_s;
+
+typedef struct _snapshot_rect {
+	Evas_Coord x, y, w, h;
+} snapshot_rect_s;
+
+static struct snapshot_info {
+	Evas_Object *frame;
+	Evas_Object *win;
+	Ecore_Idler *idler;
+	Ecore_Thread *thread;
+} s_info = {
+	.frame = NULL,
+	.win = NULL,
+	.idler = NULL,
+	.thread = NULL,
+};
+
+static Eina_Bool _capture_idler_cb(void *data);
+static void _write_thread_cb(void *data, Ecore_Thread *thread);
+static void _write_end_cb(void *data, Ecore_Thread *thread);
+
+/**
+ * @brief Get the path of a file in the app data directory.
+ * @param[in] file_in File name
+ * @param[out] file_path_out The point to which save full path of the file
+ * @param[in] file_path_max Size of file name include path
+ */
+static void _get_data_path(const char *file_in, char *file_path_out, int file_path_max)
+{
+	char *data_path = app_get_data_path();
+	if (data_path) {
+		snprintf(file_path_out, file_path_max, "%s%s", data_path, file_in);
+		free(data_path);
+	}
+}
+
+/**
+ * @brief Load the state record.
+ * @param[in] path The snapshot file
+ * @param[out] state The state loaded
+ */
+static bool _load_state(const char *path, snapshot_state_s *state)
+{
+	Eet_File *file = NULL;
+	void *data = NULL;
+	int size = 0;
+
+	file = eet_open(path, EET_FILE_MODE_READ);
+	if (file == NULL)
+		return false;
+
+	data = eet_read(file, SNAPSHOT_STATE_KEY, &size);
+	eet_close(file);
+
+	if (data == NULL || size != sizeof(*state)) {
+		free(data);
+		return false;
+	}
+
+	memcpy(state, data, sizeof(*state));
+	free(data);
+
+	return state->magic == SNAPSHOT_MAGIC && state->version == SNAPSHOT_VERSION;
+}
+
+/**
+ * @brief Save the last frame and the state it was drawn in.
+ * The frame is taken once idle, and the file is written on a worker thread.
+ * @param[in] win The window showing the scene
+ * @return True if the frame will be taken
+ */
+bool snapshot_save(Evas_Object *win)
+{
+	if (win == NULL)
+		return false;
+
+	// One frame at a time, the one being taken is as recent
+	if (s_info.idler || s_info.thread)
+		return true;
+
+	s_info.idler = ecore_idler_add(_capture_idler_cb, NULL);
+	if (s_info.idler == NULL) {
+		dlog_print(DLOG_ERROR, LOG_TAG, "Failed to add snapshot idler");
+		return false;
+	}
+
+	s_info.win = win;
+
+	return true;
+}
+
+/**
+ * @brief Drop a frame not taken yet, when no more frames are drawn.
+ * A frame being written is left to finish, the old file stays until it is complete.
+ */
+void snapshot_cancel(void)
+{
+	if (s_info.idler) {
+		ecore_idler_del(s_info.idler);
+		s_info.idler = NULL;
+	}
+
+	s_info.win = NULL;
+}
+
+static bool _rect_intersect(snapshot_rect_s *rect, Evas_Coord x, Evas_Coord y, Evas_Coord w, Evas_Coord h)
+{
+	Evas_Coord x2 = (rect->x + rect->w < x + w) ? rect->x + rect->w : x + w;
+	Evas_Coord y2 = (rect->y + rect->h < y + h) ? rect->y + rect->h : y + h;
+
+	rect->x = (rect->x > x) ? rect->x : x;
+	rect->y = (rect->y > y) ? rect->y : y;
+	rect->w = (x2 > rect->x) ? x2 - rect->x : 0;
+	rect->h = (y2 > rect->y) ? y2 - rect->y : 0;
+
+	return rect->w > 0 && rect->h > 0;
+}
+
+/**
+ * @brief Tell whether an object is the mapped object or one of its members.
+ */
+static bool _is_inside(Evas_Object *obj, Evas_Object *mapped)
+{
+	for (; obj; obj = evas_object_smart_parent_get(obj)) {
+		if (obj == mapped)
+			return true;
+	}
+
+	return false;
+}
+
+/**
+ * @brief Work out where the clippers of an object let it show, and their colour.
+ * Clippers inside the mapped object clip before the map, the others on screen.
+ * @param[in] obj The object
+ * @param[in] map The map the object is drawn through, or NULL
+ * @param[in,out] pre The area left before the map
+ * @param[out] post The area left on screen
+ * @param[out] color The colour of the clippers, multiplied
+ * @return False if nothing of the object shows
+ */
+static bool _get_clip(Evas_Object *obj, const snapshot_map_s *map, snapshot_rect_s *pre, snapshot_rect_s *post, int color[4])
+{
+	Evas_Object *clip = NULL;
+	Evas_Coord x = 0, y = 0, w = 0, h = 0;
+	int r = 0, g = 0, b = 0, a = 0;
+
+	post->x = post->y = 0;
+	post->w = post->h = 0x7fff;
+	color[0] = color[1] = color[2] = color[3] = 255;
+
+	for (clip = evas_object_clip_get(obj); clip; clip = evas_object_clip_get(clip)) {
+		if (!evas_object_visible_get(clip))
+			return false;
+
+		evas_object_color_get(clip, &r, &g, &b, &a);
+		color[0] = (color[0] * r) / 255;
+		color[1] = (color[1] * g) / 255;
+		color[2] = (color[2] * b) / 255;
+		color[3] = (color[3] * a) / 255;
+
+		evas_object_geometry_get(clip, &x, &y, &w, &h);
+		if (!_rect_intersect((map->map && _is_inside(clip, map->mapped)) ? pre : post, x, y, w, h))
+			return false;
+	}
+
+	return color[3] > 0;
+}
+
+/**
+ * @brief Set the map that puts an area of an object where the mapped object draws it.
+ * The map points run around its UV rectangle, as evas_map_util_points_populate_from_object() sets them.
+ * @param[in] copy The copy of the object
+ * @param[in] map The map the object is drawn through
+ * @param[in] area The area of the object that shows, before the map
+ * @param[in] x The object position
+ * @param[in] y The object position
+ * @return False if none of the area is in the map
+ */
+static bool _set_map(Evas_Object *copy, const snapshot_map_s *map, snapshot_rect_s *area, Evas_Coord x, Evas_Coord y)
+{
+	Evas_Map *m = NULL;
+	Evas_Coord px[4] = { 0, }, py[4] = { 0, };
+	double u0 = 0.0, v0 = 0.0, u1 = 0.0, v1 = 0.0;
+	double qx = 0.0, qy = 0.0, s = 0.0, t = 0.0;
+	int i = 0;
+
+	for (i = 0; i < 4; i++)
+		evas_map_point_coord_get(map->map, i, &px[i], &py[i], NULL);
+	evas_map_point_image_uv_get(map->map, 0, &u0, &v0);
+	evas_map_point_image_uv_get(map->map, 2, &u1, &v1);
+
+	if (u1 <= u0 || v1 <= v0)
+		return false;
+
+	// A cropped map only draws its UV rectangle of the mapped object
+	if (!_rect_intersect(area, map->x + u0, map->y + v0, u1 - u0, v1 - v0))
+		return false;
+
+	m = evas_map_new(4);
+	if (m == NULL)
+		return false;
+
+	for (i = 0; i < 4; i++) {
+		qx = area->x + ((i == 1 || i == 2) ? area->w : 0);
+		qy = area->y + ((i >= 2) ? area->h : 0);
+		s = ((qx - map->x) - u0) / (u1 - u0);
+		t = ((qy - map->y) - v0) / (v1 - v0);
+
+		evas_map_point_coord_set(m, i,
+				((1 - s) * (1 - t) * px[0]) + (s * (1 - t) * px[1]) + (s * t * px[2]) + ((1 - s) * t * px[3]),
+				((1 - s) * (1 - t) * py[0]) + (s * (1 - t) * py[1]) + (s * t * py[2]) + ((1 - s) * t * py[3]), 0);
+		evas_map_point_image_uv_set(m, i, qx - x, qy - y);
+	}
+
+	evas_map_smooth_set(m, EINA_TRUE);
+	evas_object_map_set(copy, m);
+	evas_object_map_enable_set(copy, EINA_TRUE);
+	evas_map_free(m);
+
+	return true;
+}
+
+/**
+ * @brief Make the copy of one image, text or rectangle object.
+ */
+static Evas_Object *_copy_object(Evas *e, Evas_Object *obj, const char *type)
+{
+	Evas_Object *copy = NULL;
+	const char *file = NULL, *key = NULL;
+	const char *font = NULL;
+	Evas_Font_Size size = 0;
+	Evas_Coord fx = 0, fy = 0, fw = 0, fh = 0;
+	int l = 0, r = 0, t = 0, b = 0;
+
+	if (!strcmp(type, "image")) {
+		// Pixels set by the app, such as the last frame itself, are not kept
+		evas_object_image_file_get(obj, &file, &key);
+		if (file == NULL)
+			return NULL;
+
+		copy = evas_object_image_add(e);
+		if (copy == NULL)
+			return NULL;
+
+		evas_object_image_file_set(copy, file, key);
+		evas_object_image_fill_get(obj, &fx, &fy, &fw, &fh);
+		evas_object_image_fill_set(copy, fx, fy, fw, fh);
+		evas_object_image_border_get(obj, &l, &r, &t, &b);
+		evas_object_image_border_set(copy, l, r, t, b);
+		evas_object_image_border_center_fill_set(copy, evas_object_image_border_center_fill_get(obj));
+		evas_object_image_smooth_scale_set(copy, evas_object_image_smooth_scale_get(obj));
+	} else if (!strcmp(type, "text")) {
+		copy = evas_object_text_add(e);
+		if (copy == NULL)
+			return NULL;
+
+		evas_object_text_font_source_set(copy, evas_object_text_font_source_get(obj));
+		evas_object_text_font_get(obj, &font, &size);
+		evas_object_text_font_set(copy, font, size);
+		evas_object_text_style_set(copy, evas_object_text_style_get(obj));
+		evas_object_text_text_set(copy, evas_object_text_text_get(obj));
+	} else if (!strcmp(type, "rectangle") && !evas_object_clipees_has(obj)) {
+		copy = evas_object_rectangle_add(e);
+	}
+
+	return copy;
+}
+
+/**
+ * @brief Copy an object that draws, or the members of a smart object, bottom to top.
+ * @param[in] e The canvas of the copy
+ * @param[in] obj The object
+ * @param[in] map The map of the nearest mapped smart parent, if any
+ */
+static void _copy_tree(Evas *e, Evas_Object *obj, const snapshot_map_s *map)
+{
+	snapshot_map_s own = *map;
+	snapshot_rect_s geometry = { 0, };
+	snapshot_rect_s area = { 0, };
+	snapshot_rect_s screen = { 0, };
+	Evas_Object *copy = NULL;
+	Evas_Object *clip = NULL;
+	Eina_List *members = NULL;
+	Evas_Object *member = NULL;
+	const char *type = evas_object_type_get(obj);
+	int clip_color[4] = { 0, };
+	int r = 0, g = 0, b = 0, a = 0;
+
+	if (type == NULL || !evas_object_visible_get(obj))
+		return;
+
+	if (evas_object_map_enable_get(obj) && evas_object_map_get(obj)) {
+		own.mapped = obj;
+		own.map = evas_object_map_get(obj);
+		evas_object_geometry_get(obj, &own.x, &own.y, &own.w, &own.h);
+	}
+
+	if (evas_object_smart_smart_get(obj)) {
+		members = evas_object_smart_members_get(obj);
+		EINA_LIST_FREE(members, member)
+			_copy_tree(e, member, &own);
+		return;
+	}
+
+	evas_object_geometry_get(obj, &geometry.x, &geometry.y, &geometry.w, &geometry.h);
+	if (geometry.w <= 0 || geometry.h <= 0)
+		return;
+
+	area = geometry;
+
+	if (!_get_clip(obj, &own, &area, &screen, clip_color))
+		return;
+
+	copy = _copy_object(e, obj, type);
+	if (copy == NULL)
+		return;
+
+	evas_object_move(copy, geometry.x, geometry.y);
+	evas_object_resize(copy, geometry.w, geometry.h);
+
+	evas_object_color_get(obj, &r, &g, &b, &a);
+	evas_object_color_set(copy, (r * clip_color[0]) / 255, (g * clip_color[1]) / 255, (b * clip_color[2]) / 255,
+			(a * clip_color[3]) / 255);
+
+	if (own.map && !_set_map(copy, &own, &area, geometry.x, geometry.y)) {
+		evas_object_del(copy);
+		return;
+	}
+
+	// Clippers in screen space come down to one rectangle
+	if (screen.w < 0x7fff || screen.h < 0x7fff) {
+		clip = evas_object_rectangle_add(e);
+		if (clip) {
+			evas_object_move(clip, screen.x, screen.y);
+			evas_object_resize(clip, screen.w, screen.h);
+			evas_object_clip_set(copy, clip);
+			evas_object_show(clip);
+		}
+	}
+
+	evas_object_show(copy);
+}
+
+/**
+ * @brief Take the frame off the screen and write it on a worker thread.
+ * The image and text objects of the window are drawn again on a buffer
+ * canvas, as Evas draws them, and its pixels are read back. Nothing here
+ * stays once the frame is copied.
+ * @param[in] data The user data
+ */
+static Eina_Bool _capture_idler_cb(void *data)
+{
+	snapshot_map_s no_map = { 0, };
+	snapshot_job_s *job = NULL;
+	Ecore_Evas *buffer = NULL;
+	Evas_Object *obj = NULL;
+	Evas_Object *black = NULL;
+	const void *pixels = NULL;
+	Evas *e = NULL;
+	int w = 0, h = 0;
+
+	s_info.idler = NULL;
+	if (s_info.win == NULL)
+		return ECORE_CALLBACK_CANCEL;
+
+	evas_object_geometry_get(s_info.win, NULL, NULL, &w, &h);
+	e = evas_object_evas_get(s_info.win);
+	s_info.win = NULL;
+
+	if (w <= 0 || h <= 0)
+		return ECORE_CALLBACK_CANCEL;
+
+	buffer = ecore_evas_buffer_new(w, h);
+	if (buffer == NULL) {
+		dlog_print(DLOG_ERROR, LOG_TAG, "Failed to add snapshot canvas");
+		return ECORE_CALLBACK_CANCEL;
+	}
+
+	black = evas_object_rectangle_add(ecore_evas_get(buffer));
+	if (black) {
+		evas_object_color_set(black, 0, 0, 0, 255);
+		evas_object_resize(black, w, h);
+		evas_object_show(black);
+	}
+
+	// Smart members are reached through their parent
+	for (obj = evas_object_bottom_get(e); obj; obj = evas_object_above_get(obj)) {
+		if (evas_object_smart_parent_get(obj) == NULL)
+			_copy_tree(ecore_evas_get(buffer), obj, &no_map);
+	}
+
+	pixels = ecore_evas_buffer_pixels_get(buffer);
+
+	job = calloc(1, sizeof(snapshot_job_s));
+	if (job && pixels)
+		job->pixels = malloc(w * h * sizeof(uint32_t));
+
+	if (job == NULL || job->pixels == NULL) {
+		dlog_print(DLOG_ERROR, LOG_TAG, "Failed to read snapshot frame");
+		free(job);
+		ecore_evas_free(buffer);
+		return ECORE_CALLBACK_CANCEL;
+	}
+
+	memcpy(job->pixels, pixels, w * h * sizeof(uint32_t));
+	ecore_evas_free(buffer);
+
+	job->state.magic = SNAPSHOT_MAGIC;
+	job->state.version = SNAPSHOT_VERSION;
+	job->state.width = w;
+	job->state.height = h;
+	job->state.saved_at = time(NULL);
+	_get_data_path(SNAPSHOT_FILE, job->path, sizeof(job->path));
+
+	// On failure the end callback, run as the cancel one, has freed the job already
+	s_info.thread = ecore_thread_run(_write_thread_cb, _write_end_cb, _write_end_cb, job);
+	if (s_info.thread == NULL)
+		dlog_print(DLOG_ERROR, LOG_TAG, "Failed to run snapshot writer");
+
+	return ECORE_CALLBACK_CANCEL;
+}
+
+/**
+ * @brief Write the frame and its state, replacing the old file only once complete. Runs on a worker thread.
+ * @param[in] data The job
+ * @param[in] thread The thread
+ */
+static void _write_thread_cb(void *data, Ecore_Thread *thread)
+{
+	snapshot_job_s *job = data;
+	char tmp_path[PATH_MAX + 4] = { 0, };
+	Eet_File *file = NULL;
+	bool written = false;
+	int fd = -1;
+
+	if (job->path[0] == '\0')
+		return;
+
+	snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", job->path);
+
+	file = eet_open(tmp_path, EET_FILE_MODE_WRITE);
+	if (file == NULL) {
+		dlog_print(DLOG_ERROR, LOG_TAG, "Failed to open %s", tmp_path);
+		return;
+	}
+
+	// Opaque, fast lossless compression
+	written = eet_data_image_write(file, SNAPSHOT_FRAME_KEY, job->pixels, job->state.width, job->state.height, 0, 1, 0, 0) > 0
+			&& eet_write(file, SNAPSHOT_STATE_KEY, &job->state, sizeof(job->state), 0) > 0;
+	written = eet_close(file) == EET_ERROR_NONE && written;
+
+	// On disk before the rename, so a reboot leaves the old file or the whole new one
+	fd = open(tmp_path, O_RDONLY);
+	written = fd >= 0 && fsync(fd) == 0 && written;
+	if (fd >= 0)
+		close(fd);
+
+	if (!written || rename(tmp_path, job->path) != 0) {
+		dlog_print(DLOG_ERROR, LOG_TAG, "Failed to save snapshot frame");
+		unlink(tmp_path);
+	}
+}
+
+/**
+ * @brief Free a job on the main loop, once written or cancelled.
+ * @param[in] data The job
+ * @param[in] thread The thread
+ */
+static void _write_end_cb(void *data, Ecore_Thread *thread)
+{
+	snapshot_job_s *job = data;
+
+	s_info.thread = NULL;
+
+	free(job->pixels);
+	free(job);
+}
+
+/**
+ * @brief Show the last frame over the window, if it still fits.
+ * @param[in] win The window to show the frame in
+ * @param[in] width The width of the window
+ * @param[in] height The height of the window
+ * @return True if the frame is shown
+ */
+bool snapshot_show(Evas_Object *win, int width, int height)
+{
+	snapshot_state_s state = { 0, };
+	char path[PATH_MAX] = { 0, };
+	time_t now = time(NULL);
+
+	_get_data_path(SNAPSHOT_FILE, path, sizeof(path));
+
+	if (!_load_state(path, &state))
+		return false;
+
+	if (state.width != width || state.height != height)
+		return false;
+
+	if (state.saved_at > now || now - state.saved_at > SNAPSHOT_MAX_AGE)
+		return false;
+
+	s_info.frame = evas_object_image_filled_add(evas_object_evas_get(win));
+	if (s_info.frame == NULL) {
+		dlog_print(DLOG_ERROR, LOG_TAG, "Failed to add snapshot frame");
+		return false;
+	}
+
+	evas_object_image_file_set(s_info.frame, path, SNAPSHOT_FRAME_KEY);
+	if (evas_object_image_load_error_get(s_info.frame) != EVAS_LOAD_ERROR_NONE) {
+		dlog_print(DLOG_ERROR, LOG_TAG, "Failed to load snapshot frame");
+		snapshot_hide();
+		return false;
+	}
+
+	evas_object_move(s_info.frame, 0, 0);
+	evas_object_resize(s_info.frame, width, height);
+	evas_object_layer_set(s_info.frame, EVAS_LAYER_MAX);
+	evas_object_show(s_info.frame);
+
+	return true;
+}
+
+/**
+ * @brief Remove the last frame, once the real scene is in place.
+ */
+void snapshot_hide(void)
+{
+	if (s_info.frame) {
+		evas_object_del(s_info.frame);
+		s_info.frame = NULL;
+	}
+}
@@ -0,0 +1,216 @@
+#include <Elementary.h>
+#include <dlog.h>
+
+#include "look.h"
+#include "spring.h"
+#include "wakeup.h"
+
+/*
+ * A damped spring around a rest angle of zero, with unit mass
+ */
+struct _spring {
+	bool used;
+	bool awake;
+	double angle;
+	double velocity;
+	double stiffness;
+	double damping;
+	double radius;
+	spring_apply_cb apply_cb;
+	void *data;
+};
+
+static struct spring_info {
+	struct _spring springs[SPRING_MAX];
+	wakeup_frame_h frame;
+	double last_time;
+	double pending;
+} s_info = {
+	.frame = NULL,
+	.last_time = 0.0f,
+	.pending = 0.0f,
+};
+
+static Eina_Bool _frame_cb(void *data);
+
+/**
+ * @brief Initialization function for spring module.
+ */
+void spring_initialize(void)
+{
+	memset(s_info.springs, 0, sizeof(s_info.springs));
+}
+
+/**
+ * @brief Finalization function for spring module.
+ */
+void spring_finalize(void)
+{
+	if (s_info.frame)
+	{
+		wakeup_frame_del(s_info.frame);
+		s_info.frame = NULL;
+	}
+
+	memset(s_info.springs, 0, sizeof(s_info.springs));
+}
+
+/**
+ * @brief Add a spring.
+ * @param[in] stiffness The spring constant, in 1/s^2
+ * @param[in] damping The damping constant, in 1/s
+ * @param[in] radius The distance from the pivot to the edge of what moves, in pixels
+ * @param[in] apply_cb The function that draws the angle
+ * @param[in] data The user data
+ * @return The spring handle, or NULL on failure
+ */
+spring_h spring_add(double stiffness, double damping, double radius, spring_apply_cb apply_cb, void *data)
+{
+	struct _spring *spring = NULL;
+	int i = 0;
+
+	if (apply_cb == NULL)
+	{
+		dlog_print(DLOG_ERROR, LOG_TAG, "apply_cb is NULL");
+		return NULL;
+	}
+
+	for (i = 0; i < SPRING_MAX; i++)
+	{
+		if (!s_info.springs[i].used)
+		{
+			spring = &s_info.springs[i];
+			break;
+		}
+	}
+
+	if (spring == NULL)
+	{
+		dlog_print(DLOG_ERROR, LOG_TAG, "Too many springs");
+		return NULL;
+	}
+
+	memset(spring, 0, sizeof(*spring));
+	spring->used = true;
+	spring->stiffness = stiffness;
+	spring->damping = damping;
+	spring->radius = radius;
+	spring->apply_cb = apply_cb;
+	spring->data = data;
+
+	return spring;
+}
+
+/**
+ * @brief Remove a spring.
+ * @param[in] spring The spring handle
+ */
+void spring_del(spring_h spring)
+{
+	if (spring == NULL)
+		return;
+
+	spring->used = false;
+	spring->awake = false;
+}
+
+/**
+ * @brief Push a spring, waking the stepper if it sleeps.
+ * @param[in] spring The spring handle
+ * @param[in] velocity The velocity to add, in degrees per second
+ */
+void spring_kick(spring_h spring, double velocity)
+{
+	if (spring == NULL || !spring->used)
+		return;
+
+	spring->velocity += velocity;
+	spring->awake = true;
+
+	if (s_info.frame)
+		return;
+
+	s_info.last_time = ecore_loop_time_get();
+	s_info.pending = 0.0f;
+
+	s_info.frame = wakeup_frame_add(0.0f, _frame_cb, NULL);
+	if (s_info.frame == NULL)
+		dlog_print(DLOG_ERROR, LOG_TAG, "Failed to add spring frame");
+}
+
+/**
+ * @brief Check whether a spring moves less than the rest threshold.
+ * The amplitude comes from the energy, so a spring passing zero fast is not at rest.
+ * @param[in] spring The spring
+ */
+static bool _is_at_rest(const struct _spring *spring)
+{
+	double amplitude_sq = (spring->angle * spring->angle) + ((spring->velocity * spring->velocity) / spring->stiffness);
+	double rest = SPRING_REST_PIXELS / spring->radius * (180.0 / M_PI);
+
+	return amplitude_sq < rest * rest;
+}
+
+/**
+ * @brief Step the awake springs and draw them. At most SPRING_MAX_STEPS
+ * steps are taken per spring, time beyond that is dropped.
+ * @param[in] data The user data
+ */
+static Eina_Bool _frame_cb(void *data)
+{
+	struct _spring *spring = NULL;
+	double now = ecore_loop_time_get();
+	bool awake = false;
+	int steps = 0;
+	int i = 0;
+	int j = 0;
+
+	s_info.pending += now - s_info.last_time;
+	s_info.last_time = now;
+
+	steps = (int)(s_info.pending / SPRING_STEP);
+	if (steps > SPRING_MAX_STEPS)
+	{
+		steps = SPRING_MAX_STEPS;
+		s_info.pending = 0.0f;
+	}
+	else
+	{
+		s_info.pending -= steps * SPRING_STEP;
+	}
+
+	for (i = 0; i < SPRING_MAX; i++)
+	{
+		spring = &s_info.springs[i];
+		if (!spring->used || !spring->awake)
+			continue;
+
+		// Semi-implicit Euler, stable for these stiffnesses at this step
+		for (j = 0; j < steps; j++)
+		{
+			spring->velocity -= ((spring->stiffness * spring->angle) + (spring->damping * spring->velocity)) * SPRING_STEP;
+			spring->angle += spring->velocity * SPRING_STEP;
+		}
+
+		if (_is_at_rest(spring))
+		{
+			spring->angle = 0.0f;
+			spring->velocity = 0.0f;
+			spring->awake = false;
+		}
+		else
+		{
+			awake = true;
+		}
+
+		spring->apply_cb(spring->angle, spring->data);
+	}
+
+	if (!awake)
+	{
+		s_info.frame = NULL;
+		return ECORE_CALLBACK_CANCEL;
+	}
+
+	return ECORE_CALLBACK_RENEW;
+}
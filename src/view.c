@@ -6,18 +6,62 @@
 #include "look.h"
 #include "view.h"
 
+#define VIEW_PREPARED_MAX 8
+
+/*
+ * A hand map worked out ahead of the tick that sets it
+ */
+typedef struct _prepared_map {
+	Evas_Object *hand;
+	Evas_Map *map;
+	double degree;
+	Evas_Coord cx;
+	Evas_Coord cy;
+	Evas_Coord visible_h;
+	Evas_Coord x;
+	Evas_Coord y;
+	Evas_Coord w;
+	Evas_Coord h;
+} prepared_map_s;
+
 static struct view_info {
 	Evas_Object *bg;
 	Evas_Object *plate;
 	Evas_Object *module_day_layout;
 	Evas_Object *module_second_layout;
 	Evas_Object *module_minute_layout;
+	Evas_Object *moonphase_disc;
+	Evas_Object *moonphase_window;
+	Evas_Object *moonphase_clip;
+	prepared_map_s prepared[VIEW_PREPARED_MAX];
 } s_info = {
 	.bg = NULL,
 	.plate = NULL,
 	.module_day_layout = NULL,
 	.module_second_layout = NULL,
 	.module_minute_layout = NULL,
+	.moonphase_disc = NULL,
+	.moonphase_window = NULL,
+	.moonphase_clip = NULL,
+};
+
+typedef struct _scheme_color {
+	int r;
+	int g;
+	int b;
+} scheme_color_s;
+
+/*
+ * Tints multiplied into the white hand masks, indexed by view_scheme_e.
+ * The ambient tint can be changed in the settings
+ */
+static scheme_color_s s_scheme_colors[VIEW_SCHEME_MAX] = {
+	[VIEW_SCHEME_DEFAULT] = { 255, 255, 255 },
+	[VIEW_SCHEME_AMBIENT] = { 97, 244, 97 },
+	[VIEW_SCHEME_AMBIENT_LOWBAT] = { 255, 76, 76 },
+	[VIEW_SCHEME_LOWBAT] = { 255, 67, 67 },
+	[VIEW_SCHEME_GMT] = { 255, 170, 60 },
+	[VIEW_SCHEME_CHRONO] = { 250, 220, 90 },
 };
 
 /**
@@ -62,6 +106,64 @@ void view_set_module_minute_layout(Evas_Object *layout)
 	s_info.module_minute_layout = layout;
 }
 
+/**
+ * @brief Set the moon phase disc and the window it turns behind.
+ * @param[in] disc The moon phase disc
+ * @param[in] window The window covering the top half of the disc
+ */
+void view_set_moonphase(Evas_Object *disc, Evas_Object *window)
+{
+	Evas_Object *clip = NULL;
+	Evas_Coord x = 0, y = 0, w = 0, h = 0;
+
+	if (disc == NULL || window == NULL)
+	{
+		dlog_print(DLOG_ERROR, LOG_TAG, "moon phase part is NULL");
+		return;
+	}
+
+	/*
+	 * Only the half of the disc behind the window may show
+	 */
+	clip = evas_object_rectangle_add(evas_object_evas_get(disc));
+	if (clip == NULL)
+	{
+		dlog_print(DLOG_ERROR, LOG_TAG, "Failed to add moon phase clipper");
+		return;
+	}
+
+	evas_object_geometry_get(window, &x, &y, &w, &h);
+	evas_object_move(clip, x, y);
+	evas_object_resize(clip, w, h);
+	evas_object_clip_set(disc, clip);
+	evas_object_show(clip);
+
+	s_info.moonphase_disc = disc;
+	s_info.moonphase_window = window;
+	s_info.moonphase_clip = clip;
+}
+
+/**
+ * @brief Show or hide the moon phase module.
+ * @param[in] visible The visibility
+ */
+void view_set_moonphase_visible(bool visible)
+{
+	if (s_info.moonphase_clip == NULL)
+		return;
+
+	if (visible)
+	{
+		evas_object_show(s_info.moonphase_clip);
+		evas_object_show(s_info.moonphase_window);
+	}
+	else
+	{
+		evas_object_hide(s_info.moonphase_clip);
+		evas_object_hide(s_info.moonphase_window);
+	}
+}
+
 /**
  * @brief Get the bg object.
  */
@@ -129,7 +231,68 @@ void view_set_text(Evas_Object *parent, const char *part_name, const char *text)
  */
 void view_rotate_hand(Evas_Object *hand, double degree, Evas_Coord cx, Evas_Coord cy)
 {
+	view_rotate_hand_cropped(hand, degree, cx, cy, 0);
+}
+
+/**
+ * @brief Make the map of a hand rotated about a point, cropped to its top rows.
+ */
+static Evas_Map *_hand_map_new(Evas_Object *hand, double degree, Evas_Coord cx, Evas_Coord cy, Evas_Coord visible_h,
+		Evas_Coord x, Evas_Coord y, Evas_Coord w, Evas_Coord h)
+{
+	Evas_Map *m = evas_map_new(4);
+
+	evas_map_util_points_populate_from_object(m, hand);
+
+	if (visible_h > 0 && visible_h < h)
+	{
+		/* Points 2 and 3 are the bottom corners, pull them and their UVs up */
+		evas_map_point_coord_set(m, 2, x + w, y + visible_h, 0);
+		evas_map_point_coord_set(m, 3, x, y + visible_h, 0);
+		evas_map_point_image_uv_set(m, 2, w, visible_h);
+		evas_map_point_image_uv_set(m, 3, 0, visible_h);
+	}
+
+	evas_map_util_rotate(m, degree, cx, cy);
+
+	return m;
+}
+
+static prepared_map_s *_find_prepared(Evas_Object *hand)
+{
+	int i = 0;
+
+	for (i = 0; i < VIEW_PREPARED_MAX; i++)
+	{
+		if (s_info.prepared[i].hand == hand)
+			return &s_info.prepared[i];
+	}
+
+	return NULL;
+}
+
+static void _clear_prepared(prepared_map_s *prepared)
+{
+	if (prepared->map)
+		evas_map_free(prepared->map);
+
+	memset(prepared, 0, sizeof(*prepared));
+}
+
+/**
+ * @brief Rotate only the top rows of a hand, so its transparent part is never blended.
+ * A map prepared for the same rotation is used instead of making one.
+ * @param[in] hand The hand you want to rotate
+ * @param[in] degree The degree you want to rotate
+ * @param[in] cx The rotation's center horizontal position
+ * @param[in] cy The rotation's center vertical position
+ * @param[in] visible_h The number of rows from the top to draw, 0 for the whole hand
+ */
+void view_rotate_hand_cropped(Evas_Object *hand, double degree, Evas_Coord cx, Evas_Coord cy, Evas_Coord visible_h)
+{
+	prepared_map_s *prepared = NULL;
 	Evas_Map *m = NULL;
+	Evas_Coord x = 0, y = 0, w = 0, h = 0;
 
 	if (hand == NULL)
 	{
@@ -137,14 +300,239 @@ void view_rotate_hand(Evas_Object *hand, double degree, Evas_Coord cx, Evas_Coor
 		return;
 	}
 
-	m = evas_map_new(4);
-	evas_map_util_points_populate_from_object(m, hand);
-	evas_map_util_rotate(m, degree, cx, cy);
+	evas_object_geometry_get(hand, &x, &y, &w, &h);
+
+	prepared = _find_prepared(hand);
+	if (prepared && prepared->degree == degree && prepared->cx == cx && prepared->cy == cy &&
+			prepared->visible_h == visible_h && prepared->x == x && prepared->y == y &&
+			prepared->w == w && prepared->h == h)
+	{
+		m = prepared->map;
+		prepared->map = NULL;
+	}
+	else
+	{
+		m = _hand_map_new(hand, degree, cx, cy, visible_h, x, y, w, h);
+	}
+
+	// Used or not, a prepared map is only good for the next rotation
+	if (prepared)
+		_clear_prepared(prepared);
+
 	evas_object_map_set(hand, m);
 	evas_object_map_enable_set(hand, EINA_TRUE);
 	evas_map_free(m);
 }
 
+/**
+ * @brief Work out the map of a hand ahead of time, for view_rotate_hand_cropped().
+ * One map is kept per hand, for its next rotation.
+ * @param[in] hand The hand
+ * @param[in] degree The degree it will be rotated
+ * @param[in] cx The rotation's center horizontal position
+ * @param[in] cy The rotation's center vertical position
+ * @param[in] visible_h The number of rows from the top to draw, 0 for the whole hand
+ */
+void view_prepare_hand_map(Evas_Object *hand, double degree, Evas_Coord cx, Evas_Coord cy, Evas_Coord visible_h)
+{
+	prepared_map_s *prepared = NULL;
+
+	if (hand == NULL)
+		return;
+
+	prepared = _find_prepared(hand);
+	if (prepared == NULL)
+		prepared = _find_prepared(NULL);
+	if (prepared == NULL)
+		return;
+
+	_clear_prepared(prepared);
+
+	prepared->hand = hand;
+	prepared->degree = degree;
+	prepared->cx = cx;
+	prepared->cy = cy;
+	prepared->visible_h = visible_h;
+	evas_object_geometry_get(hand, &prepared->x, &prepared->y, &prepared->w, &prepared->h);
+	prepared->map = _hand_map_new(hand, degree, cx, cy, visible_h, prepared->x, prepared->y, prepared->w, prepared->h);
+}
+
+/**
+ * @brief Drop the maps prepared ahead of time.
+ */
+void view_clear_prepared_maps(void)
+{
+	int i = 0;
+
+	for (i = 0; i < VIEW_PREPARED_MAX; i++)
+		_clear_prepared(&s_info.prepared[i]);
+}
+
+/**
+ * @brief Tint an object with the colour of a scheme.
+ * @param[in] obj The object you want to tint
+ * @param[in] scheme The colour scheme
+ */
+void view_set_scheme_color(Evas_Object *obj, view_scheme_e scheme)
+{
+	const scheme_color_s *color = NULL;
+
+	if (obj == NULL)
+	{
+		dlog_print(DLOG_ERROR, LOG_TAG, "object is NULL");
+		return;
+	}
+
+	if (scheme < VIEW_SCHEME_DEFAULT || scheme >= VIEW_SCHEME_MAX)
+	{
+		dlog_print(DLOG_ERROR, LOG_TAG, "scheme error : %d", scheme);
+		return;
+	}
+
+	color = &s_scheme_colors[scheme];
+	evas_object_color_set(obj, color->r, color->g, color->b, 255);
+}
+
+/**
+ * @brief Change the colour of a scheme. Objects already tinted keep the old one.
+ * @param[in] scheme The colour scheme
+ * @param[in] r The red component
+ * @param[in] g The green component
+ * @param[in] b The blue component
+ */
+void view_set_scheme_rgb(view_scheme_e scheme, int r, int g, int b)
+{
+	if (scheme < VIEW_SCHEME_DEFAULT || scheme >= VIEW_SCHEME_MAX)
+	{
+		dlog_print(DLOG_ERROR, LOG_TAG, "scheme error : %d", scheme);
+		return;
+	}
+
+	s_scheme_colors[scheme].r = r;
+	s_scheme_colors[scheme].g = g;
+	s_scheme_colors[scheme].b = b;
+}
+
+/**
+ * @brief Send the hand state to a module layout as one Edje message.
+ * The colour of the scheme is set as the SCHEME_COLOR_CLASS colour class of the layout.
+ * @param[in] layout The module layout you want to update
+ * @param[in] angle The hand angle in degrees
+ * @param[in] mode The display mode
+ * @param[in] scheme The colour scheme
+ */
+void view_send_hand_state(Evas_Object *layout, int angle, view_mode_e mode, view_scheme_e scheme)
+{
+	Edje_Message_Int_Set *msg = NULL;
+	const scheme_color_s *color = NULL;
+
+	if (layout == NULL)
+	{
+		dlog_print(DLOG_ERROR, LOG_TAG, "layout is NULL");
+		return;
+	}
+
+	if (scheme < VIEW_SCHEME_DEFAULT || scheme >= VIEW_SCHEME_MAX)
+	{
+		dlog_print(DLOG_ERROR, LOG_TAG, "scheme error : %d", scheme);
+		return;
+	}
+
+	color = &s_scheme_colors[scheme];
+	edje_object_color_class_set(elm_layout_edje_get(layout), SCHEME_COLOR_CLASS,
+			color->r, color->g, color->b, 255, 0, 0, 0, 0, 0, 0, 0, 0);
+
+	msg = malloc(sizeof(Edje_Message_Int_Set) + ((MSG_HAND_STATE_COUNT - 1) * sizeof(int)));
+	if (msg == NULL)
+	{
+		dlog_print(DLOG_ERROR, LOG_TAG, "Failed to allocate message");
+		return;
+	}
+
+	msg->count = MSG_HAND_STATE_COUNT;
+	msg->val[0] = angle;
+	msg->val[1] = mode;
+	msg->val[2] = scheme;
+
+	/* Edje copies the message, so it can be freed straight away */
+	edje_object_message_send(elm_layout_edje_get(layout), EDJE_MESSAGE_INT_SET, MSG_ID_HAND_STATE, msg);
+	free(msg);
+}
+
+/**
+ * @brief Anchor the minute module, which sweeps the hand on to the next whole minute.
+ * @param[in] layout The module minute layout
+ * @param[in] angle The hand angle in tenths of a degree
+ * @param[in] mode The display mode, the hand only sweeps in normal mode
+ * @param[in] shadow True if the shadow is shown
+ */
+void view_send_minute_state(Evas_Object *layout, int angle, view_mode_e mode, bool shadow)
+{
+	Edje_Message_Int_Set *msg = NULL;
+
+	if (layout == NULL)
+	{
+		dlog_print(DLOG_ERROR, LOG_TAG, "layout is NULL");
+		return;
+	}
+
+	msg = malloc(sizeof(Edje_Message_Int_Set) + ((MSG_MINUTE_STATE_COUNT - 1) * sizeof(int)));
+	if (msg == NULL)
+	{
+		dlog_print(DLOG_ERROR, LOG_TAG, "Failed to allocate message");
+		return;
+	}
+
+	msg->count = MSG_MINUTE_STATE_COUNT;
+	msg->val[0] = angle;
+	msg->val[1] = mode;
+	msg->val[2] = shadow;
+
+	edje_object_message_send(elm_layout_edje_get(layout), EDJE_MESSAGE_INT_SET, MSG_ID_MINUTE_STATE, msg);
+	free(msg);
+}
+
+/**
+ * @brief Rotate the moon phase disc around its center.
+ * @param[in] degree The degree you want to rotate
+ */
+void view_rotate_moonphase(float degree)
+{
+	Evas_Coord x = 0, y = 0, w = 0, h = 0;
+
+	if (s_info.moonphase_disc == NULL)
+		return;
+
+	evas_object_geometry_get(s_info.moonphase_disc, &x, &y, &w, &h);
+	view_rotate_hand(s_info.moonphase_disc, degree, x + (w / 2), y + (h / 2));
+}
+
+/**
+ * @brief Rotate a whole module layout around its center with one map.
+ * @param[in] layout The module layout you want to rotate
+ * @param[in] degree The degree you want to rotate, 0 drops the map
+ */
+void view_rotate_module(Evas_Object *layout, double degree)
+{
+	Evas_Coord x = 0, y = 0, w = 0, h = 0;
+
+	if (layout == NULL)
+	{
+		dlog_print(DLOG_ERROR, LOG_TAG, "layout is NULL");
+		return;
+	}
+
+	// A mapped smart object is drawn through a surface, so only map while moving
+	if (degree == 0.0f)
+	{
+		evas_object_map_enable_set(layout, EINA_FALSE);
+		return;
+	}
+
+	evas_object_geometry_get(layout, &x, &y, &w, &h);
+	view_rotate_hand(layout, degree, x + (w / 2), y + (h / 2));
+}
+
 /**
  * @breif Create a bg object for the watch
  * @param[in] win The window object
@@ -199,6 +587,7 @@ Evas_Object *view_create_bg(Evas_Object *win, const char *image_path, int width,
 Evas_Object *view_create_bg_plate(Evas_Object *bg, const char *image_path, int width, int height)
 {
 	Evas_Object *plate = NULL;
+	Evas_Coord bg_w = 0, bg_h = 0;
 	Eina_Bool ret = EINA_FALSE;
 
 	if (bg == NULL)
@@ -214,17 +603,17 @@ Evas_Object *view_create_bg_plate(Evas_Object *bg, const char *image_path, int w
 		return NULL;
 	}
 
-	ret = elm_bg_file_set(plate, image_path, NULL);
+	/* The plate is an elm_image, elm_bg_file_set() fails on it */
+	ret = elm_image_file_set(plate, image_path, NULL);
 	if (ret != EINA_TRUE)
 	{
-		dlog_print(DLOG_ERROR, LOG_TAG, "Failed to set the background image");
+		dlog_print(DLOG_ERROR, LOG_TAG, "Failed to set the plate image");
 		evas_object_del(plate);
 		return NULL;
 	}
 
-	elm_bg_option_set(plate, ELM_BG_OPTION_CENTER);
-
-	evas_object_move(plate, (BASE_WIDTH / 2) - (width / 2), (BASE_HEIGHT / 2) - (width / 2));
+	evas_object_geometry_get(bg, NULL, NULL, &bg_w, &bg_h);
+	evas_object_move(plate, (bg_w / 2) - (width / 2), (bg_h / 2) - (height / 2));
 	evas_object_resize(plate, width, height);
 	evas_object_show(plate);
 
@@ -286,6 +675,23 @@ void view_set_module_property(Evas_Object *layout, int x, int y, int w, int h)
 	evas_object_resize(layout, w, h);
 }
 
+/**
+ * @brief Set the Edje scale for module layout.
+ * @param[in] layout The object to which you want to set
+ * @param[in] scale The scale from the design size to the display size
+ */
+void view_set_module_scale(Evas_Object *layout, double scale)
+{
+	if (layout == NULL)
+	{
+		dlog_print(DLOG_ERROR, LOG_TAG, "layout is NULL");
+		return;
+	}
+
+	/* Only parts with "scale: 1" in main.edc follow this */
+	edje_object_scale_set(elm_layout_edje_get(layout), scale);
+}
+
 /**
  * @brief Create a layout for the watch.
  * @param[in] parent The object to which you want to add this layout
@@ -326,6 +732,21 @@ Evas_Object *view_create_module_layout(Evas_Object *parent, const char *file_pat
 	return layout;
 }
 
+/**
+ * @brief Tint a hand black and translucent, so it can stand in for its shadow.
+ * @param[in] parts The hand sprite used as a shadow
+ */
+void view_set_shadow_tint(Evas_Object *parts)
+{
+	if (parts == NULL)
+	{
+		dlog_print(DLOG_ERROR, LOG_TAG, "Failed to set shadow tint");
+		return;
+	}
+
+	evas_object_color_set(parts, 0, 0, 0, 255 * 0.5);
+}
+
 /**
  * @brief Set opacity to parts of watch.
  * @param[in] parts The parts of watch
@@ -388,6 +809,8 @@ Evas_Object *view_create_parts(Evas_Object *parent, const char *image_path, int
  */
 void view_destroy_base_gui(void)
 {
+	view_clear_prepared_maps();
+
 	if (s_info.module_day_layout)
 	{
 		evas_object_del(s_info.module_day_layout);
@@ -400,6 +823,14 @@ void view_destroy_base_gui(void)
 		s_info.module_second_layout = NULL;
 	}
 
+	if (s_info.moonphase_clip)
+	{
+		evas_object_del(s_info.moonphase_clip);
+		s_info.moonphase_clip = NULL;
+		s_info.moonphase_disc = NULL;
+		s_info.moonphase_window = NULL;
+	}
+
 	if (s_info.plate)
 	{
 		evas_object_del(s_info.plate);
@@ -416,6 +847,8 @@ void view_destroy_base_gui(void)
 		evas_object_data_del(s_info.bg, "__HANDS_HOUR_SHADOW__");
 		evas_object_data_del(s_info.bg, "__HANDS_BAT__");
 		evas_object_data_del(s_info.bg, "__HANDS_BAT_SHADOW__");
+		evas_object_data_del(s_info.bg, "__HANDS_GMT__");
+		evas_object_data_del(s_info.bg, "__HANDS_CHRONO__");
 		evas_object_del(s_info.bg);
 		s_info.bg = NULL;
 	}
@@ -0,0 +1,382 @@
+#include <Elementary.h>
+#include <dlog.h>
+
+#include "look.h"
+#include "wakeup.h"
+
+enum {
+	WAKEUP_MODE_NORMAL = 0,
+	WAKEUP_MODE_AMBIENT = 1,
+	WAKEUP_MODE_MAX,
+};
+
+/*
+ * A frame client. While something else keeps the animator running, or a
+ * client needs every frame, clients share the animator, so their frames
+ * land on the same vsync wakeups as each other and as the Edje
+ * animations. Otherwise they run on a timer, which wakes the loop only
+ * as often as the clients need.
+ */
+struct _wakeup_frame {
+	bool used;
+	double interval;
+	double next_due;
+	Ecore_Task_Cb frame_cb;
+	const void *data;
+};
+
+static const char *s_source_names[WAKEUP_SOURCE_MAX] = {
+	[WAKEUP_SOURCE_TIME_TICK] = "time_tick",
+	[WAKEUP_SOURCE_AMBIENT_TICK] = "ambient_tick",
+	[WAKEUP_SOURCE_FRAME] = "frame",
+	[WAKEUP_SOURCE_COMPLICATION] = "complication",
+	[WAKEUP_SOURCE_INPUT] = "input",
+};
+
+static struct wakeup_info {
+	int mode;
+	unsigned int wakeups[WAKEUP_MODE_MAX];
+	unsigned int sources[WAKEUP_MODE_MAX][WAKEUP_SOURCE_MAX];
+	time_t period_start;
+	Ecore_Idle_Exiter *idle_exiter;
+	Ecore_Animator *animator;
+	Ecore_Timer *timer;
+	double timer_interval;
+	bool animated;
+	bool in_frame;
+	struct _wakeup_frame frames[WAKEUP_FRAME_MAX];
+} s_info = {
+	.mode = WAKEUP_MODE_NORMAL,
+	.period_start = 0,
+	.idle_exiter = NULL,
+	.animator = NULL,
+	.timer = NULL,
+	.timer_interval = 0.0,
+	.animated = false,
+	.in_frame = false,
+};
+
+static Eina_Bool _idle_exiter_cb(void *data);
+static Eina_Bool _animator_cb(void *data);
+static Eina_Bool _timer_cb(void *data);
+static bool _update_source(void);
+
+/**
+ * @brief Initialization function for wakeup module.
+ */
+void wakeup_initialize(void)
+{
+	memset(s_info.wakeups, 0, sizeof(s_info.wakeups));
+	memset(s_info.sources, 0, sizeof(s_info.sources));
+	memset(s_info.frames, 0, sizeof(s_info.frames));
+
+	// Every time the loop leaves idle is one wakeup, whoever caused it
+	s_info.idle_exiter = ecore_idle_exiter_add(_idle_exiter_cb, NULL);
+	if (s_info.idle_exiter == NULL)
+		dlog_print(DLOG_ERROR, LOG_TAG, "Failed to add idle exiter");
+}
+
+/**
+ * @brief Finalization function for wakeup module.
+ */
+void wakeup_finalize(void)
+{
+	if (s_info.idle_exiter)
+	{
+		ecore_idle_exiter_del(s_info.idle_exiter);
+		s_info.idle_exiter = NULL;
+	}
+
+	if (s_info.animator)
+	{
+		ecore_animator_del(s_info.animator);
+		s_info.animator = NULL;
+	}
+
+	if (s_info.timer)
+	{
+		ecore_timer_del(s_info.timer);
+		s_info.timer = NULL;
+	}
+}
+
+/**
+ * @brief Set the mode the following wakeups are counted in.
+ * @param[in] ambient True in ambient mode
+ */
+void wakeup_set_ambient(bool ambient)
+{
+	s_info.mode = ambient ? WAKEUP_MODE_AMBIENT : WAKEUP_MODE_NORMAL;
+}
+
+/**
+ * @brief Attribute a wakeup to one of our sources.
+ * @param[in] source The source that ran
+ */
+void wakeup_count(wakeup_source_e source)
+{
+	if (source < 0 || source >= WAKEUP_SOURCE_MAX)
+		return;
+
+	s_info.sources[s_info.mode][source]++;
+}
+
+/**
+ * @brief Log wakeups per minute in each mode, once per report period.
+ * The ticks give the time spent in each mode: one per second in normal
+ * mode, one per minute in ambient.
+ * @param[in] now The current UTC timestamp
+ */
+void wakeup_report(time_t now)
+{
+	char line[256] = { 0, };
+	unsigned int attributed = 0;
+	double minutes = 0.0f;
+	int len = 0;
+	int mode = 0;
+	int i = 0;
+
+	if (s_info.period_start == 0)
+		s_info.period_start = now;
+
+	if (now - s_info.period_start < WAKEUP_REPORT_PERIOD)
+		return;
+
+	for (mode = 0; mode < WAKEUP_MODE_MAX; mode++)
+	{
+		if (mode == WAKEUP_MODE_NORMAL)
+			minutes = s_info.sources[mode][WAKEUP_SOURCE_TIME_TICK] / 60.0f;
+		else
+			minutes = s_info.sources[mode][WAKEUP_SOURCE_AMBIENT_TICK];
+
+		if (minutes <= 0.0f)
+			continue;
+
+		attributed = 0;
+		len = snprintf(line, sizeof(line), "%.1f/min", s_info.wakeups[mode] / minutes);
+		for (i = 0; i < WAKEUP_SOURCE_MAX && len < (int)sizeof(line); i++)
+		{
+			attributed += s_info.sources[mode][i];
+			len += snprintf(line + len, sizeof(line) - len, " %s %.1f", s_source_names[i], s_info.sources[mode][i] / minutes);
+		}
+
+		// Edje animations, input and system events make up the rest
+		if (len < (int)sizeof(line))
+			snprintf(line + len, sizeof(line) - len, " other %.1f",
+					(s_info.wakeups[mode] > attributed ? s_info.wakeups[mode] - attributed : 0) / minutes);
+
+		dlog_print(DLOG_INFO, LOG_TAG, "wakeups %s: %s", (mode == WAKEUP_MODE_NORMAL ? "normal" : "ambient"), line);
+	}
+
+	memset(s_info.wakeups, 0, sizeof(s_info.wakeups));
+	memset(s_info.sources, 0, sizeof(s_info.sources));
+	s_info.period_start = now;
+}
+
+/**
+ * @brief Tell whether something other than the frame clients keeps the animator running.
+ * The clients then take their frames on its ticks rather than on a timer of their own.
+ * @param[in] animated True while an Edje animation runs all the time, such as the second hand sweep
+ */
+void wakeup_set_animated(bool animated)
+{
+	if (s_info.animated == animated)
+		return;
+
+	s_info.animated = animated;
+	_update_source();
+}
+
+/**
+ * @brief Add a frame client, called at most once per interval.
+ * @param[in] interval The minimum time between frames, in seconds
+ * @param[in] frame_cb The function to call, return ECORE_CALLBACK_CANCEL to remove the client
+ * @param[in] data The user data
+ * @return The frame handle, or NULL on failure
+ */
+wakeup_frame_h wakeup_frame_add(double interval, Ecore_Task_Cb frame_cb, const void *data)
+{
+	struct _wakeup_frame *frame = NULL;
+	int i = 0;
+
+	for (i = 0; i < WAKEUP_FRAME_MAX; i++)
+	{
+		if (!s_info.frames[i].used)
+		{
+			frame = &s_info.frames[i];
+			break;
+		}
+	}
+
+	if (frame == NULL)
+	{
+		dlog_print(DLOG_ERROR, LOG_TAG, "Too many frame clients");
+		return NULL;
+	}
+
+	frame->used = true;
+	frame->interval = interval;
+	frame->next_due = ecore_loop_time_get();
+	frame->frame_cb = frame_cb;
+	frame->data = data;
+
+	if (!_update_source())
+	{
+		frame->used = false;
+		_update_source();
+		return NULL;
+	}
+
+	return frame;
+}
+
+/**
+ * @brief Remove a frame client. The animator or timer stops with the last one.
+ * @param[in] frame The frame handle
+ */
+void wakeup_frame_del(wakeup_frame_h frame)
+{
+	if (frame == NULL)
+		return;
+
+	frame->used = false;
+	_update_source();
+}
+
+/**
+ * @brief Run the frame clients on the animator or on a timer, whichever wakes the loop less.
+ * Left to the end of a frame when called from one, so the running source is not swapped under it.
+ * @return False if the source could not be added
+ */
+static bool _update_source(void)
+{
+	double frame_time = ecore_animator_frametime_get();
+	double interval = 0.0;
+	bool used = false;
+	bool vsync = false;
+	int i = 0;
+
+	if (s_info.in_frame)
+		return true;
+
+	for (i = 0; i < WAKEUP_FRAME_MAX; i++)
+	{
+		if (!s_info.frames[i].used)
+			continue;
+
+		if (!used || s_info.frames[i].interval < interval)
+			interval = s_info.frames[i].interval;
+		used = true;
+	}
+
+	vsync = used && (s_info.animated || interval <= frame_time);
+
+	if (s_info.animator && !vsync)
+	{
+		ecore_animator_del(s_info.animator);
+		s_info.animator = NULL;
+	}
+
+	if (s_info.timer && (vsync || !used || s_info.timer_interval != interval))
+	{
+		ecore_timer_del(s_info.timer);
+		s_info.timer = NULL;
+	}
+
+	if (vsync && s_info.animator == NULL)
+	{
+		s_info.animator = ecore_animator_add(_animator_cb, NULL);
+		if (s_info.animator == NULL)
+		{
+			dlog_print(DLOG_ERROR, LOG_TAG, "Failed to add animator");
+			return false;
+		}
+	}
+	else if (used && !vsync && s_info.timer == NULL)
+	{
+		s_info.timer = ecore_timer_add(interval, _timer_cb, NULL);
+		if (s_info.timer == NULL)
+		{
+			dlog_print(DLOG_ERROR, LOG_TAG, "Failed to add frame timer");
+			return false;
+		}
+		s_info.timer_interval = interval;
+	}
+
+	return true;
+}
+
+/**
+ * @brief Run the frame clients that are due.
+ * @param[in] now The time to run them for
+ */
+static void _run_frames(double now)
+{
+	struct _wakeup_frame *frame = NULL;
+	int i = 0;
+
+	s_info.in_frame = true;
+
+	for (i = 0; i < WAKEUP_FRAME_MAX; i++)
+	{
+		frame = &s_info.frames[i];
+		if (!frame->used || now < frame->next_due)
+			continue;
+
+		// Stay on the interval grid, unless too far behind to catch up
+		frame->next_due += frame->interval;
+		if (frame->next_due < now)
+			frame->next_due = now + frame->interval;
+
+		if (frame->frame_cb((void *)frame->data) == ECORE_CALLBACK_CANCEL)
+			frame->used = false;
+	}
+
+	s_info.in_frame = false;
+	_update_source();
+}
+
+/**
+ * @brief Count a main loop wakeup.
+ * @param[in] data The user data
+ */
+static Eina_Bool _idle_exiter_cb(void *data)
+{
+	s_info.wakeups[s_info.mode]++;
+
+	return ECORE_CALLBACK_RENEW;
+}
+
+/**
+ * @brief Run the frame clients that are due on this vsync.
+ * Unless something else keeps the animator running, each tick is a wakeup of ours.
+ * @param[in] data The user data
+ */
+static Eina_Bool _animator_cb(void *data)
+{
+	Ecore_Animator *animator = s_info.animator;
+
+	if (!s_info.animated)
+		wakeup_count(WAKEUP_SOURCE_FRAME);
+
+	// Half a vsync of slack, so jitter does not push a frame to the next one
+	_run_frames(ecore_loop_time_get() + (ecore_animator_frametime_get() / 2));
+
+	return (s_info.animator == animator) ? ECORE_CALLBACK_RENEW : ECORE_CALLBACK_CANCEL;
+}
+
+/**
+ * @brief Run the frame clients that are due when no animator is running.
+ * @param[in] data The user data
+ */
+static Eina_Bool _timer_cb(void *data)
+{
+	Ecore_Timer *timer = s_info.timer;
+
+	wakeup_count(WAKEUP_SOURCE_FRAME);
+
+	// The same slack as on the animator, a timer is late rather than early
+	_run_frames(ecore_loop_time_get() + (ecore_animator_frametime_get() / 2));
+
+	return (s_info.timer == timer) ? ECORE_CALLBACK_RENEW : ECORE_CALLBACK_CANCEL;
+}
@@ -0,0 +1,273 @@
+/*
+ * Time the rotated-sprite blit kernels against the scalar reference.
+ *
+ * Each hand sprite in res/images is drawn with its look.h geometry, rotated
+ * about the frame centre at every whole degree, with each kernel this host
+ * supports. Every frame must match the scalar kernel bit for bit.
+ *
+ * Usage: blit_bench [-i iterations] res_dir
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "look.h"
+#include "render_blit.h"
+#include "render_soft.h"
+
+#define FRAME_SIZE BASE_WIDTH
+#define FRAME_BACKGROUND 0xff203040
+#define DEGREES 360
+
+typedef struct _hand {
+	const char *image;
+	int w;
+	int h;
+	int y;
+} hand_s;
+
+typedef struct _sprite {
+	const hand_s *hand;
+	uint32_t *pixels;
+	int w;
+	int h;
+	render_blit_span_s *spans;
+	int *offsets;
+	int first[DEGREES + 1];
+	int span_cnt;
+	int pixel_cnt;
+} sprite_s;
+
+static double _now(void)
+{
+	struct timespec ts = { 0, };
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + (ts.tv_nsec / 1000000000.0);
+}
+
+static void _clear(uint32_t *frame)
+{
+	int i = 0;
+
+	for (i = 0; i < FRAME_SIZE * FRAME_SIZE; i++)
+		frame[i] = FRAME_BACKGROUND;
+}
+
+/**
+ * @brief Clip the rows of the sprite at one angle, as _draw_span() in
+ * render_soft.c does. The spans are set up once, so only the kernels are timed.
+ */
+static void _add_spans(sprite_s *sprite, double degree)
+{
+	double rad = degree * M_PI / 180.0;
+	double co = cos(rad);
+	double si = sin(rad);
+	double c = FRAME_SIZE / 2.0;
+	double ox = c - (sprite->hand->w / 2.0);
+	double oy = sprite->hand->y;
+	double sx = (double)sprite->w / sprite->hand->w;
+	double sy = (double)sprite->h / sprite->hand->h;
+	double px = 0.0, py = 0.0, lx = 0.0, ly = 0.0;
+	render_blit_span_s *span = NULL;
+	int x = 0, y = 0;
+
+	for (y = 0; y < FRAME_SIZE; y++) {
+		span = NULL;
+		for (x = 0; x < FRAME_SIZE; x++) {
+			px = x + 0.5 - c;
+			py = y + 0.5 - c;
+			lx = c + (px * co) + (py * si) - ox;
+			ly = c - (px * si) + (py * co) - oy;
+
+			if (lx < 0 || ly < 0 || lx >= sprite->hand->w || ly >= sprite->hand->h) {
+				if (span)
+					break;
+				continue;
+			}
+
+			if (span == NULL) {
+				sprite->offsets[sprite->span_cnt] = (y * FRAME_SIZE) + x;
+				span = &sprite->spans[sprite->span_cnt++];
+				span->dst = NULL;
+				span->count = 0;
+				span->src = sprite->pixels;
+				span->src_w = sprite->w;
+				span->src_h = sprite->h;
+				span->u = (int32_t)lround(((lx * sx) - 0.5) * 65536.0);
+				span->v = (int32_t)lround(((ly * sy) - 0.5) * 65536.0);
+				span->du = (int32_t)lround(co * sx * 65536.0);
+				span->dv = (int32_t)lround(-si * sy * 65536.0);
+				span->color = 0xffffffff;
+			}
+			span->count++;
+			sprite->pixel_cnt++;
+		}
+	}
+}
+
+/**
+ * @brief Draw spans [first, last) into a frame.
+ */
+static void _draw(render_blit_span_cb blit, const sprite_s *sprite, int first, int last, uint32_t *frame)
+{
+	render_blit_span_s span;
+	int i = 0;
+
+	for (i = first; i < last; i++) {
+		span = sprite->spans[i];
+		span.dst = frame + sprite->offsets[i];
+		blit(&span);
+	}
+}
+
+static bool _load(const char *res_dir, const hand_s *hand, sprite_s *sprite)
+{
+	char path[4096] = { 0, };
+	int degree = 0;
+
+	memset(sprite, 0, sizeof(*sprite));
+	sprite->hand = hand;
+
+	snprintf(path, sizeof(path), "%s/images/%s", res_dir, hand->image);
+	sprite->pixels = render_soft_load_png(path, true, &sprite->w, &sprite->h);
+	if (sprite->pixels == NULL) {
+		fprintf(stderr, "failed to load %s\n", path);
+		return false;
+	}
+
+	sprite->spans = malloc(sizeof(render_blit_span_s) * FRAME_SIZE * DEGREES);
+	sprite->offsets = malloc(sizeof(int) * FRAME_SIZE * DEGREES);
+	if (sprite->spans == NULL || sprite->offsets == NULL) {
+		free(sprite->offsets);
+		free(sprite->spans);
+		free(sprite->pixels);
+		return false;
+	}
+
+	for (degree = 0; degree < DEGREES; degree++) {
+		sprite->first[degree] = sprite->span_cnt;
+		_add_spans(sprite, degree);
+	}
+	sprite->first[DEGREES] = sprite->span_cnt;
+
+	return true;
+}
+
+/**
+ * @brief Compare one kernel with the scalar one, angle by angle.
+ */
+static bool _check(render_blit_span_cb blit, const sprite_s *sprite, uint32_t *frame, uint32_t *expected)
+{
+	render_blit_span_cb scalar = render_blit_get(RENDER_BLIT_SCALAR);
+	int degree = 0;
+
+	for (degree = 0; degree < DEGREES; degree++) {
+		_clear(expected);
+		_draw(scalar, sprite, sprite->first[degree], sprite->first[degree + 1], expected);
+		_clear(frame);
+		_draw(blit, sprite, sprite->first[degree], sprite->first[degree + 1], frame);
+
+		if (memcmp(frame, expected, sizeof(uint32_t) * FRAME_SIZE * FRAME_SIZE) != 0)
+			return false;
+	}
+
+	return true;
+}
+
+int main(int argc, char *argv[])
+{
+	static const hand_s hands[] = {
+		{ "watch_hand_min.png", HANDS_MIN_WIDTH, HANDS_MIN_HEIGHT, 0 },
+		{ "watch_hand_min_shadow.png", HANDS_MIN_WIDTH, HANDS_MIN_HEIGHT, 0 },
+		{ "watch_hand_min_ambient.png", HANDS_MIN_WIDTH, HANDS_MIN_HEIGHT, 0 },
+		{ "watch_hand_hr.png", HANDS_HOUR_WIDTH, HANDS_HOUR_HEIGHT, 0 },
+		{ "watch_hand_hr_shadow.png", HANDS_HOUR_WIDTH, HANDS_HOUR_HEIGHT, 0 },
+		{ "watch_hand_hr_ambient.png", HANDS_HOUR_WIDTH, HANDS_HOUR_HEIGHT, 0 },
+		{ "watch_hand_battery.png", HANDS_BAT_WIDTH, HANDS_BAT_HEIGHT, (BASE_HEIGHT / 2) - (HANDS_BAT_HEIGHT / 2) - HANDS_BAT_Y_PADDING },
+		{ "watch_hand_battery_shadow.png", HANDS_BAT_WIDTH, HANDS_BAT_HEIGHT, (BASE_HEIGHT / 2) - (HANDS_BAT_HEIGHT / 2) - HANDS_BAT_Y_PADDING },
+	};
+	sprite_s sprite;
+	render_blit_span_cb blit = NULL;
+	uint32_t *frame = NULL;
+	uint32_t *expected = NULL;
+	double start = 0.0;
+	double spent = 0.0;
+	double scalar_ns = 0.0;
+	bool exact = true;
+	bool ok = true;
+	int iterations = 20;
+	int kernel = 0;
+	int opt = 0;
+	int i = 0, k = 0;
+
+	while ((opt = getopt(argc, argv, "i:")) != -1) {
+		switch (opt) {
+		case 'i':
+			iterations = atoi(optarg);
+			break;
+		default:
+			fprintf(stderr, "usage: %s [-i iterations] res_dir\n", argv[0]);
+			return 1;
+		}
+	}
+
+	if (argc - optind != 1 || iterations <= 0) {
+		fprintf(stderr, "usage: %s [-i iterations] res_dir\n", argv[0]);
+		return 1;
+	}
+
+	frame = malloc(sizeof(uint32_t) * FRAME_SIZE * FRAME_SIZE);
+	expected = malloc(sizeof(uint32_t) * FRAME_SIZE * FRAME_SIZE);
+	if (frame == NULL || expected == NULL) {
+		fprintf(stderr, "failed to allocate the frame\n");
+		return 1;
+	}
+
+	printf("best kernel: %s\n", render_blit_get_name(render_blit_get_best()));
+	printf("%-32s %-8s %10s %8s %s\n", "sprite", "kernel", "ns/pixel", "speedup", "exact");
+
+	for (i = 0; i < (int)(sizeof(hands) / sizeof(hands[0])); i++) {
+		if (!_load(argv[optind], &hands[i], &sprite)) {
+			ok = false;
+			continue;
+		}
+
+		for (kernel = 0; kernel < RENDER_BLIT_MAX; kernel++) {
+			blit = render_blit_get(kernel);
+			if (blit == NULL)
+				continue;
+
+			// Blending over the previous angles keeps the destination changing
+			_clear(frame);
+			start = _now();
+			for (k = 0; k < iterations; k++)
+				_draw(blit, &sprite, 0, sprite.span_cnt, frame);
+			spent = ((_now() - start) * 1000000000.0) / ((double)sprite.pixel_cnt * iterations);
+
+			if (kernel == RENDER_BLIT_SCALAR)
+				scalar_ns = spent;
+
+			exact = (kernel == RENDER_BLIT_SCALAR) || _check(blit, &sprite, frame, expected);
+			if (!exact)
+				ok = false;
+
+			printf("%-32s %-8s %10.3f %7.2fx %s\n", hands[i].image, render_blit_get_name(kernel), spent, scalar_ns / spent,
+					kernel == RENDER_BLIT_SCALAR ? "-" : (exact ? "yes" : "NO"));
+		}
+
+		free(sprite.offsets);
+		free(sprite.spans);
+		free(sprite.pixels);
+	}
+
+	free(expected);
+	free(frame);
+
+	return ok ? 0 : 1;
+}
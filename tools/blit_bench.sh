@@ -0,0 +1,21 @@
+#!/bin/sh
+#
+# Build the blit microbenchmark and run it on the hand sprites in res/images.
+# Fails if a vector kernel does not match the scalar one bit for bit.
+#
+# Usage: tools/blit_bench.sh [blit_bench options]
+#
+# CFLAGS picks the kernels built in, e.g. CFLAGS="-O2 -mno-sse2" on x86
+# for the scalar kernel alone.
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+CC=${CC:-cc}
+CFLAGS=${CFLAGS:--O2}
+
+BIN=${TMPDIR:-/tmp}/blit_bench.$$
+trap 'rm -f "$BIN"' EXIT
+
+$CC -std=gnu99 $CFLAGS -I"$ROOT/tools/soft" -I"$ROOT/inc" -o "$BIN" \
+	"$ROOT/tools/blit_bench.c" "$ROOT/src/render.c" "$ROOT/tools/soft/render_soft.c" "$ROOT/tools/soft/render_blit.c" -lpng -lm || exit 1
+
+"$BIN" "$@" "$ROOT/res"
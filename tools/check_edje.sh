@@ -0,0 +1,112 @@
+#!/bin/sh
+#
+# Offline check of the Edje theme and image assets.
+#
+#  - compiles res/edje/main.edc with edje_cc
+#  - checks every image referenced by the EDC and by inc/data.h exists
+#  - checks no image is byte-identical across edje/images and res/images
+#  - tries lossy encoding per image and suggests LOSSY where PSNR allows
+#  - prints package size, and the decode time per image timed in process
+#    by tools/decode_bench.c
+#
+# Usage: tools/check_edje.sh [-q lossy_quality] [-p min_psnr_db] [-n decode_runs]
+#
+# Needs edje_cc (EFL), md5sum, ImageMagick (convert, compare), a C compiler
+# and libpng.
+
+QUALITY=90
+MIN_PSNR=40
+DECODE_RUNS=20
+
+while getopts "q:p:n:" opt; do
+	case $opt in
+	q) QUALITY=$OPTARG ;;
+	p) MIN_PSNR=$OPTARG ;;
+	n) DECODE_RUNS=$OPTARG ;;
+	*) echo "usage: $0 [-q lossy_quality] [-p min_psnr_db] [-n decode_runs]"; exit 2 ;;
+	esac
+done
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+CC=${CC:-cc}
+EDC="$ROOT/res/edje/main.edc"
+EDJE_IMAGES="$ROOT/edje/images"
+RES_IMAGES="$ROOT/res/images"
+OUT=$(mktemp -d)
+trap 'rm -rf "$OUT"' EXIT
+ERRORS=0
+
+echo "== Compile"
+if ! command -v edje_cc >/dev/null 2>&1; then
+	echo "edje_cc not found"
+	exit 1
+fi
+if ! edje_cc -id "$EDJE_IMAGES" "$EDC" "$OUT/main.edj"; then
+	echo "edje_cc failed"
+	exit 1
+fi
+echo "main.edj: $(wc -c < "$OUT/main.edj") bytes"
+
+echo "== Referenced images"
+# Preprocess first so commented-out groups are not checked
+cpp -P -w "$EDC" |
+	grep -o -E '(image|normal|tween):[[:space:]]*"[^"]+"' |
+	sed -e 's/.*"\(.*\)"/\1/' | sort -u > "$OUT/edc_images"
+while read -r img; do
+	if [ ! -f "$EDJE_IMAGES/$img" ]; then
+		echo "missing: edje/images/$img"
+		ERRORS=$((ERRORS + 1))
+	fi
+done < "$OUT/edc_images"
+grep -o -E '"images/[^"]+"' "$ROOT/inc/data.h" | tr -d '"' | sort -u > "$OUT/data_images"
+while read -r img; do
+	if [ ! -f "$ROOT/res/$img" ]; then
+		echo "missing: res/$img (inc/data.h)"
+		ERRORS=$((ERRORS + 1))
+	fi
+done < "$OUT/data_images"
+
+echo "== Duplicates"
+# An image in both trees is packaged twice, keep one copy only
+md5sum "$EDJE_IMAGES"/*.png "$RES_IMAGES"/*.png | sort |
+	awk '{ if ($1 == last) { print "identical: " lastfile " " $2 } last = $1; lastfile = $2 }' |
+	sed -e "s:$ROOT/::g" > "$OUT/duplicates"
+cat "$OUT/duplicates"
+ERRORS=$((ERRORS + $(wc -l < "$OUT/duplicates")))
+
+echo "== Compression (quality $QUALITY, threshold $MIN_PSNR dB)"
+if command -v convert >/dev/null 2>&1 && command -v compare >/dev/null 2>&1; then
+	while read -r img; do
+		src="$EDJE_IMAGES/$img"
+		[ -f "$src" ] || continue
+		convert "$src" -quality "$QUALITY" "$OUT/lossy.jpg"
+		convert "$src" -alpha off "$OUT/ref.png"
+		psnr=$(compare -metric PSNR "$OUT/ref.png" "$OUT/lossy.jpg" null: 2>&1 | cut -d' ' -f1)
+		verdict=COMP
+		if [ "$psnr" = "inf" ] || awk "BEGIN { exit !($psnr >= $MIN_PSNR) }"; then
+			verdict=LOSSY
+		fi
+		printf "%-36s %8d -> %8d bytes  %6s dB  %s\n" "$img" \
+			"$(wc -c < "$src")" "$(wc -c < "$OUT/lossy.jpg")" "$psnr" "$verdict"
+	done < "$OUT/edc_images"
+else
+	echo "ImageMagick not found, skipped"
+fi
+
+echo "== Decode time ($DECODE_RUNS runs)"
+if $CC -std=gnu99 -O2 -I"$ROOT/tools/soft" -I"$ROOT/inc" -o "$OUT/decode_bench" \
+		"$ROOT/tools/decode_bench.c" "$ROOT/src/render.c" "$ROOT/tools/soft/render_soft.c" "$ROOT/tools/soft/render_blit.c" -lpng -lm; then
+	(cd "$ROOT" && "$OUT/decode_bench" -n "$DECODE_RUNS" edje/images/*.png res/images/*.png) || ERRORS=$((ERRORS + 1))
+else
+	echo "decode_bench failed to build, skipped"
+fi
+
+echo "== Package size"
+res_bytes=$(find "$ROOT/res" "$ROOT/shared" -type f ! -name '*.edc' -exec cat {} + | wc -c)
+echo "res + shared: $res_bytes bytes"
+echo "res + shared + main.edj: $((res_bytes + $(wc -c < "$OUT/main.edj"))) bytes"
+
+if [ $ERRORS -ne 0 ]; then
+	echo "$ERRORS missing or duplicate image(s)"
+	exit 1
+fi
@@ -0,0 +1,74 @@
+/*
+ * Time the decode of PNG images in process, through libpng.
+ *
+ * Each image is decoded to premultiplied ARGB, as Evas keeps it, the
+ * given number of times, and the average time of one decode is printed.
+ * Nothing else is timed: no process startup, no file cache misses after
+ * the first run.
+ *
+ * Usage: decode_bench [-n runs] image...
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "render_soft.h"
+
+#define USAGE "usage: %s [-n runs] image...\n"
+
+static double _now(void)
+{
+	struct timespec ts = { 0, };
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + (ts.tv_nsec / 1000000000.0);
+}
+
+int main(int argc, char *argv[])
+{
+	uint32_t *pixels = NULL;
+	double start = 0.0;
+	int runs = 20;
+	int failed = 0;
+	int w = 0, h = 0;
+	int opt = 0;
+	int i = 0, n = 0;
+
+	while ((opt = getopt(argc, argv, "n:")) != -1) {
+		switch (opt) {
+		case 'n':
+			runs = atoi(optarg);
+			break;
+		default:
+			fprintf(stderr, USAGE, argv[0]);
+			return 2;
+		}
+	}
+
+	if (runs <= 0 || optind >= argc) {
+		fprintf(stderr, USAGE, argv[0]);
+		return 2;
+	}
+
+	for (i = optind; i < argc; i++) {
+		// Once untimed, so the file is read from the cache like the rest
+		pixels = render_soft_load_png(argv[i], true, &w, &h);
+		if (pixels == NULL) {
+			fprintf(stderr, "failed to decode %s\n", argv[i]);
+			failed = 1;
+			continue;
+		}
+		free(pixels);
+
+		start = _now();
+		for (n = 0; n < runs; n++)
+			free(render_soft_load_png(argv[i], true, &w, &h));
+
+		printf("%-50s %5dx%-5d %8.0f us\n", argv[i], w, h, (_now() - start) * 1000000.0 / runs);
+	}
+
+	return failed;
+}
@@ -0,0 +1,337 @@
+/*
+ * Walk the face through its display modes and dump the canvas of each.
+ *
+ * Runs main.c and src/ on the EFL stubs of tools/host, as mem_report.c
+ * does, so the states come from app_ambient_changed(), _set_battery()
+ * and the shadow tiers of the face itself rather than from a copy. The
+ * app starts at the base size at a fixed time in UTC, and each state is
+ * reached from the one before it, the way the watch would go through
+ * them:
+ *
+ *   normal, ambient and back, at a full battery
+ *   the battery drains below the low level: normal, ambient and back
+ *   it charges to within the hysteresis of the low level, then above it
+ *   the shadow tiers off, hard and soft, as set through app_control
+ *   paused and resumed, in normal and in ambient mode
+ *   launched again, on the snapshot the last pause saved: the snapshot
+ *   frame alone, then the scene built over it when idle
+ *
+ * The first launch runs in a child process, so the second one starts
+ * from the clean statics of a new process as on the watch, with only
+ * the data directory carried over.
+ *
+ * Each state is written to out_dir as NN_name.txt by host_dump_canvas():
+ * which images are shown, where, how they are mapped and tinted, and the
+ * messages and texts of the Edje modules. Edje programs do not run, so
+ * a hand swallowed by a module shows the map the face last set on it.
+ *
+ * Usage: face_states [-v] res_dir edje_images_dir out_dir
+ *   -v  print the log of the face
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "host.h"
+#include "look.h"
+#include "data.h"
+#include "settings.h"
+
+/* Saturday 14 March 2026, 10:08:30 UTC */
+#define START_TIME 1773482910
+
+/* Minutes of ticks for the battery gauge to settle on a new level */
+#define SETTLE_MINUTES 15
+
+#define LOOP_MAX 1000
+
+#define USAGE "usage: %s [-v] res_dir edje_images_dir out_dir\n"
+
+static struct {
+	watch_app_lifecycle_callback_s *callback;
+	const char *out_dir;
+	time_t now;
+	bool ambient;
+	int state;
+	bool ok;
+} s_info = {
+	.callback = NULL,
+	.out_dir = NULL,
+	.now = START_TIME,
+	.ambient = false,
+	.state = 0,
+	.ok = true,
+};
+
+/**
+ * @brief Tick the face as the watch would in the current mode, and let it settle.
+ */
+static void _tick(void)
+{
+	watch_time_h watch_time = NULL;
+
+	host_set_time(s_info.now);
+	watch_time = host_watch_time_new();
+
+	if (s_info.ambient)
+		s_info.callback->ambient_tick(watch_time, NULL);
+	else
+		s_info.callback->time_tick(watch_time, NULL);
+
+	watch_time_delete(watch_time);
+
+	host_render();
+	host_run(LOOP_MAX);
+}
+
+/**
+ * @brief Let time pass, a tick a minute.
+ */
+static void _pass_minutes(int minutes)
+{
+	int i = 0;
+
+	for (i = 0; i < minutes; i++) {
+		s_info.now += 60;
+		_tick();
+	}
+}
+
+static void _pause(void)
+{
+	s_info.callback->pause(NULL);
+
+	// The snapshot is taken when idle and written on a worker thread
+	host_render();
+	host_run(LOOP_MAX);
+}
+
+static void _resume(void)
+{
+	s_info.callback->resume(NULL);
+	_tick();
+}
+
+static void _set_ambient(bool ambient)
+{
+	s_info.ambient = ambient;
+	s_info.callback->ambient_changed(ambient, NULL);
+	_tick();
+}
+
+/**
+ * @brief Set the battery and let the gauge settle on it.
+ */
+static void _set_battery(int percent, bool charging)
+{
+	host_set_battery(percent, charging);
+	_pass_minutes(SETTLE_MINUTES);
+}
+
+static void _app_control(const char *key, const char *value)
+{
+	app_control_h app_control = host_app_control_new();
+
+	if (app_control == NULL)
+		return;
+
+	host_app_control_add_extra(app_control, key, value);
+	s_info.callback->app_control(app_control, NULL);
+	host_app_control_free(app_control);
+
+	_tick();
+}
+
+/**
+ * @brief Write the canvas of the current state.
+ */
+static void _dump(const char *name)
+{
+	char path[PATH_MAX] = { 0, };
+	FILE *fp = NULL;
+
+	snprintf(path, sizeof(path), "%s/%02d_%s.txt", s_info.out_dir, ++s_info.state, name);
+	fp = fopen(path, "w");
+	if (fp == NULL) {
+		fprintf(stderr, "failed to write %s\n", path);
+		s_info.ok = false;
+		return;
+	}
+
+	host_dump_canvas(fp);
+
+	if (fclose(fp) != 0) {
+		fprintf(stderr, "failed to write %s\n", path);
+		s_info.ok = false;
+	}
+}
+
+/**
+ * @brief Start cold and walk the face through its states, then pause and quit.
+ */
+static void _first_launch(void)
+{
+	s_info.callback->resume(NULL);
+	_tick();
+	_dump("normal");
+
+	_set_ambient(true);
+	_dump("ambient");
+	_set_ambient(false);
+	_dump("normal_again");
+
+	_set_battery(LOW_BATTERY_LEVEL - 5, false);
+	_dump("normal_low");
+	_set_ambient(true);
+	_dump("ambient_low");
+	_set_ambient(false);
+	_dump("normal_low_again");
+
+	// Above the low level, but not by GAUGE_LOW_HYSTERESIS yet
+	_set_battery(LOW_BATTERY_LEVEL + 2, true);
+	_dump("normal_low_hysteresis");
+	_set_battery(80, true);
+	_dump("normal_charged");
+
+	_app_control(SETTINGS_KEY_SHADOWS, "off");
+	_dump("shadows_off");
+	_app_control(SETTINGS_KEY_SHADOWS, "hard");
+	_dump("shadows_hard");
+	_app_control(SETTINGS_KEY_SHADOWS, "soft");
+	_dump("shadows_soft");
+
+	_pause();
+	_dump("paused");
+	_resume();
+	_dump("resumed");
+
+	_set_ambient(true);
+	_pause();
+	_dump("ambient_paused");
+	_resume();
+	_dump("ambient_resumed");
+	_set_ambient(false);
+
+	_pause();
+	s_info.callback->terminate(NULL);
+}
+
+/**
+ * @brief Start again on the snapshot of the first launch, then pause and quit.
+ */
+static void _second_launch(void)
+{
+	_dump("warm_start");
+
+	s_info.callback->resume(NULL);
+	host_render();
+	host_run(LOOP_MAX);
+	_dump("warm_hydrated");
+
+	_pause();
+	s_info.callback->terminate(NULL);
+}
+
+int host_main(int argc, char *argv[], watch_app_lifecycle_callback_s *callback, void *user_data)
+{
+	char data_dir[] = "/tmp/face_states.XXXXXX";
+	char path[PATH_MAX] = { 0, };
+	pid_t child = 0;
+	int fds[2] = { -1, -1 };
+	int status = 0;
+	int opt = 0;
+
+	host_set_log_level(DLOG_ERROR);
+
+	while ((opt = getopt(argc, argv, "v")) != -1) {
+		switch (opt) {
+		case 'v':
+			host_set_log_level(DLOG_DEBUG);
+			break;
+		default:
+			fprintf(stderr, USAGE, argv[0]);
+			return 1;
+		}
+	}
+
+	if (argc - optind != 3) {
+		fprintf(stderr, USAGE, argv[0]);
+		return 1;
+	}
+
+	// Local time is UTC, so the states do not depend on the host
+	setenv("TZ", "UTC", 1);
+	tzset();
+
+	// No saved settings or snapshot, start cold
+	if (mkdtemp(data_dir) == NULL) {
+		perror("mkdtemp");
+		return 1;
+	}
+
+	s_info.callback = callback;
+	s_info.out_dir = argv[optind + 2];
+
+	host_set_resource_path(argv[optind]);
+	host_set_data_path(data_dir);
+	snprintf(path, sizeof(path), "%s/edje/main.edc", argv[optind]);
+	host_set_edje_source(path, argv[optind + 1]);
+	host_set_battery(80, false);
+	host_set_time(s_info.now);
+
+	if (pipe(fds) != 0) {
+		perror("pipe");
+		return 1;
+	}
+
+	child = fork();
+	if (child < 0) {
+		perror("fork");
+		return 1;
+	}
+
+	if (child == 0) {
+		close(fds[0]);
+		if (!callback->create(BASE_WIDTH, BASE_HEIGHT, user_data)) {
+			fprintf(stderr, "the face failed to start\n");
+			exit(1);
+		}
+
+		_first_launch();
+
+		// The second launch numbers its states on, at the time the first one stopped
+		if (write(fds[1], &s_info.state, sizeof(s_info.state)) != sizeof(s_info.state) ||
+				write(fds[1], &s_info.now, sizeof(s_info.now)) != sizeof(s_info.now))
+			s_info.ok = false;
+		exit(s_info.ok ? 0 : 1);
+	}
+
+	close(fds[1]);
+	if (read(fds[0], &s_info.state, sizeof(s_info.state)) != sizeof(s_info.state) ||
+			read(fds[0], &s_info.now, sizeof(s_info.now)) != sizeof(s_info.now))
+		s_info.ok = false;
+	close(fds[0]);
+
+	if (waitpid(child, &status, 0) != child || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+		s_info.ok = false;
+
+	if (s_info.ok) {
+		s_info.ambient = false;
+		host_set_time(s_info.now);
+		if (callback->create(BASE_WIDTH, BASE_HEIGHT, user_data))
+			_second_launch();
+		else {
+			fprintf(stderr, "the face failed to start again\n");
+			s_info.ok = false;
+		}
+	}
+
+	snprintf(path, sizeof(path), "rm -rf '%s'", data_dir);
+	if (system(path) != 0)
+		fprintf(stderr, "failed to remove %s\n", data_dir);
+
+	return s_info.ok ? 0 : 1;
+}
@@ -0,0 +1,173 @@
+#!/bin/sh
+#
+# Golden check of the watch face across its modes.
+#
+# Two parts, both compared with the golden set in tools/golden:
+#
+# Frames: tools/render_frames.c draws normal and ambient mode at battery
+# levels either side of LOW_BATTERY_LEVEL, and with each shadow tier,
+# over a sweep of times through the day, on the software backend. That
+# checks the scene geometry, assets, colour schemes and blending. Frames
+# are kept as digests (sums.txt). Draw times (times.txt) are reported,
+# with the ratio of each case to normal_bat100 measured in the same run,
+# which does not depend on how fast the host is. On a shared host the
+# ratios still move by a fifth from run to run, so they are only checked
+# against the golden ones with -p.
+#
+# States: tools/face_states.c runs main.c itself on the EFL stubs through
+# ambient and back, the low battery level and its hysteresis, the shadow
+# tiers, pause and resume in either mode, and a second launch on the
+# snapshot of the first, and dumps the canvas of each state (states/).
+# That checks app_ambient_changed(), _set_battery(), the Edje module
+# messages and the warm start, which the software scene does not have.
+#
+# On a failure the rendered frames and dumps are kept for inspection.
+#
+# Usage: tools/golden_frames.sh [-u] [-t minutes] [-p percent] [golden_dir]
+#   -u  write the golden set instead of checking
+#   -t  minutes between frames (default 17, so hands visit many angles)
+#   -p  fail if a draw time ratio is more than this percent over the golden one
+#
+# Needs a C compiler and libpng.
+
+UPDATE=0
+STEP=17
+SLACK=
+DRAWS=5
+USAGE="usage: $0 [-u] [-t minutes] [-p percent] [golden_dir]"
+
+while getopts "ut:p:" opt; do
+	case $opt in
+	u) UPDATE=1 ;;
+	t) STEP=$OPTARG ;;
+	p) SLACK=$OPTARG ;;
+	*) echo "$USAGE"; exit 2 ;;
+	esac
+done
+shift $((OPTIND - 1))
+
+if [ $# -gt 1 ]; then
+	echo "$USAGE"
+	exit 2
+fi
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+CC=${CC:-cc}
+GOLDEN=${1:-$ROOT/tools/golden}
+WORK=${TMPDIR:-/tmp}/golden_frames.$$
+trap 'rm -rf "$WORK"' EXIT
+
+mkdir -p "$WORK/frames" "$WORK/states" || exit 1
+$CC -std=gnu99 -O2 -I"$ROOT/tools/soft" -I"$ROOT/inc" -o "$WORK/render_frames" \
+	"$ROOT/tools/render_frames.c" "$ROOT/src/render.c" "$ROOT/tools/soft/render_soft.c" "$ROOT/tools/soft/render_blit.c" -lpng -lm || exit 1
+$CC -std=gnu99 -O2 -I"$ROOT/tools/host/include" -I"$ROOT/tools/host" -I"$ROOT/inc" -o "$WORK/face_states" \
+	"$ROOT/tools/face_states.c" "$ROOT/tools/host/efl_stub.c" "$ROOT"/src/*.c -lm || exit 1
+
+LOW=$(sed -n 's/^#define LOW_BATTERY_LEVEL \([0-9]*\).*/\1/p' "$ROOT/inc/data.h")
+
+# Render one case, adding its digests and average draw time to the run
+run_case() {
+	CASE=$1
+	shift
+
+	mkdir -p "$WORK/frames/$CASE" || exit 1
+	"$WORK/render_frames" "$@" "$ROOT/res" "$WORK/frames/$CASE" > /dev/null || exit 1
+
+	sed "s|^|$CASE |" "$WORK/frames/$CASE/sums.txt" >> "$WORK/sums.txt"
+	awk -v name="$CASE" '{ sum += $2; n++ } END { printf "%s %.3f\n", name, sum / n }' \
+		"$WORK/frames/$CASE/times.txt" >> "$WORK/times.txt"
+}
+
+for MODE in normal ambient; do
+	for BATTERY in 100 $((LOW + 1)) $LOW 5; do
+		FLAGS="-b $BATTERY -t $STEP -i $DRAWS"
+		[ $MODE = ambient ] && FLAGS="-a $FLAGS"
+		# The steady low state: the gauge is at the level, so the
+		# hysteresis of _set_battery() does not apply, face_states has it
+		[ $BATTERY -le $LOW ] && FLAGS="-l $FLAGS"
+
+		run_case ${MODE}_bat$BATTERY $FLAGS
+	done
+done
+
+# Shadow tiers other than the automatic choice
+for TIER in off hard soft; do
+	run_case normal_shadow_$TIER -w $TIER -b 100 -t $STEP -i $DRAWS
+done
+
+"$WORK/face_states" "$ROOT/res" "$ROOT/edje/images" "$WORK/states" || exit 1
+
+if [ $UPDATE -eq 1 ]; then
+	rm -rf "$GOLDEN/states"
+	mkdir -p "$GOLDEN/states" || exit 1
+	cp "$WORK/sums.txt" "$WORK/times.txt" "$GOLDEN/" || exit 1
+	cp "$WORK/states/"*.txt "$GOLDEN/states/" || exit 1
+	echo "golden set written to $GOLDEN"
+	exit 0
+fi
+
+if [ ! -f "$GOLDEN/sums.txt" ] || [ ! -f "$GOLDEN/times.txt" ]; then
+	echo "no golden set in $GOLDEN, write one with -u"
+	exit 1
+fi
+
+FAILED=0
+
+# Draw time of a case over normal_bat100, from a times.txt of the run
+ratio() {
+	awk -v name="$2" '{ ms[$1] = $2 } END { if (ms["normal_bat100"] > 0) printf "%.3f", ms[name] / ms["normal_bat100"]; else print 0 }' "$1"
+}
+
+printf "%-20s %-8s %10s %10s %8s\n" "case" "frames" "golden ms" "ms" "ratio"
+
+for CASE in $(awk '{ print $1 }' "$WORK/times.txt"); do
+	GOLD=$(grep -c "^$CASE " "$GOLDEN/sums.txt")
+	DIFF=$(grep "^$CASE " "$WORK/sums.txt" | grep -c -v -x -F -f "$GOLDEN/sums.txt")
+	if [ "$GOLD" -eq 0 ]; then
+		RESULT=missing
+		FAILED=1
+	elif [ "$DIFF" -ne 0 ] || [ "$GOLD" -ne "$(grep -c "^$CASE " "$WORK/sums.txt")" ]; then
+		RESULT="$DIFF DIFFER"
+		FAILED=1
+	else
+		RESULT=same
+	fi
+
+	OLD=$(ratio "$GOLDEN/times.txt" "$CASE")
+	NEW=$(ratio "$WORK/times.txt" "$CASE")
+	SHOWN=$NEW
+	if [ -n "$SLACK" ] && awk -v old="$OLD" -v new="$NEW" -v slack="$SLACK" 'BEGIN { exit !(new > old * (1 + slack / 100)) }'; then
+		SHOWN="$NEW SLOWER than $OLD"
+		FAILED=1
+	fi
+
+	printf "%-20s %-8s %10s %10s %8s\n" "$CASE" "$RESULT" \
+		"$(awk -v name="$CASE" '$1 == name { print $2 }' "$GOLDEN/times.txt")" \
+		"$(awk -v name="$CASE" '$1 == name { print $2 }' "$WORK/times.txt")" "$SHOWN"
+done
+
+for STATE in "$GOLDEN/states/"*.txt; do
+	NAME=$(basename "$STATE" .txt)
+	if diff -u "$STATE" "$WORK/states/$NAME.txt" > "$WORK/states/$NAME.diff"; then
+		RESULT=same
+	else
+		RESULT=DIFFER
+		FAILED=1
+	fi
+	printf "%-32s %s\n" "state $NAME" "$RESULT"
+done
+
+for STATE in "$WORK/states/"*.txt; do
+	NAME=$(basename "$STATE" .txt)
+	if [ ! -f "$GOLDEN/states/$NAME.txt" ]; then
+		printf "%-32s %s\n" "state $NAME" "missing"
+		FAILED=1
+	fi
+done
+
+if [ $FAILED -ne 0 ]; then
+	trap - EXIT
+	echo "frames and states kept in $WORK"
+fi
+
+exit $FAILED
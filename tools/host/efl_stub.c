@@ -0,0 +1,2462 @@
+/*
+ * EFL and Tizen stubs for host builds of the face, see host.h.
+ *
+ * Objects live in one canvas list, bottom to top. Smart members are in
+ * the list too and point at their parent. elm_bg and elm_image wrap an
+ * image member, and elm_layout wraps an edje member whose image parts
+ * come from the EDC source. Idlers, image preloads and threads run from
+ * host_run(). Timers, animators and input events never fire. Nothing is
+ * drawn: as in Evas, an image has no pixels to read unless it is decoded,
+ * which the stubs never do, and a buffer canvas reads back opaque black.
+ * Eet files hold named entries one after the other, images as raw ARGB.
+ */
+
+#include <stdarg.h>
+#include <ctype.h>
+#include <math.h>
+
+#include <app.h>
+#include <system_settings.h>
+#include <device/battery.h>
+#include <Ecore_Input.h>
+#include <Eet.h>
+
+#include "host.h"
+
+#define HOST_DATA_MAX 16
+#define HOST_CALLBACK_MAX 8
+#define HOST_PART_MAX 8
+#define HOST_TASK_MAX 32
+#define HOST_EXTRA_MAX 16
+#define HOST_EDC_NAME_MAX 96
+#define HOST_EDC_GROUP_MAX 16
+#define HOST_EDC_PART_MAX 16
+#define HOST_EDC_IMAGE_MAX 64
+#define HOST_EDC_DEPTH_MAX 32
+#define HOST_MAP_POINTS 4
+#define HOST_MESSAGE_MAX 4
+#define HOST_MESSAGE_VAL_MAX 4
+#define HOST_EET_ENTRY_MAX 8
+#define HOST_EET_MAGIC 0x48454554 /* "HEET" */
+
+typedef struct {
+	char *key;
+	const void *data;
+} host_data_s;
+
+typedef struct {
+	Evas_Callback_Type type;
+	Evas_Object_Event_Cb func;
+	const void *data;
+} host_callback_s;
+
+typedef struct {
+	char *name;
+	Evas_Object *content;
+	char *text;
+} host_part_s;
+
+typedef struct {
+	double x, y;
+	double u, v;
+} host_map_point_s;
+
+struct _Evas_Map {
+	int count;
+	host_map_point_s points[HOST_MAP_POINTS];
+};
+
+/* The last int set message of each id an edje object got */
+typedef struct {
+	bool sent;
+	int id;
+	int count;
+	int val[HOST_MESSAGE_VAL_MAX];
+} host_message_s;
+
+struct _Evas_Object {
+	Evas *evas;
+	const char *type;
+	char *name;
+	Evas_Object *below;
+	Evas_Object *above;
+	Evas_Object *smart_parent;
+	bool smart;
+	bool internal; /* Follows the geometry of its parent */
+	int x, y, w, h;
+	bool visible;
+	int r, g, b, a;
+	Evas_Map map;
+	bool map_set;
+	bool map_enabled;
+	host_message_s messages[HOST_MESSAGE_MAX];
+	char *color_class; /* The last one set, with its colour */
+	int class_r, class_g, class_b, class_a;
+	char *file;
+	char *key;
+	int image_w, image_h;
+	Evas_Load_Error load_error;
+	bool preload_pending;
+	Evas_Object *clip;
+	int fill_x, fill_y, fill_w, fill_h;
+	bool fill_set;
+	char *text; /* Text object */
+	char *font;
+	int font_size;
+	Evas_Object *image; /* elm_bg, elm_image */
+	Evas_Object *edje; /* elm_layout */
+	host_data_s data[HOST_DATA_MAX];
+	host_callback_s callbacks[HOST_CALLBACK_MAX];
+	host_part_s parts[HOST_PART_MAX];
+};
+
+typedef struct {
+	Evas_Event_Cb func;
+	const void *data;
+} host_event_s;
+
+struct _Evas {
+	Evas_Object *bottom;
+	Evas_Object *top;
+	host_event_s render_post[HOST_CALLBACK_MAX];
+};
+
+struct _Eina_List {
+	void *data;
+	Eina_List *next;
+};
+
+/* Idlers, idle exiters, timers, animators and threads share one task table */
+typedef enum {
+	HOST_TASK_NONE = 0,
+	HOST_TASK_IDLER,
+	HOST_TASK_IDLE_EXITER,
+	HOST_TASK_TIMER,
+	HOST_TASK_ANIMATOR,
+	HOST_TASK_THREAD,
+	HOST_TASK_EVENT_HANDLER,
+} host_task_type_e;
+
+typedef struct {
+	host_task_type_e type;
+	Ecore_Task_Cb func;
+	Ecore_Thread_Cb blocking;
+	Ecore_Thread_Cb end;
+	Ecore_Thread_Cb cancel;
+	Ecore_Event_Handler_Cb handler;
+	const void *data;
+} host_task_s;
+
+struct _app_control {
+	char *keys[HOST_EXTRA_MAX];
+	char *values[HOST_EXTRA_MAX];
+	int count;
+};
+
+struct _watch_time_s {
+	time_t utc;
+	struct tm local;
+};
+
+typedef struct {
+	char name[HOST_EDC_NAME_MAX];
+	char images[HOST_EDC_PART_MAX][HOST_EDC_NAME_MAX];
+	int image_cnt;
+} host_edc_group_s;
+
+int ECORE_EVENT_MOUSE_BUTTON_DOWN = 1;
+int ECORE_EVENT_MOUSE_BUTTON_UP = 2;
+
+static struct host_info {
+	Evas evas;
+	Evas_Object *win;
+	host_task_s tasks[HOST_TASK_MAX];
+	char resource_path[PATH_MAX];
+	char data_path[PATH_MAX];
+	char edc_path[PATH_MAX];
+	char edje_images_dir[PATH_MAX];
+	bool edc_loaded;
+	host_edc_group_s groups[HOST_EDC_GROUP_MAX];
+	int group_cnt;
+	char edc_images[HOST_EDC_IMAGE_MAX][HOST_EDC_NAME_MAX];
+	int edc_image_cnt;
+	int battery_percent;
+	bool battery_charging;
+	time_t now;
+	log_priority log_level;
+} s_info = {
+	.win = NULL,
+	.resource_path = "./",
+	.data_path = "./",
+	.edc_loaded = false,
+	.group_cnt = 0,
+	.edc_image_cnt = 0,
+	.battery_percent = 100,
+	.battery_charging = false,
+	.now = 0,
+	.log_level = DLOG_WARN,
+};
+
+/*
+ * Host side
+ */
+
+static void _set_dir(char *out, size_t size, const char *dir)
+{
+	size_t len = strlen(dir);
+
+	snprintf(out, size, "%s%s", dir, (len && dir[len - 1] == '/') ? "" : "/");
+}
+
+void host_set_resource_path(const char *dir)
+{
+	_set_dir(s_info.resource_path, sizeof(s_info.resource_path), dir);
+}
+
+void host_set_data_path(const char *dir)
+{
+	_set_dir(s_info.data_path, sizeof(s_info.data_path), dir);
+}
+
+void host_set_edje_source(const char *edc_path, const char *images_dir)
+{
+	snprintf(s_info.edc_path, sizeof(s_info.edc_path), "%s", edc_path);
+	snprintf(s_info.edje_images_dir, sizeof(s_info.edje_images_dir), "%s", images_dir);
+	s_info.edc_loaded = false;
+}
+
+void host_set_battery(int percent, bool charging)
+{
+	s_info.battery_percent = percent;
+	s_info.battery_charging = charging;
+}
+
+/**
+ * @brief Set the wall clock time, 0 for the host clock.
+ */
+void host_set_time(time_t now)
+{
+	s_info.now = now;
+}
+
+void host_set_log_level(log_priority prio)
+{
+	s_info.log_level = prio;
+}
+
+/**
+ * @brief Get the time the watch would pass to a tick. Free with watch_time_delete().
+ */
+watch_time_h host_watch_time_new(void)
+{
+	watch_time_h watch_time = calloc(1, sizeof(*watch_time));
+
+	if (watch_time == NULL)
+		return NULL;
+
+	watch_time->utc = s_info.now ? s_info.now : time(NULL);
+	localtime_r(&watch_time->utc, &watch_time->local);
+
+	return watch_time;
+}
+
+app_control_h host_app_control_new(void)
+{
+	return calloc(1, sizeof(struct _app_control));
+}
+
+void host_app_control_add_extra(app_control_h app_control, const char *key, const char *value)
+{
+	if (app_control == NULL || app_control->count == HOST_EXTRA_MAX)
+		return;
+
+	app_control->keys[app_control->count] = strdup(key);
+	app_control->values[app_control->count] = strdup(value);
+	app_control->count++;
+}
+
+void host_app_control_free(app_control_h app_control)
+{
+	int i = 0;
+
+	if (app_control == NULL)
+		return;
+
+	for (i = 0; i < app_control->count; i++) {
+		free(app_control->keys[i]);
+		free(app_control->values[i]);
+	}
+	free(app_control);
+}
+
+/**
+ * @brief Render a frame, which only calls the render post callbacks.
+ */
+void host_render(void)
+{
+	host_event_s events[HOST_CALLBACK_MAX];
+	int i = 0;
+
+	// A callback may remove itself
+	memcpy(events, s_info.evas.render_post, sizeof(events));
+	for (i = 0; i < HOST_CALLBACK_MAX; i++) {
+		if (events[i].func)
+			events[i].func((void *)events[i].data, &s_info.evas, NULL);
+	}
+}
+
+static void _call_object_callbacks(Evas_Object *obj, Evas_Callback_Type type)
+{
+	host_callback_s callbacks[HOST_CALLBACK_MAX];
+	int i = 0;
+
+	memcpy(callbacks, obj->callbacks, sizeof(callbacks));
+	for (i = 0; i < HOST_CALLBACK_MAX; i++) {
+		if (callbacks[i].func && callbacks[i].type == type)
+			callbacks[i].func((void *)callbacks[i].data, obj->evas, obj, NULL);
+	}
+}
+
+/**
+ * @brief Finish one image preload, if any is pending.
+ */
+static bool _run_preload(void)
+{
+	Evas_Object *obj = NULL;
+
+	for (obj = s_info.evas.bottom; obj; obj = obj->above) {
+		if (!obj->preload_pending)
+			continue;
+
+		obj->preload_pending = false;
+		_call_object_callbacks(obj, EVAS_CALLBACK_IMAGE_PRELOADED);
+		return true;
+	}
+
+	return false;
+}
+
+/**
+ * @brief Run the main loop until nothing is left to do.
+ * @param[in] max_iterations The most loop iterations to run
+ * @return The iterations run
+ */
+int host_run(int max_iterations)
+{
+	host_task_s task;
+	bool busy = true;
+	int iterations = 0;
+	int i = 0;
+
+	while (busy && iterations < max_iterations) {
+		busy = false;
+		iterations++;
+
+		// Woken by the previous iteration's work
+		for (i = 0; i < HOST_TASK_MAX; i++) {
+			if (s_info.tasks[i].type == HOST_TASK_IDLE_EXITER)
+				s_info.tasks[i].func((void *)s_info.tasks[i].data);
+		}
+
+		busy = _run_preload() || busy;
+
+		for (i = 0; i < HOST_TASK_MAX; i++) {
+			task = s_info.tasks[i];
+			if (task.type == HOST_TASK_THREAD) {
+				memset(&s_info.tasks[i], 0, sizeof(s_info.tasks[i]));
+				task.blocking((void *)task.data, (Ecore_Thread *)&s_info.tasks[i]);
+				task.end((void *)task.data, (Ecore_Thread *)&s_info.tasks[i]);
+				busy = true;
+			} else if (task.type == HOST_TASK_IDLER) {
+				if (!task.func((void *)task.data) && s_info.tasks[i].func == task.func)
+					memset(&s_info.tasks[i], 0, sizeof(s_info.tasks[i]));
+				busy = true;
+			}
+		}
+
+		if (busy)
+			host_render();
+	}
+
+	if (busy)
+		fprintf(stderr, "main loop still busy after %d iterations\n", iterations);
+
+	return iterations;
+}
+
+/**
+ * @brief Get a path relative to the resource or data directory, so dumps do not depend on the host.
+ */
+static const char *_relative_path(const char *path)
+{
+	size_t len = strlen(s_info.resource_path);
+	size_t data_len = strlen(s_info.data_path);
+
+	if (path && !strncmp(path, s_info.resource_path, len))
+		return path + len;
+
+	if (path && !strncmp(path, s_info.data_path, data_len))
+		return path + data_len;
+
+	return path;
+}
+
+static void _dump_object(FILE *fp, const Evas_Object *obj, int depth)
+{
+	const Evas_Object *member = NULL;
+	int i = 0;
+
+	fprintf(fp, "%*s%s", depth * 2, "", obj->type);
+	if (obj->name)
+		fprintf(fp, " \"%s\"", obj->name);
+	fprintf(fp, " %d,%d %dx%d%s", obj->x, obj->y, obj->w, obj->h, obj->visible ? "" : " hidden");
+	if (obj->file)
+		fprintf(fp, " %s%s%s", _relative_path(obj->file), obj->key ? ":" : "", obj->key ? obj->key : "");
+	if (obj->r != 255 || obj->g != 255 || obj->b != 255 || obj->a != 255)
+		fprintf(fp, " color %d,%d,%d,%d", obj->r, obj->g, obj->b, obj->a);
+	if (obj->map_set && obj->map_enabled) {
+		fprintf(fp, " map");
+		for (i = 0; i < HOST_MAP_POINTS; i++)
+			fprintf(fp, " %.1f,%.1f", obj->map.points[i].x, obj->map.points[i].y);
+		fprintf(fp, " uv %.0f,%.0f", obj->map.points[2].u, obj->map.points[2].v);
+	}
+	fputc('\n', fp);
+
+	for (i = 0; i < HOST_MESSAGE_MAX; i++) {
+		if (obj->messages[i].sent)
+			fprintf(fp, "%*smessage %d: %d %d %d\n", (depth + 1) * 2, "", obj->messages[i].id,
+					obj->messages[i].val[0], obj->messages[i].val[1], obj->messages[i].val[2]);
+	}
+
+	if (obj->color_class)
+		fprintf(fp, "%*scolor_class %s: %d,%d,%d,%d\n", (depth + 1) * 2, "", obj->color_class,
+				obj->class_r, obj->class_g, obj->class_b, obj->class_a);
+
+	for (i = 0; i < HOST_PART_MAX; i++) {
+		if (obj->parts[i].text)
+			fprintf(fp, "%*stext %s: \"%s\"\n", (depth + 1) * 2, "", obj->parts[i].name, obj->parts[i].text);
+	}
+
+	for (member = obj->evas->bottom; member; member = member->above) {
+		if (member->smart_parent == obj)
+			_dump_object(fp, member, depth + 1);
+	}
+}
+
+/**
+ * @brief Write the canvas as text, one object a line, smart members indented under their parent.
+ * Geometry, visibility, image files, colours, maps, Edje messages and texts are written.
+ */
+void host_dump_canvas(FILE *fp)
+{
+	const Evas_Object *obj = NULL;
+
+	for (obj = s_info.evas.bottom; obj; obj = obj->above) {
+		if (obj->smart_parent == NULL)
+			_dump_object(fp, obj, 0);
+	}
+}
+
+static void *_task_add(host_task_type_e type, Ecore_Task_Cb func, const void *data)
+{
+	int i = 0;
+
+	for (i = 0; i < HOST_TASK_MAX; i++) {
+		if (s_info.tasks[i].type != HOST_TASK_NONE)
+			continue;
+
+		memset(&s_info.tasks[i], 0, sizeof(s_info.tasks[i]));
+		s_info.tasks[i].type = type;
+		s_info.tasks[i].func = func;
+		s_info.tasks[i].data = data;
+		return &s_info.tasks[i];
+	}
+
+	fprintf(stderr, "task table is full\n");
+
+	return NULL;
+}
+
+static void *_task_del(void *handle)
+{
+	host_task_s *task = handle;
+	void *data = NULL;
+
+	if (task == NULL)
+		return NULL;
+
+	data = (void *)task->data;
+	memset(task, 0, sizeof(*task));
+
+	return data;
+}
+
+/*
+ * Images
+ */
+
+/**
+ * @brief Read the size of a PNG from its header.
+ */
+static bool _png_size(const char *path, int *w, int *h)
+{
+	unsigned char head[24];
+	FILE *fp = fopen(path, "rb");
+	bool ok = false;
+
+	if (fp == NULL)
+		return false;
+
+	if (fread(head, 1, sizeof(head), fp) == sizeof(head) && !memcmp(head + 12, "IHDR", 4)) {
+		*w = (head[16] << 24) | (head[17] << 16) | (head[18] << 8) | head[19];
+		*h = (head[20] << 24) | (head[21] << 16) | (head[22] << 8) | head[23];
+		ok = true;
+	}
+	fclose(fp);
+
+	return ok;
+}
+
+/*
+ * Edje, read from the EDC source
+ */
+
+static void _edc_add_image(const char *name)
+{
+	int i = 0;
+
+	for (i = 0; i < s_info.edc_image_cnt; i++) {
+		if (!strcmp(s_info.edc_images[i], name))
+			return;
+	}
+
+	if (s_info.edc_image_cnt < HOST_EDC_IMAGE_MAX)
+		snprintf(s_info.edc_images[s_info.edc_image_cnt++], HOST_EDC_NAME_MAX, "%s", name);
+}
+
+/**
+ * @brief Read the groups, their image parts and the image table of the EDC.
+ * Only a part's first image is taken, as edje decodes the state shown.
+ */
+static bool _edc_load(void)
+{
+	char stack[HOST_EDC_DEPTH_MAX][HOST_EDC_NAME_MAX];
+	char ident[HOST_EDC_NAME_MAX] = { 0, };
+	char key[HOST_EDC_NAME_MAX] = { 0, };
+	char part_image[HOST_EDC_NAME_MAX] = { 0, };
+	char value[HOST_EDC_NAME_MAX] = { 0, };
+	host_edc_group_s *group = NULL;
+	bool in_part = false;
+	int depth = 0;
+	long size = 0;
+	char *text = NULL;
+	char *p = NULL;
+	char *end = NULL;
+	FILE *fp = NULL;
+	int i = 0;
+
+	if (s_info.edc_loaded)
+		return true;
+
+	fp = fopen(s_info.edc_path, "rb");
+	if (fp == NULL) {
+		fprintf(stderr, "failed to open %s\n", s_info.edc_path);
+		return false;
+	}
+
+	fseek(fp, 0, SEEK_END);
+	size = ftell(fp);
+	fseek(fp, 0, SEEK_SET);
+	text = calloc(1, size + 1);
+	if (text == NULL || fread(text, 1, size, fp) != (size_t)size) {
+		free(text);
+		fclose(fp);
+		return false;
+	}
+	fclose(fp);
+
+	s_info.group_cnt = 0;
+	s_info.edc_image_cnt = 0;
+
+	for (p = text; *p; ) {
+		if (isspace((unsigned char)*p)) {
+			p++;
+		} else if (p[0] == '/' && p[1] == '/') {
+			p = strchr(p, '\n') ? strchr(p, '\n') : p + strlen(p);
+		} else if (p[0] == '/' && p[1] == '*') {
+			end = strstr(p + 2, "*/");
+			p = end ? end + 2 : p + strlen(p);
+		} else if (*p == '#' && (p == text || p[-1] == '\n')) {
+			p = strchr(p, '\n') ? strchr(p, '\n') : p + strlen(p);
+		} else if (*p == '"') {
+			end = strchr(p + 1, '"');
+			if (end == NULL)
+				break;
+			snprintf(value, sizeof(value), "%.*s", (int)(end - p - 1), p + 1);
+			p = end + 1;
+
+			if (depth == 0)
+				continue;
+
+			if (!strcmp(key, "name") && !strcmp(stack[depth - 1], "group") && s_info.group_cnt < HOST_EDC_GROUP_MAX) {
+				group = &s_info.groups[s_info.group_cnt++];
+				memset(group, 0, sizeof(*group));
+				snprintf(group->name, sizeof(group->name), "%s", value);
+			} else if (!strcmp(key, "image") && !strcmp(stack[depth - 1], "images")) {
+				_edc_add_image(value);
+			} else if (!strcmp(key, "normal") && !strcmp(stack[depth - 1], "image") && in_part && !part_image[0]) {
+				snprintf(part_image, sizeof(part_image), "%s", value);
+			}
+			key[0] = '\0';
+		} else if (isalnum((unsigned char)*p) || *p == '_' || *p == '.') {
+			for (i = 0; (isalnum((unsigned char)*p) || *p == '_' || *p == '.'); p++) {
+				if (i < (int)sizeof(ident) - 1)
+					ident[i++] = *p;
+			}
+			ident[i] = '\0';
+		} else if (*p == ':') {
+			snprintf(key, sizeof(key), "%s", ident);
+			ident[0] = '\0';
+			p++;
+		} else if (*p == '{') {
+			if (depth < HOST_EDC_DEPTH_MAX)
+				snprintf(stack[depth], sizeof(stack[depth]), "%s", ident);
+			depth++;
+			if (!strcmp(ident, "part")) {
+				in_part = true;
+				part_image[0] = '\0';
+			}
+			ident[0] = '\0';
+			key[0] = '\0';
+			p++;
+		} else if (*p == '}') {
+			if (depth > 0 && depth <= HOST_EDC_DEPTH_MAX && !strcmp(stack[depth - 1], "part")) {
+				if (group && part_image[0] && group->image_cnt < HOST_EDC_PART_MAX)
+					snprintf(group->images[group->image_cnt++], HOST_EDC_NAME_MAX, "%s", part_image);
+				in_part = false;
+			}
+			if (depth > 0)
+				depth--;
+			ident[0] = '\0';
+			key[0] = '\0';
+			p++;
+		} else {
+			if (*p == ';')
+				key[0] = '\0';
+			ident[0] = '\0';
+			p++;
+		}
+	}
+
+	free(text);
+	s_info.edc_loaded = true;
+
+	return true;
+}
+
+static host_edc_group_s *_edc_group_find(const char *name)
+{
+	int i = 0;
+
+	if (!_edc_load())
+		return NULL;
+
+	for (i = 0; i < s_info.group_cnt; i++) {
+		if (!strcmp(s_info.groups[i].name, name))
+			return &s_info.groups[i];
+	}
+
+	return NULL;
+}
+
+static int _edc_image_index(const char *name)
+{
+	int i = 0;
+
+	for (i = 0; i < s_info.edc_image_cnt; i++) {
+		if (!strcmp(s_info.edc_images[i], name))
+			return i;
+	}
+
+	return -1;
+}
+
+/*
+ * Eina
+ */
+
+static Eina_List *_list_append(Eina_List *list, void *data)
+{
+	Eina_List *node = calloc(1, sizeof(*node));
+	Eina_List *last = list;
+
+	if (node == NULL)
+		return list;
+
+	node->data = data;
+	if (list == NULL)
+		return node;
+
+	while (last->next)
+		last = last->next;
+	last->next = node;
+
+	return list;
+}
+
+void *eina_list_data_get(const Eina_List *list)
+{
+	return list ? list->data : NULL;
+}
+
+Eina_List *eina_list_next(const Eina_List *list)
+{
+	return list ? list->next : NULL;
+}
+
+Eina_List *eina_list_remove_list(Eina_List *list, Eina_List *remove_list)
+{
+	Eina_List *l = NULL;
+
+	if (list == NULL || remove_list == NULL)
+		return list;
+
+	if (list == remove_list) {
+		l = list->next;
+		free(list);
+		return l;
+	}
+
+	for (l = list; l->next; l = l->next) {
+		if (l->next == remove_list) {
+			l->next = remove_list->next;
+			free(remove_list);
+			break;
+		}
+	}
+
+	return list;
+}
+
+/*
+ * Evas
+ */
+
+static Evas_Object *_object_add(Evas *e, const char *type, Evas_Object *smart_parent)
+{
+	Evas_Object *obj = calloc(1, sizeof(*obj));
+
+	if (obj == NULL)
+		return NULL;
+
+	obj->evas = e;
+	obj->type = type;
+	obj->smart_parent = smart_parent;
+	obj->r = obj->g = obj->b = obj->a = 255;
+
+	obj->below = e->top;
+	if (e->top)
+		e->top->above = obj;
+	else
+		e->bottom = obj;
+	e->top = obj;
+
+	return obj;
+}
+
+static Evas_Object *_internal_add(Evas_Object *parent, const char *type)
+{
+	Evas_Object *obj = _object_add(parent->evas, type, parent);
+
+	if (obj)
+		obj->internal = true;
+
+	return obj;
+}
+
+static void _eet_image_size(const char *path, const char *key, int *w, int *h, Evas_Load_Error *error);
+
+static void _image_load(Evas_Object *obj)
+{
+	char path[PATH_MAX + HOST_EDC_NAME_MAX] = { 0, };
+	const char *name = NULL;
+	int index = -1;
+
+	obj->image_w = 0;
+	obj->image_h = 0;
+	obj->load_error = EVAS_LOAD_ERROR_NONE;
+
+	if (obj->file == NULL)
+		return;
+
+	// Images in an EDJ are keyed by their index in the image table
+	if (obj->key && sscanf(obj->key, "edje/images/%d", &index) == 1) {
+		if (index >= 0 && index < s_info.edc_image_cnt)
+			name = s_info.edc_images[index];
+		snprintf(path, sizeof(path), "%s/%s", s_info.edje_images_dir, name ? name : "");
+	} else {
+		snprintf(path, sizeof(path), "%s", obj->file);
+	}
+
+	if (access(path, R_OK) != 0)
+		obj->load_error = EVAS_LOAD_ERROR_DOES_NOT_EXIST;
+	else if (name == NULL && obj->key)
+		_eet_image_size(path, obj->key, &obj->image_w, &obj->image_h, &obj->load_error);
+	else if (!_png_size(path, &obj->image_w, &obj->image_h))
+		obj->load_error = EVAS_LOAD_ERROR_GENERIC;
+}
+
+void evas_event_callback_add(Evas *e, Evas_Callback_Type type, Evas_Event_Cb func, const void *data)
+{
+	int i = 0;
+
+	if (type != EVAS_CALLBACK_RENDER_POST)
+		return;
+
+	for (i = 0; i < HOST_CALLBACK_MAX; i++) {
+		if (e->render_post[i].func == NULL) {
+			e->render_post[i].func = func;
+			e->render_post[i].data = data;
+			return;
+		}
+	}
+}
+
+void *evas_event_callback_del(Evas *e, Evas_Callback_Type type, Evas_Event_Cb func)
+{
+	void *data = NULL;
+	int i = 0;
+
+	for (i = 0; i < HOST_CALLBACK_MAX; i++) {
+		if (type == EVAS_CALLBACK_RENDER_POST && e->render_post[i].func == func) {
+			data = (void *)e->render_post[i].data;
+			memset(&e->render_post[i], 0, sizeof(e->render_post[i]));
+			break;
+		}
+	}
+
+	return data;
+}
+
+void evas_event_freeze(Evas *e)
+{
+}
+
+void evas_event_thaw(Evas *e)
+{
+}
+
+Evas *evas_object_evas_get(const Evas_Object *obj)
+{
+	return obj ? obj->evas : NULL;
+}
+
+const char *evas_object_type_get(const Evas_Object *obj)
+{
+	return obj ? obj->type : NULL;
+}
+
+void evas_object_name_set(Evas_Object *obj, const char *name)
+{
+	if (obj == NULL)
+		return;
+
+	free(obj->name);
+	free(obj->text);
+	free(obj->font);
+	free(obj->color_class);
+	obj->name = name ? strdup(name) : NULL;
+}
+
+const char *evas_object_name_get(const Evas_Object *obj)
+{
+	return obj ? obj->name : NULL;
+}
+
+void evas_object_del(Evas_Object *obj)
+{
+	Evas_Object *other = NULL;
+	Evas_Object *next = NULL;
+	int i = 0;
+
+	if (obj == NULL)
+		return;
+
+	_call_object_callbacks(obj, EVAS_CALLBACK_DEL);
+
+	for (other = obj->evas->bottom; other; other = next) {
+		next = other->above;
+		if (other->smart_parent == obj) {
+			evas_object_del(other);
+			// The list changed under us
+			next = obj->evas->bottom;
+		}
+	}
+
+	for (other = obj->evas->bottom; other; other = other->above) {
+		for (i = 0; i < HOST_PART_MAX; i++) {
+			if (other->parts[i].content == obj)
+				other->parts[i].content = NULL;
+		}
+	}
+
+	if (obj->below)
+		obj->below->above = obj->above;
+	else
+		obj->evas->bottom = obj->above;
+	if (obj->above)
+		obj->above->below = obj->below;
+	else
+		obj->evas->top = obj->below;
+
+	for (other = obj->evas->bottom; other; other = other->above) {
+		if (other->clip == obj)
+			other->clip = NULL;
+	}
+
+	if (obj == s_info.win)
+		s_info.win = NULL;
+
+	for (i = 0; i < HOST_DATA_MAX; i++)
+		free(obj->data[i].key);
+	for (i = 0; i < HOST_PART_MAX; i++) {
+		free(obj->parts[i].name);
+		free(obj->parts[i].text);
+	}
+	free(obj->name);
+	free(obj->file);
+	free(obj->key);
+	free(obj);
+}
+
+static void _geometry_set(Evas_Object *obj, int x, int y, int w, int h)
+{
+	Evas_Object *member = NULL;
+
+	obj->x = x;
+	obj->y = y;
+	obj->w = w;
+	obj->h = h;
+
+	for (member = obj->evas->bottom; member; member = member->above) {
+		if (member->smart_parent == obj && member->internal)
+			_geometry_set(member, x, y, w, h);
+	}
+}
+
+void evas_object_move(Evas_Object *obj, Evas_Coord x, Evas_Coord y)
+{
+	if (obj)
+		_geometry_set(obj, x, y, obj->w, obj->h);
+}
+
+void evas_object_resize(Evas_Object *obj, Evas_Coord w, Evas_Coord h)
+{
+	if (obj)
+		_geometry_set(obj, obj->x, obj->y, w, h);
+}
+
+void evas_object_geometry_get(const Evas_Object *obj, Evas_Coord *x, Evas_Coord *y, Evas_Coord *w, Evas_Coord *h)
+{
+	if (x)
+		*x = obj ? obj->x : 0;
+	if (y)
+		*y = obj ? obj->y : 0;
+	if (w)
+		*w = obj ? obj->w : 0;
+	if (h)
+		*h = obj ? obj->h : 0;
+}
+
+/**
+ * @brief Show or hide an object and the members it is made of, not the ones swallowed.
+ */
+static void _visible_set(Evas_Object *obj, bool visible)
+{
+	Evas_Object *member = NULL;
+
+	obj->visible = visible;
+
+	for (member = obj->evas->bottom; member; member = member->above) {
+		if (member->smart_parent == obj && member->internal)
+			_visible_set(member, visible);
+	}
+}
+
+void evas_object_show(Evas_Object *obj)
+{
+	if (obj)
+		_visible_set(obj, true);
+}
+
+void evas_object_hide(Evas_Object *obj)
+{
+	if (obj)
+		_visible_set(obj, false);
+}
+
+void evas_object_color_set(Evas_Object *obj, int r, int g, int b, int a)
+{
+	if (obj == NULL)
+		return;
+
+	obj->r = r;
+	obj->g = g;
+	obj->b = b;
+	obj->a = a;
+}
+
+void evas_object_clip_set(Evas_Object *obj, Evas_Object *clip)
+{
+	if (obj)
+		obj->clip = clip;
+}
+
+Evas_Object *evas_object_clip_get(const Evas_Object *obj)
+{
+	return obj ? obj->clip : NULL;
+}
+
+Eina_Bool evas_object_clipees_has(const Evas_Object *obj)
+{
+	Evas_Object *other = NULL;
+
+	if (obj == NULL)
+		return EINA_FALSE;
+
+	for (other = obj->evas->bottom; other; other = other->above) {
+		if (other->clip == obj)
+			return EINA_TRUE;
+	}
+
+	return EINA_FALSE;
+}
+
+Eina_Bool evas_object_visible_get(const Evas_Object *obj)
+{
+	return obj ? obj->visible : EINA_FALSE;
+}
+
+void evas_object_color_get(const Evas_Object *obj, int *r, int *g, int *b, int *a)
+{
+	if (r)
+		*r = obj ? obj->r : 0;
+	if (g)
+		*g = obj ? obj->g : 0;
+	if (b)
+		*b = obj ? obj->b : 0;
+	if (a)
+		*a = obj ? obj->a : 0;
+}
+
+void evas_object_layer_set(Evas_Object *obj, short layer)
+{
+}
+
+void evas_object_stack_below(Evas_Object *obj, Evas_Object *below)
+{
+}
+
+void evas_object_size_hint_weight_set(Evas_Object *obj, double x, double y)
+{
+}
+
+void evas_object_data_set(Evas_Object *obj, const char *key, const void *data)
+{
+	int free_slot = -1;
+	int i = 0;
+
+	if (obj == NULL || key == NULL)
+		return;
+
+	for (i = 0; i < HOST_DATA_MAX; i++) {
+		if (obj->data[i].key && !strcmp(obj->data[i].key, key)) {
+			obj->data[i].data = data;
+			return;
+		}
+		if (obj->data[i].key == NULL && free_slot < 0)
+			free_slot = i;
+	}
+
+	if (free_slot < 0) {
+		fprintf(stderr, "too much data on an object\n");
+		return;
+	}
+
+	obj->data[free_slot].key = strdup(key);
+	obj->data[free_slot].data = data;
+}
+
+void *evas_object_data_get(const Evas_Object *obj, const char *key)
+{
+	int i = 0;
+
+	if (obj == NULL || key == NULL)
+		return NULL;
+
+	for (i = 0; i < HOST_DATA_MAX; i++) {
+		if (obj->data[i].key && !strcmp(obj->data[i].key, key))
+			return (void *)obj->data[i].data;
+	}
+
+	return NULL;
+}
+
+void *evas_object_data_del(Evas_Object *obj, const char *key)
+{
+	void *data = NULL;
+	int i = 0;
+
+	if (obj == NULL || key == NULL)
+		return NULL;
+
+	for (i = 0; i < HOST_DATA_MAX; i++) {
+		if (obj->data[i].key && !strcmp(obj->data[i].key, key)) {
+			data = (void *)obj->data[i].data;
+			free(obj->data[i].key);
+			memset(&obj->data[i], 0, sizeof(obj->data[i]));
+			break;
+		}
+	}
+
+	return data;
+}
+
+void evas_object_event_callback_add(Evas_Object *obj, Evas_Callback_Type type, Evas_Object_Event_Cb func, const void *data)
+{
+	int i = 0;
+
+	if (obj == NULL)
+		return;
+
+	for (i = 0; i < HOST_CALLBACK_MAX; i++) {
+		if (obj->callbacks[i].func == NULL) {
+			obj->callbacks[i].type = type;
+			obj->callbacks[i].func = func;
+			obj->callbacks[i].data = data;
+			return;
+		}
+	}
+
+	fprintf(stderr, "too many callbacks on an object\n");
+}
+
+void *evas_object_event_callback_del(Evas_Object *obj, Evas_Callback_Type type, Evas_Object_Event_Cb func)
+{
+	void *data = NULL;
+	int i = 0;
+
+	if (obj == NULL)
+		return NULL;
+
+	for (i = 0; i < HOST_CALLBACK_MAX; i++) {
+		if (obj->callbacks[i].type == type && obj->callbacks[i].func == func) {
+			data = (void *)obj->callbacks[i].data;
+			memset(&obj->callbacks[i], 0, sizeof(obj->callbacks[i]));
+			break;
+		}
+	}
+
+	return data;
+}
+
+Evas_Object *evas_object_bottom_get(const Evas *e)
+{
+	return e ? e->bottom : NULL;
+}
+
+Evas_Object *evas_object_above_get(const Evas_Object *obj)
+{
+	return obj ? obj->above : NULL;
+}
+
+Evas_Smart *evas_object_smart_smart_get(const Evas_Object *obj)
+{
+	return (obj && obj->smart) ? (Evas_Smart *)obj : NULL;
+}
+
+Evas_Object *evas_object_smart_parent_get(const Evas_Object *obj)
+{
+	return obj ? obj->smart_parent : NULL;
+}
+
+Eina_List *evas_object_smart_members_get(const Evas_Object *obj)
+{
+	Eina_List *members = NULL;
+	Evas_Object *member = NULL;
+
+	if (obj == NULL)
+		return NULL;
+
+	for (member = obj->evas->bottom; member; member = member->above) {
+		if (member->smart_parent == obj)
+			members = _list_append(members, member);
+	}
+
+	return members;
+}
+
+Evas_Object *evas_object_rectangle_add(Evas *e)
+{
+	return _object_add(e, "rectangle", NULL);
+}
+
+Evas_Object *evas_object_image_add(Evas *e)
+{
+	return _object_add(e, "image", NULL);
+}
+
+Evas_Object *evas_object_image_filled_add(Evas *e)
+{
+	return _object_add(e, "image", NULL);
+}
+
+void evas_object_image_file_set(Evas_Object *obj, const char *file, const char *key)
+{
+	if (obj == NULL)
+		return;
+
+	free(obj->file);
+	free(obj->key);
+	obj->file = file ? strdup(file) : NULL;
+	obj->key = key ? strdup(key) : NULL;
+	_image_load(obj);
+}
+
+void evas_object_image_file_get(const Evas_Object *obj, const char **file, const char **key)
+{
+	if (file)
+		*file = obj ? obj->file : NULL;
+	if (key)
+		*key = obj ? obj->key : NULL;
+}
+
+Evas_Load_Error evas_object_image_load_error_get(const Evas_Object *obj)
+{
+	return obj ? obj->load_error : EVAS_LOAD_ERROR_GENERIC;
+}
+
+void evas_object_image_size_get(const Evas_Object *obj, int *w, int *h)
+{
+	if (w)
+		*w = obj ? obj->image_w : 0;
+	if (h)
+		*h = obj ? obj->image_h : 0;
+}
+
+int evas_object_image_stride_get(const Evas_Object *obj)
+{
+	return obj ? obj->image_w * 4 : 0;
+}
+
+Evas_Colorspace evas_object_image_colorspace_get(const Evas_Object *obj)
+{
+	return EVAS_COLORSPACE_ARGB8888;
+}
+
+void evas_object_image_preload(Evas_Object *obj, Eina_Bool cancel)
+{
+	if (obj)
+		obj->preload_pending = !cancel;
+}
+
+void evas_object_image_source_set(Evas_Object *obj, Evas_Object *src)
+{
+}
+
+/**
+ * @brief No pixels: images are never decoded, and a proxy has none of its own in Evas.
+ */
+void *evas_object_image_data_get(const Evas_Object *obj, Eina_Bool for_writing)
+{
+	return NULL;
+}
+
+void evas_object_image_fill_set(Evas_Object *obj, Evas_Coord x, Evas_Coord y, Evas_Coord w, Evas_Coord h)
+{
+	if (obj == NULL)
+		return;
+
+	obj->fill_x = x;
+	obj->fill_y = y;
+	obj->fill_w = w;
+	obj->fill_h = h;
+	obj->fill_set = true;
+}
+
+/**
+ * @brief The fill set, or the whole object, as a filled image has it.
+ */
+void evas_object_image_fill_get(const Evas_Object *obj, Evas_Coord *x, Evas_Coord *y, Evas_Coord *w, Evas_Coord *h)
+{
+	bool set = obj && obj->fill_set;
+
+	if (x)
+		*x = set ? obj->fill_x : 0;
+	if (y)
+		*y = set ? obj->fill_y : 0;
+	if (w)
+		*w = set ? obj->fill_w : (obj ? obj->w : 0);
+	if (h)
+		*h = set ? obj->fill_h : (obj ? obj->h : 0);
+}
+
+void evas_object_image_border_set(Evas_Object *obj, int l, int r, int t, int b)
+{
+}
+
+void evas_object_image_border_get(const Evas_Object *obj, int *l, int *r, int *t, int *b)
+{
+	if (l)
+		*l = 0;
+	if (r)
+		*r = 0;
+	if (t)
+		*t = 0;
+	if (b)
+		*b = 0;
+}
+
+void evas_object_image_border_center_fill_set(Evas_Object *obj, Evas_Border_Fill_Mode fill)
+{
+}
+
+Evas_Border_Fill_Mode evas_object_image_border_center_fill_get(const Evas_Object *obj)
+{
+	return EVAS_BORDER_FILL_DEFAULT;
+}
+
+void evas_object_image_smooth_scale_set(Evas_Object *obj, Eina_Bool smooth_scale)
+{
+}
+
+Eina_Bool evas_object_image_smooth_scale_get(const Evas_Object *obj)
+{
+	return EINA_TRUE;
+}
+
+Evas_Object *evas_object_text_add(Evas *e)
+{
+	return _object_add(e, "text", NULL);
+}
+
+void evas_object_text_text_set(Evas_Object *obj, const char *text)
+{
+	if (obj == NULL)
+		return;
+
+	free(obj->text);
+	obj->text = text ? strdup(text) : NULL;
+}
+
+const char *evas_object_text_text_get(const Evas_Object *obj)
+{
+	return obj ? obj->text : NULL;
+}
+
+void evas_object_text_font_set(Evas_Object *obj, const char *font, Evas_Font_Size size)
+{
+	if (obj == NULL)
+		return;
+
+	free(obj->font);
+	obj->font = font ? strdup(font) : NULL;
+	obj->font_size = size;
+}
+
+void evas_object_text_font_get(const Evas_Object *obj, const char **font, Evas_Font_Size *size)
+{
+	if (font)
+		*font = obj ? obj->font : NULL;
+	if (size)
+		*size = obj ? obj->font_size : 0;
+}
+
+void evas_object_text_font_source_set(Evas_Object *obj, const char *font_source)
+{
+}
+
+const char *evas_object_text_font_source_get(const Evas_Object *obj)
+{
+	return NULL;
+}
+
+void evas_object_text_style_set(Evas_Object *obj, Evas_Text_Style_Type type)
+{
+}
+
+Evas_Text_Style_Type evas_object_text_style_get(const Evas_Object *obj)
+{
+	return EVAS_TEXT_STYLE_PLAIN;
+}
+
+Eina_Bool evas_object_image_save(const Evas_Object *obj, const char *file, const char *key, const char *flags)
+{
+	return EINA_FALSE;
+}
+
+Evas_Map *evas_map_new(int count)
+{
+	Evas_Map *m = NULL;
+
+	if (count != HOST_MAP_POINTS)
+		return NULL;
+
+	m = calloc(1, sizeof(*m));
+	if (m)
+		m->count = count;
+
+	return m;
+}
+
+void evas_map_free(Evas_Map *m)
+{
+	free(m);
+}
+
+/**
+ * @brief Put the points on the corners of the object, and the UVs on the corners of its size.
+ */
+void evas_map_util_points_populate_from_object(Evas_Map *m, const Evas_Object *obj)
+{
+	if (m == NULL || obj == NULL)
+		return;
+
+	m->points[0] = (host_map_point_s){ obj->x, obj->y, 0, 0 };
+	m->points[1] = (host_map_point_s){ obj->x + obj->w, obj->y, obj->w, 0 };
+	m->points[2] = (host_map_point_s){ obj->x + obj->w, obj->y + obj->h, obj->w, obj->h };
+	m->points[3] = (host_map_point_s){ obj->x, obj->y + obj->h, 0, obj->h };
+}
+
+/**
+ * @brief Rotate the points clockwise around a center, as Evas does.
+ */
+void evas_map_util_rotate(Evas_Map *m, double degrees, Evas_Coord cx, Evas_Coord cy)
+{
+	double r = degrees * M_PI / 180.0;
+	double co = cos(r);
+	double si = sin(r);
+	double x = 0.0, y = 0.0;
+	int i = 0;
+
+	if (m == NULL)
+		return;
+
+	for (i = 0; i < m->count; i++) {
+		x = m->points[i].x - cx;
+		y = m->points[i].y - cy;
+		m->points[i].x = cx + (x * co) - (y * si);
+		m->points[i].y = cy + (x * si) + (y * co);
+	}
+}
+
+void evas_map_point_coord_set(Evas_Map *m, int idx, Evas_Coord x, Evas_Coord y, Evas_Coord z)
+{
+	if (m == NULL || idx < 0 || idx >= m->count)
+		return;
+
+	m->points[idx].x = x;
+	m->points[idx].y = y;
+}
+
+void evas_map_point_image_uv_set(Evas_Map *m, int idx, double u, double v)
+{
+	if (m == NULL || idx < 0 || idx >= m->count)
+		return;
+
+	m->points[idx].u = u;
+	m->points[idx].v = v;
+}
+
+void evas_object_map_set(Evas_Object *obj, const Evas_Map *map)
+{
+	if (obj == NULL)
+		return;
+
+	obj->map_set = map != NULL;
+	if (map)
+		obj->map = *map;
+}
+
+const Evas_Map *evas_object_map_get(const Evas_Object *obj)
+{
+	return (obj && obj->map_set) ? &obj->map : NULL;
+}
+
+Eina_Bool evas_object_map_enable_get(const Evas_Object *obj)
+{
+	return obj ? obj->map_enabled : EINA_FALSE;
+}
+
+void evas_map_point_coord_get(const Evas_Map *m, int idx, Evas_Coord *x, Evas_Coord *y, Evas_Coord *z)
+{
+	bool valid = m && idx >= 0 && idx < m->count;
+
+	if (x)
+		*x = valid ? (Evas_Coord)m->points[idx].x : 0;
+	if (y)
+		*y = valid ? (Evas_Coord)m->points[idx].y : 0;
+	if (z)
+		*z = 0;
+}
+
+void evas_map_point_image_uv_get(const Evas_Map *m, int idx, double *u, double *v)
+{
+	bool valid = m && idx >= 0 && idx < m->count;
+
+	if (u)
+		*u = valid ? m->points[idx].u : 0.0;
+	if (v)
+		*v = valid ? m->points[idx].v : 0.0;
+}
+
+void evas_map_smooth_set(Evas_Map *m, Eina_Bool enabled)
+{
+}
+
+void evas_object_map_enable_set(Evas_Object *obj, Eina_Bool enabled)
+{
+	if (obj)
+		obj->map_enabled = enabled;
+}
+
+/*
+ * Edje
+ */
+
+void edje_object_message_send(Evas_Object *obj, Edje_Message_Type type, int id, void *msg)
+{
+	Edje_Message_Int_Set *int_set = msg;
+	host_message_s *message = NULL;
+	int i = 0;
+
+	if (obj == NULL || type != EDJE_MESSAGE_INT_SET || int_set == NULL)
+		return;
+
+	for (i = 0; i < HOST_MESSAGE_MAX; i++) {
+		if (!obj->messages[i].sent || obj->messages[i].id == id) {
+			message = &obj->messages[i];
+			break;
+		}
+	}
+
+	if (message == NULL)
+		return;
+
+	message->sent = true;
+	message->id = id;
+	message->count = int_set->count < HOST_MESSAGE_VAL_MAX ? int_set->count : HOST_MESSAGE_VAL_MAX;
+	for (i = 0; i < message->count; i++)
+		message->val[i] = int_set->val[i];
+}
+
+Eina_Bool edje_object_color_class_set(Evas_Object *obj, const char *color_class, int r, int g, int b, int a,
+		int r2, int g2, int b2, int a2, int r3, int g3, int b3, int a3)
+{
+	if (obj == NULL || color_class == NULL)
+		return EINA_FALSE;
+
+	free(obj->color_class);
+	obj->color_class = strdup(color_class);
+	obj->class_r = r;
+	obj->class_g = g;
+	obj->class_b = b;
+	obj->class_a = a;
+
+	return EINA_TRUE;
+}
+
+void edje_object_signal_emit(Evas_Object *obj, const char *emission, const char *source)
+{
+}
+
+void edje_object_scale_set(Evas_Object *obj, double scale)
+{
+}
+
+Eina_Bool edje_object_file_get(const Evas_Object *obj, const char **file, const char **group)
+{
+	if (file)
+		*file = obj ? obj->file : NULL;
+	if (group)
+		*group = obj ? obj->key : NULL;
+
+	return obj && obj->file;
+}
+
+Eina_List *edje_file_collection_list(const char *file)
+{
+	Eina_List *groups = NULL;
+	int i = 0;
+
+	if (!_edc_load())
+		return NULL;
+
+	for (i = 0; i < s_info.group_cnt; i++)
+		groups = _list_append(groups, strdup(s_info.groups[i].name));
+
+	return groups;
+}
+
+void edje_file_collection_list_free(Eina_List *list)
+{
+	char *group = NULL;
+
+	EINA_LIST_FREE(list, group)
+		free(group);
+}
+
+/*
+ * Ecore
+ */
+
+double ecore_time_get(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + (ts.tv_nsec / 1000000000.0);
+}
+
+double ecore_loop_time_get(void)
+{
+	return ecore_time_get();
+}
+
+Ecore_Idler *ecore_idler_add(Ecore_Task_Cb func, const void *data)
+{
+	return _task_add(HOST_TASK_IDLER, func, data);
+}
+
+void *ecore_idler_del(Ecore_Idler *idler)
+{
+	return _task_del(idler);
+}
+
+Ecore_Idle_Exiter *ecore_idle_exiter_add(Ecore_Task_Cb func, const void *data)
+{
+	return _task_add(HOST_TASK_IDLE_EXITER, func, data);
+}
+
+void *ecore_idle_exiter_del(Ecore_Idle_Exiter *idle_exiter)
+{
+	return _task_del(idle_exiter);
+}
+
+Ecore_Timer *ecore_timer_add(double in, Ecore_Task_Cb func, const void *data)
+{
+	return _task_add(HOST_TASK_TIMER, func, data);
+}
+
+void *ecore_timer_del(Ecore_Timer *timer)
+{
+	return _task_del(timer);
+}
+
+Ecore_Animator *ecore_animator_add(Ecore_Task_Cb func, const void *data)
+{
+	return _task_add(HOST_TASK_ANIMATOR, func, data);
+}
+
+void *ecore_animator_del(Ecore_Animator *animator)
+{
+	return _task_del(animator);
+}
+
+double ecore_animator_frametime_get(void)
+{
+	return 1.0 / 60.0;
+}
+
+/*
+ * Ecore_Evas
+ */
+
+struct _Ecore_Evas {
+	Evas evas;
+	int w, h;
+	uint32_t *pixels;
+};
+
+Ecore_Evas *ecore_evas_buffer_new(int w, int h)
+{
+	Ecore_Evas *ee = NULL;
+
+	if (w <= 0 || h <= 0)
+		return NULL;
+
+	ee = calloc(1, sizeof(Ecore_Evas));
+	if (ee == NULL)
+		return NULL;
+
+	ee->w = w;
+	ee->h = h;
+
+	return ee;
+}
+
+Evas *ecore_evas_get(const Ecore_Evas *ee)
+{
+	return ee ? (Evas *)&ee->evas : NULL;
+}
+
+/**
+ * @brief Opaque black, the objects of the canvas are not drawn.
+ */
+const void *ecore_evas_buffer_pixels_get(Ecore_Evas *ee)
+{
+	int i = 0;
+
+	if (ee == NULL)
+		return NULL;
+
+	if (ee->pixels == NULL) {
+		ee->pixels = malloc(ee->w * ee->h * sizeof(uint32_t));
+		if (ee->pixels == NULL)
+			return NULL;
+	}
+
+	for (i = 0; i < ee->w * ee->h; i++)
+		ee->pixels[i] = 0xff000000;
+
+	return ee->pixels;
+}
+
+void ecore_evas_free(Ecore_Evas *ee)
+{
+	if (ee == NULL)
+		return;
+
+	while (ee->evas.bottom)
+		evas_object_del(ee->evas.bottom);
+
+	free(ee->pixels);
+	free(ee);
+}
+
+Ecore_Thread *ecore_thread_run(Ecore_Thread_Cb func_blocking, Ecore_Thread_Cb func_end, Ecore_Thread_Cb func_cancel, const void *data)
+{
+	host_task_s *task = _task_add(HOST_TASK_THREAD, NULL, data);
+
+	// As Ecore, a thread that fails to start is cancelled at once
+	if (task == NULL) {
+		if (func_cancel)
+			func_cancel((void *)data, NULL);
+		return NULL;
+	}
+
+	task->blocking = func_blocking;
+	task->end = func_end;
+	task->cancel = func_cancel;
+
+	return (Ecore_Thread *)task;
+}
+
+/**
+ * @brief Cancel a thread. Threads only run from host_run(), so it has not started.
+ */
+Eina_Bool ecore_thread_cancel(Ecore_Thread *thread)
+{
+	host_task_s task;
+
+	if (thread == NULL)
+		return EINA_FALSE;
+
+	task = *(host_task_s *)thread;
+	_task_del(thread);
+	if (task.cancel)
+		task.cancel((void *)task.data, thread);
+
+	return EINA_TRUE;
+}
+
+Ecore_Event_Handler *ecore_event_handler_add(int type, Ecore_Event_Handler_Cb func, const void *data)
+{
+	host_task_s *task = _task_add(HOST_TASK_EVENT_HANDLER, NULL, data);
+
+	if (task)
+		task->handler = func;
+
+	return (Ecore_Event_Handler *)task;
+}
+
+void *ecore_event_handler_del(Ecore_Event_Handler *event_handler)
+{
+	return _task_del(event_handler);
+}
+
+/*
+ * Elementary
+ */
+
+void elm_language_set(const char *lang)
+{
+}
+
+static Evas_Object *_widget_add(Evas_Object *parent, const char *type)
+{
+	Evas_Object *obj = NULL;
+
+	if (parent == NULL)
+		return NULL;
+
+	obj = _object_add(parent->evas, type, NULL);
+	if (obj)
+		obj->smart = true;
+
+	return obj;
+}
+
+Evas_Object *elm_bg_add(Evas_Object *parent)
+{
+	Evas_Object *obj = _widget_add(parent, "elm_bg");
+
+	if (obj)
+		obj->image = _internal_add(obj, "image");
+
+	return obj;
+}
+
+/**
+ * @brief Set the image of a bg. Like the real one, it fails on any other widget.
+ */
+Eina_Bool elm_bg_file_set(Evas_Object *obj, const char *file, const char *group)
+{
+	if (obj == NULL || strcmp(obj->type, "elm_bg"))
+		return EINA_FALSE;
+
+	evas_object_image_file_set(obj->image, file, group);
+
+	return obj->image->load_error == EVAS_LOAD_ERROR_NONE;
+}
+
+void elm_bg_option_set(Evas_Object *obj, Elm_Bg_Option option)
+{
+}
+
+Evas_Object *elm_image_add(Evas_Object *parent)
+{
+	Evas_Object *obj = _widget_add(parent, "elm_image");
+
+	if (obj)
+		obj->image = _internal_add(obj, "image");
+
+	return obj;
+}
+
+/**
+ * @brief Set the image of an image widget. It fails on any other widget.
+ */
+Eina_Bool elm_image_file_set(Evas_Object *obj, const char *file, const char *group)
+{
+	if (obj == NULL || strcmp(obj->type, "elm_image"))
+		return EINA_FALSE;
+
+	evas_object_image_file_set(obj->image, file, group);
+
+	return obj->image->load_error == EVAS_LOAD_ERROR_NONE;
+}
+
+Evas_Object *elm_layout_add(Evas_Object *parent)
+{
+	Evas_Object *obj = _widget_add(parent, "elm_layout");
+
+	if (obj) {
+		obj->edje = _internal_add(obj, "edje");
+		obj->edje->smart = true;
+	}
+
+	return obj;
+}
+
+/**
+ * @brief Load a group into a layout, with an image object per image part.
+ */
+Eina_Bool elm_layout_file_set(Evas_Object *obj, const char *file, const char *group)
+{
+	host_edc_group_s *edc_group = NULL;
+	Evas_Object *image = NULL;
+	char key[32] = { 0, };
+	int i = 0;
+
+	if (obj == NULL || obj->edje == NULL || file == NULL || group == NULL)
+		return EINA_FALSE;
+
+	if (access(file, R_OK) != 0 && s_info.edc_path[0] == '\0')
+		return EINA_FALSE;
+
+	edc_group = _edc_group_find(group);
+	if (edc_group == NULL)
+		return EINA_FALSE;
+
+	free(obj->edje->file);
+	free(obj->edje->key);
+	obj->edje->file = strdup(file);
+	obj->edje->key = strdup(group);
+
+	for (i = 0; i < edc_group->image_cnt; i++) {
+		image = _internal_add(obj->edje, "image");
+		if (image == NULL)
+			break;
+
+		snprintf(key, sizeof(key), "edje/images/%d", _edc_image_index(edc_group->images[i]));
+		evas_object_image_file_set(image, file, key);
+		_geometry_set(image, obj->x, obj->y, obj->w, obj->h);
+	}
+
+	return EINA_TRUE;
+}
+
+Evas_Object *elm_layout_edje_get(const Evas_Object *obj)
+{
+	return obj ? obj->edje : NULL;
+}
+
+void elm_layout_signal_callback_add(Evas_Object *obj, const char *emission, const char *source, Edje_Signal_Cb func, void *data)
+{
+}
+
+/**
+ * @brief Keep the text of a part, in the part table shared with swallows.
+ */
+void elm_object_part_text_set(Evas_Object *obj, const char *part, const char *text)
+{
+	int free_slot = -1;
+	int i = 0;
+
+	if (obj == NULL || part == NULL)
+		return;
+
+	for (i = 0; i < HOST_PART_MAX; i++) {
+		if (obj->parts[i].name && !strcmp(obj->parts[i].name, part))
+			break;
+		if (obj->parts[i].name == NULL && free_slot < 0)
+			free_slot = i;
+	}
+
+	if (i == HOST_PART_MAX) {
+		if (free_slot < 0)
+			return;
+		i = free_slot;
+		obj->parts[i].name = strdup(part);
+	}
+
+	free(obj->parts[i].text);
+	obj->parts[i].text = text ? strdup(text) : NULL;
+}
+
+/**
+ * @brief Swallow an object, which becomes a member of the layout's edje.
+ */
+void elm_object_part_content_set(Evas_Object *obj, const char *part, Evas_Object *content)
+{
+	int free_slot = -1;
+	int i = 0;
+
+	if (obj == NULL || obj->edje == NULL || part == NULL)
+		return;
+
+	for (i = 0; i < HOST_PART_MAX; i++) {
+		if (obj->parts[i].name && !strcmp(obj->parts[i].name, part)) {
+			if (obj->parts[i].content && obj->parts[i].content != content)
+				evas_object_del(obj->parts[i].content);
+			obj->parts[i].content = content;
+			break;
+		}
+		if (obj->parts[i].name == NULL && free_slot < 0)
+			free_slot = i;
+	}
+
+	if (i == HOST_PART_MAX) {
+		if (free_slot < 0)
+			return;
+		obj->parts[free_slot].name = strdup(part);
+		obj->parts[free_slot].content = content;
+	}
+
+	if (content)
+		content->smart_parent = obj->edje;
+}
+
+Evas_Object *elm_object_part_content_unset(Evas_Object *obj, const char *part)
+{
+	Evas_Object *content = NULL;
+	int i = 0;
+
+	if (obj == NULL || part == NULL)
+		return NULL;
+
+	for (i = 0; i < HOST_PART_MAX; i++) {
+		if (obj->parts[i].name && !strcmp(obj->parts[i].name, part)) {
+			content = obj->parts[i].content;
+			obj->parts[i].content = NULL;
+			break;
+		}
+	}
+
+	if (content)
+		content->smart_parent = NULL;
+
+	return content;
+}
+
+/*
+ * Tizen
+ */
+
+int dlog_print(log_priority prio, const char *tag, const char *fmt, ...)
+{
+	static const char *names[] = { "D", "I", "W", "E" };
+	va_list ap;
+
+	if (prio < s_info.log_level)
+		return 0;
+
+	fprintf(stderr, "%s/%s: ", (prio >= DLOG_DEBUG && prio <= DLOG_ERROR) ? names[prio - DLOG_DEBUG] : "?", tag);
+	va_start(ap, fmt);
+	vfprintf(stderr, fmt, ap);
+	va_end(ap);
+	fputc('\n', stderr);
+
+	return 0;
+}
+
+char *app_get_resource_path(void)
+{
+	return strdup(s_info.resource_path);
+}
+
+char *app_get_data_path(void)
+{
+	return strdup(s_info.data_path);
+}
+
+int app_control_get_extra_data(app_control_h app_control, const char *key, char **value)
+{
+	int i = 0;
+
+	if (app_control == NULL || key == NULL || value == NULL)
+		return APP_ERROR_INVALID_PARAMETER;
+
+	for (i = 0; i < app_control->count; i++) {
+		if (!strcmp(app_control->keys[i], key)) {
+			*value = strdup(app_control->values[i]);
+			return APP_CONTROL_ERROR_NONE;
+		}
+	}
+
+	return APP_CONTROL_ERROR_KEY_NOT_FOUND;
+}
+
+int system_settings_get_value_string(system_settings_key_e key, char **value)
+{
+	*value = strdup("en_US.UTF-8");
+
+	return 0;
+}
+
+int device_battery_get_percent(int *percent)
+{
+	*percent = s_info.battery_percent;
+
+	return 0;
+}
+
+int device_battery_is_charging(bool *charging)
+{
+	*charging = s_info.battery_charging;
+
+	return 0;
+}
+
+int watch_app_main(int argc, char **argv, watch_app_lifecycle_callback_s *callback, void *user_data)
+{
+	if (host_main == NULL)
+		return APP_ERROR_INVALID_PARAMETER;
+
+	return host_main(argc, argv, callback, user_data);
+}
+
+int watch_app_add_event_handler(app_event_handler_h *handler, app_event_type_e event_type, app_event_cb callback, void *user_data)
+{
+	*handler = NULL;
+
+	return APP_ERROR_NONE;
+}
+
+void watch_app_exit(void)
+{
+}
+
+/**
+ * @brief Get the window, made on the first call with no size. The app sizes it.
+ */
+int watch_app_get_elm_win(Evas_Object **win)
+{
+	if (s_info.win == NULL) {
+		s_info.win = _object_add(&s_info.evas, "elm_win", NULL);
+		if (s_info.win == NULL)
+			return APP_ERROR_INVALID_PARAMETER;
+		s_info.win->smart = true;
+	}
+
+	*win = s_info.win;
+
+	return APP_ERROR_NONE;
+}
+
+int watch_time_get_current_time(watch_time_h *watch_time)
+{
+	*watch_time = host_watch_time_new();
+
+	return *watch_time ? APP_ERROR_NONE : APP_ERROR_INVALID_PARAMETER;
+}
+
+int watch_time_delete(watch_time_h watch_time)
+{
+	free(watch_time);
+
+	return APP_ERROR_NONE;
+}
+
+int watch_time_get_year(watch_time_h watch_time, int *year)
+{
+	*year = watch_time->local.tm_year + 1900;
+
+	return APP_ERROR_NONE;
+}
+
+int watch_time_get_month(watch_time_h watch_time, int *month)
+{
+	*month = watch_time->local.tm_mon + 1;
+
+	return APP_ERROR_NONE;
+}
+
+int watch_time_get_day(watch_time_h watch_time, int *day)
+{
+	*day = watch_time->local.tm_mday;
+
+	return APP_ERROR_NONE;
+}
+
+/**
+ * @brief Sunday is 1, as on the watch.
+ */
+int watch_time_get_day_of_week(watch_time_h watch_time, int *day_of_week)
+{
+	*day_of_week = watch_time->local.tm_wday + 1;
+
+	return APP_ERROR_NONE;
+}
+
+/**
+ * @brief The hour in 12 hour format, 1 to 12, as on the watch.
+ */
+int watch_time_get_hour(watch_time_h watch_time, int *hour)
+{
+	*hour = watch_time->local.tm_hour % 12;
+	if (*hour == 0)
+		*hour = 12;
+
+	return APP_ERROR_NONE;
+}
+
+int watch_time_get_hour24(watch_time_h watch_time, int *hour24)
+{
+	*hour24 = watch_time->local.tm_hour;
+
+	return APP_ERROR_NONE;
+}
+
+int watch_time_get_minute(watch_time_h watch_time, int *minute)
+{
+	*minute = watch_time->local.tm_min;
+
+	return APP_ERROR_NONE;
+}
+
+int watch_time_get_second(watch_time_h watch_time, int *second)
+{
+	*second = watch_time->local.tm_sec;
+
+	return APP_ERROR_NONE;
+}
+
+int watch_time_get_utc_time(watch_time_h watch_time, struct tm *utc_time)
+{
+	return gmtime_r(&watch_time->utc, utc_time) ? APP_ERROR_NONE : APP_ERROR_INVALID_PARAMETER;
+}
+
+int watch_time_get_utc_timestamp(watch_time_h watch_time, time_t *utc_timestamp)
+{
+	*utc_timestamp = watch_time->utc;
+
+	return APP_ERROR_NONE;
+}
+
+int watch_time_get_dst_status(watch_time_h watch_time, bool *status)
+{
+	*status = watch_time->local.tm_isdst > 0;
+
+	return APP_ERROR_NONE;
+}
+
+/* Eet */
+
+typedef struct {
+	char *name;
+	void *data;
+	int size;
+} host_eet_entry_s;
+
+struct _Eet_File {
+	char *path;
+	Eet_File_Mode mode;
+	host_eet_entry_s entries[HOST_EET_ENTRY_MAX];
+	int count;
+};
+
+typedef struct {
+	uint32_t w;
+	uint32_t h;
+	int32_t alpha;
+} host_eet_image_s;
+
+static bool _eet_entry_add(Eet_File *ef, const char *name, const void *data, int size)
+{
+	host_eet_entry_s *entry = NULL;
+
+	if (ef->count >= HOST_EET_ENTRY_MAX || size < 0)
+		return false;
+
+	entry = &ef->entries[ef->count];
+	entry->name = strdup(name);
+	entry->data = malloc(size > 0 ? size : 1);
+	if (entry->name == NULL || entry->data == NULL) {
+		free(entry->name);
+		free(entry->data);
+		return false;
+	}
+
+	memcpy(entry->data, data, size);
+	entry->size = size;
+	ef->count++;
+
+	return true;
+}
+
+static host_eet_entry_s *_eet_entry_find(Eet_File *ef, const char *name)
+{
+	int i = 0;
+
+	for (i = 0; ef && i < ef->count; i++) {
+		if (!strcmp(ef->entries[i].name, name))
+			return &ef->entries[i];
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Read all entries of a file: magic, then name length, name, size and data for each.
+ */
+static bool _eet_load(Eet_File *ef)
+{
+	char name[HOST_EDC_NAME_MAX] = { 0, };
+	FILE *fp = fopen(ef->path, "rb");
+	uint32_t magic = 0;
+	uint32_t len = 0;
+	int32_t size = 0;
+	void *data = NULL;
+	bool ok = false;
+
+	if (fp == NULL)
+		return false;
+
+	if (fread(&magic, sizeof(magic), 1, fp) != 1 || magic != HOST_EET_MAGIC) {
+		fclose(fp);
+		return false;
+	}
+
+	while (fread(&len, sizeof(len), 1, fp) == 1) {
+		ok = len < sizeof(name) && fread(name, 1, len, fp) == len && fread(&size, sizeof(size), 1, fp) == 1 && size >= 0;
+		data = ok ? malloc(size > 0 ? size : 1) : NULL;
+		ok = data && fread(data, 1, size, fp) == (size_t)size;
+		if (ok) {
+			name[len] = '\0';
+			ok = _eet_entry_add(ef, name, data, size);
+		}
+		free(data);
+		if (!ok)
+			break;
+	}
+
+	fclose(fp);
+
+	return ok || ef->count > 0;
+}
+
+Eet_File *eet_open(const char *file, Eet_File_Mode mode)
+{
+	Eet_File *ef = NULL;
+
+	if (file == NULL || (mode != EET_FILE_MODE_READ && mode != EET_FILE_MODE_WRITE))
+		return NULL;
+
+	ef = calloc(1, sizeof(Eet_File));
+	if (ef == NULL)
+		return NULL;
+
+	ef->path = strdup(file);
+	ef->mode = mode;
+
+	if (ef->path == NULL || (mode == EET_FILE_MODE_READ && !_eet_load(ef))) {
+		eet_close(ef);
+		return NULL;
+	}
+
+	return ef;
+}
+
+Eet_Error eet_close(Eet_File *ef)
+{
+	Eet_Error error = EET_ERROR_NONE;
+	FILE *fp = NULL;
+	uint32_t magic = HOST_EET_MAGIC;
+	uint32_t len = 0;
+	int32_t size = 0;
+	int i = 0;
+
+	if (ef == NULL)
+		return EET_ERROR_BAD_OBJECT;
+
+	if (ef->mode == EET_FILE_MODE_WRITE && ef->path) {
+		fp = fopen(ef->path, "wb");
+		if (fp == NULL || fwrite(&magic, sizeof(magic), 1, fp) != 1)
+			error = EET_ERROR_WRITE_ERROR;
+
+		for (i = 0; error == EET_ERROR_NONE && i < ef->count; i++) {
+			len = strlen(ef->entries[i].name);
+			size = ef->entries[i].size;
+			if (fwrite(&len, sizeof(len), 1, fp) != 1 || fwrite(ef->entries[i].name, 1, len, fp) != len
+					|| fwrite(&size, sizeof(size), 1, fp) != 1 || fwrite(ef->entries[i].data, 1, size, fp) != (size_t)size)
+				error = EET_ERROR_WRITE_ERROR;
+		}
+
+		if (fp && fclose(fp) != 0)
+			error = EET_ERROR_WRITE_ERROR;
+	}
+
+	for (i = 0; i < ef->count; i++) {
+		free(ef->entries[i].name);
+		free(ef->entries[i].data);
+	}
+	free(ef->path);
+	free(ef);
+
+	return error;
+}
+
+void *eet_read(Eet_File *ef, const char *name, int *size_ret)
+{
+	host_eet_entry_s *entry = _eet_entry_find(ef, name);
+	void *data = NULL;
+
+	if (size_ret)
+		*size_ret = 0;
+
+	if (entry == NULL)
+		return NULL;
+
+	data = malloc(entry->size > 0 ? entry->size : 1);
+	if (data == NULL)
+		return NULL;
+
+	memcpy(data, entry->data, entry->size);
+	if (size_ret)
+		*size_ret = entry->size;
+
+	return data;
+}
+
+int eet_write(Eet_File *ef, const char *name, const void *data, int size, int compress)
+{
+	if (ef == NULL || ef->mode != EET_FILE_MODE_WRITE || name == NULL || _eet_entry_find(ef, name))
+		return 0;
+
+	return _eet_entry_add(ef, name, data, size) ? size : 0;
+}
+
+int eet_data_image_write(Eet_File *ef, const char *name, const void *data, unsigned int w, unsigned int h, int alpha, int compress,
+		int quality, int lossy)
+{
+	host_eet_image_s header = { w, h, alpha };
+	size_t size = sizeof(header) + ((size_t)w * h * sizeof(uint32_t));
+	uint8_t *image = NULL;
+	int written = 0;
+
+	if (data == NULL || size > INT_MAX)
+		return 0;
+
+	image = malloc(size);
+	if (image == NULL)
+		return 0;
+
+	memcpy(image, &header, sizeof(header));
+	memcpy(image + sizeof(header), data, size - sizeof(header));
+	written = eet_write(ef, name, image, size, compress);
+	free(image);
+
+	return written;
+}
+
+int eet_data_image_header_read(Eet_File *ef, const char *name, unsigned int *w, unsigned int *h, int *alpha, int *compress,
+		int *quality, int *lossy)
+{
+	host_eet_entry_s *entry = _eet_entry_find(ef, name);
+	host_eet_image_s header = { 0, };
+
+	if (entry == NULL || entry->size < (int)sizeof(header))
+		return 0;
+
+	memcpy(&header, entry->data, sizeof(header));
+	if (w)
+		*w = header.w;
+	if (h)
+		*h = header.h;
+	if (alpha)
+		*alpha = header.alpha;
+	if (compress)
+		*compress = 0;
+	if (quality)
+		*quality = 100;
+	if (lossy)
+		*lossy = 0;
+
+	return 1;
+}
+
+/**
+ * @brief Size an image stored in an Eet file, as Evas loads it with a key.
+ */
+static void _eet_image_size(const char *path, const char *key, int *w, int *h, Evas_Load_Error *error)
+{
+	Eet_File *ef = eet_open(path, EET_FILE_MODE_READ);
+	unsigned int image_w = 0, image_h = 0;
+
+	if (ef == NULL) {
+		*error = EVAS_LOAD_ERROR_GENERIC;
+		return;
+	}
+
+	if (eet_data_image_header_read(ef, key, &image_w, &image_h, NULL, NULL, NULL, NULL)) {
+		*w = image_w;
+		*h = image_h;
+	} else {
+		*error = EVAS_LOAD_ERROR_DOES_NOT_EXIST;
+	}
+
+	eet_close(ef);
+}
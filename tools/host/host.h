@@ -0,0 +1,44 @@
+#if !defined(_HOST_H)
+#define _HOST_H
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <time.h>
+
+#include <dlog.h>
+#include <watch_app.h>
+
+/*
+ * Host side of the EFL and Tizen stubs in efl_stub.c. A tool links the
+ * face sources with the stubs, and drives the app through its lifecycle
+ * callbacks from host_main(), which the stubbed watch_app_main() calls.
+ *
+ * The stub canvas keeps the object tree, geometry, names, data, image
+ * files, colours and maps, and sizes images from their PNG headers. It
+ * draws nothing, but host_dump_canvas() writes what it would draw.
+ * Edje groups are read from the EDC source instead of a compiled EDJ.
+ */
+
+/*
+ * Implemented by a tool that runs the app, called from watch_app_main().
+ * A tool that only links some modules has its own main() instead.
+ */
+int host_main(int argc, char *argv[], watch_app_lifecycle_callback_s *callback, void *user_data) __attribute__((weak));
+
+void host_set_resource_path(const char *dir);
+void host_set_data_path(const char *dir);
+void host_set_edje_source(const char *edc_path, const char *images_dir);
+void host_set_battery(int percent, bool charging);
+void host_set_time(time_t now);
+void host_set_log_level(log_priority prio);
+
+watch_time_h host_watch_time_new(void);
+app_control_h host_app_control_new(void);
+void host_app_control_add_extra(app_control_h app_control, const char *key, const char *value);
+void host_app_control_free(app_control_h app_control);
+
+void host_render(void);
+int host_run(int max_iterations);
+void host_dump_canvas(FILE *fp);
+
+#endif
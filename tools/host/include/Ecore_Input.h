@@ -0,0 +1,13 @@
+#if !defined(_HOST_ECORE_INPUT_H)
+#define _HOST_ECORE_INPUT_H
+
+typedef struct {
+	int buttons;
+	int x;
+	int y;
+} Ecore_Event_Mouse_Button;
+
+extern int ECORE_EVENT_MOUSE_BUTTON_DOWN;
+extern int ECORE_EVENT_MOUSE_BUTTON_UP;
+
+#endif
@@ -0,0 +1,33 @@
+#if !defined(_HOST_EET_H)
+#define _HOST_EET_H
+
+/*
+ * The part of the Eet API the face calls, for host builds of the tools.
+ * See tools/host/efl_stub.c, the files are not in the Eet format.
+ */
+
+typedef struct _Eet_File Eet_File;
+
+typedef enum {
+	EET_FILE_MODE_INVALID = -1,
+	EET_FILE_MODE_READ,
+	EET_FILE_MODE_WRITE,
+	EET_FILE_MODE_READ_WRITE,
+} Eet_File_Mode;
+
+typedef enum {
+	EET_ERROR_NONE,
+	EET_ERROR_BAD_OBJECT,
+	EET_ERROR_WRITE_ERROR,
+} Eet_Error;
+
+Eet_File *eet_open(const char *file, Eet_File_Mode mode);
+Eet_Error eet_close(Eet_File *ef);
+void *eet_read(Eet_File *ef, const char *name, int *size_ret);
+int eet_write(Eet_File *ef, const char *name, const void *data, int size, int compress);
+int eet_data_image_write(Eet_File *ef, const char *name, const void *data, unsigned int w, unsigned int h, int alpha, int compress,
+		int quality, int lossy);
+int eet_data_image_header_read(Eet_File *ef, const char *name, unsigned int *w, unsigned int *h, int *alpha, int *compress,
+		int *quality, int *lossy);
+
+#endif
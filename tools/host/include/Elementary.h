@@ -0,0 +1,250 @@
+#if !defined(_HOST_ELEMENTARY_H)
+#define _HOST_ELEMENTARY_H
+
+/*
+ * The part of the Elementary, Evas, Edje, Ecore and Eina APIs the face
+ * calls, for host builds of the tools. See tools/host/efl_stub.c.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <time.h>
+#include <math.h>
+#include <stdint.h>
+
+/* Eina */
+typedef unsigned char Eina_Bool;
+#define EINA_TRUE 1
+#define EINA_FALSE 0
+
+typedef struct _Eina_List Eina_List;
+
+void *eina_list_data_get(const Eina_List *list);
+Eina_List *eina_list_next(const Eina_List *list);
+Eina_List *eina_list_remove_list(Eina_List *list, Eina_List *remove_list);
+
+#define EINA_LIST_FOREACH(list, l, data) \
+	for (l = list, data = eina_list_data_get(l); l; l = eina_list_next(l), data = eina_list_data_get(l))
+#define EINA_LIST_FREE(list, data) \
+	for (data = eina_list_data_get(list); list; list = eina_list_remove_list(list, list), data = eina_list_data_get(list))
+
+/* Evas */
+typedef int Evas_Coord;
+typedef int Evas_Font_Size;
+typedef struct _Evas Evas;
+typedef struct _Evas_Object Evas_Object;
+typedef struct _Evas_Map Evas_Map;
+typedef struct _Evas_Smart Evas_Smart;
+
+#define EVAS_HINT_EXPAND 1.0
+#define EVAS_LAYER_MAX 32767
+
+typedef enum {
+	EVAS_CALLBACK_MOUSE_DOWN,
+	EVAS_CALLBACK_MOUSE_UP,
+	EVAS_CALLBACK_DEL,
+	EVAS_CALLBACK_IMAGE_PRELOADED,
+	EVAS_CALLBACK_RENDER_POST,
+	EVAS_CALLBACK_LAST,
+} Evas_Callback_Type;
+
+typedef enum {
+	EVAS_COLORSPACE_ARGB8888,
+	EVAS_COLORSPACE_RGB565_A5P,
+	EVAS_COLORSPACE_GRY8,
+	EVAS_COLORSPACE_AGRY88,
+} Evas_Colorspace;
+
+typedef enum {
+	EVAS_LOAD_ERROR_NONE = 0,
+	EVAS_LOAD_ERROR_GENERIC,
+	EVAS_LOAD_ERROR_DOES_NOT_EXIST,
+} Evas_Load_Error;
+typedef enum {
+	EVAS_BORDER_FILL_NONE = 0,
+	EVAS_BORDER_FILL_DEFAULT = 1,
+	EVAS_BORDER_FILL_SOLID = 2,
+} Evas_Border_Fill_Mode;
+
+typedef enum {
+	EVAS_TEXT_STYLE_PLAIN,
+	EVAS_TEXT_STYLE_SHADOW,
+	EVAS_TEXT_STYLE_OUTLINE,
+} Evas_Text_Style_Type;
+
+typedef void (*Evas_Object_Event_Cb)(void *data, Evas *e, Evas_Object *obj, void *event_info);
+typedef void (*Evas_Event_Cb)(void *data, Evas *e, void *event_info);
+
+void evas_event_callback_add(Evas *e, Evas_Callback_Type type, Evas_Event_Cb func, const void *data);
+void *evas_event_callback_del(Evas *e, Evas_Callback_Type type, Evas_Event_Cb func);
+void evas_event_freeze(Evas *e);
+void evas_event_thaw(Evas *e);
+
+Evas *evas_object_evas_get(const Evas_Object *obj);
+const char *evas_object_type_get(const Evas_Object *obj);
+void evas_object_name_set(Evas_Object *obj, const char *name);
+const char *evas_object_name_get(const Evas_Object *obj);
+void evas_object_del(Evas_Object *obj);
+void evas_object_move(Evas_Object *obj, Evas_Coord x, Evas_Coord y);
+void evas_object_resize(Evas_Object *obj, Evas_Coord w, Evas_Coord h);
+void evas_object_geometry_get(const Evas_Object *obj, Evas_Coord *x, Evas_Coord *y, Evas_Coord *w, Evas_Coord *h);
+void evas_object_show(Evas_Object *obj);
+void evas_object_hide(Evas_Object *obj);
+Eina_Bool evas_object_visible_get(const Evas_Object *obj);
+void evas_object_color_set(Evas_Object *obj, int r, int g, int b, int a);
+void evas_object_color_get(const Evas_Object *obj, int *r, int *g, int *b, int *a);
+void evas_object_clip_set(Evas_Object *obj, Evas_Object *clip);
+Evas_Object *evas_object_clip_get(const Evas_Object *obj);
+Eina_Bool evas_object_clipees_has(const Evas_Object *obj);
+void evas_object_layer_set(Evas_Object *obj, short layer);
+void evas_object_stack_below(Evas_Object *obj, Evas_Object *below);
+void evas_object_size_hint_weight_set(Evas_Object *obj, double x, double y);
+void evas_object_data_set(Evas_Object *obj, const char *key, const void *data);
+void *evas_object_data_get(const Evas_Object *obj, const char *key);
+void *evas_object_data_del(Evas_Object *obj, const char *key);
+void evas_object_event_callback_add(Evas_Object *obj, Evas_Callback_Type type, Evas_Object_Event_Cb func, const void *data);
+void *evas_object_event_callback_del(Evas_Object *obj, Evas_Callback_Type type, Evas_Object_Event_Cb func);
+Evas_Object *evas_object_bottom_get(const Evas *e);
+Evas_Object *evas_object_above_get(const Evas_Object *obj);
+Evas_Smart *evas_object_smart_smart_get(const Evas_Object *obj);
+Evas_Object *evas_object_smart_parent_get(const Evas_Object *obj);
+Eina_List *evas_object_smart_members_get(const Evas_Object *obj);
+
+Evas_Object *evas_object_rectangle_add(Evas *e);
+Evas_Object *evas_object_image_add(Evas *e);
+Evas_Object *evas_object_image_filled_add(Evas *e);
+void evas_object_image_file_set(Evas_Object *obj, const char *file, const char *key);
+void evas_object_image_file_get(const Evas_Object *obj, const char **file, const char **key);
+Evas_Load_Error evas_object_image_load_error_get(const Evas_Object *obj);
+void evas_object_image_size_get(const Evas_Object *obj, int *w, int *h);
+int evas_object_image_stride_get(const Evas_Object *obj);
+Evas_Colorspace evas_object_image_colorspace_get(const Evas_Object *obj);
+void evas_object_image_preload(Evas_Object *obj, Eina_Bool cancel);
+void evas_object_image_source_set(Evas_Object *obj, Evas_Object *src);
+Eina_Bool evas_object_image_save(const Evas_Object *obj, const char *file, const char *key, const char *flags);
+void *evas_object_image_data_get(const Evas_Object *obj, Eina_Bool for_writing);
+void evas_object_image_fill_set(Evas_Object *obj, Evas_Coord x, Evas_Coord y, Evas_Coord w, Evas_Coord h);
+void evas_object_image_fill_get(const Evas_Object *obj, Evas_Coord *x, Evas_Coord *y, Evas_Coord *w, Evas_Coord *h);
+void evas_object_image_border_set(Evas_Object *obj, int l, int r, int t, int b);
+void evas_object_image_border_get(const Evas_Object *obj, int *l, int *r, int *t, int *b);
+void evas_object_image_border_center_fill_set(Evas_Object *obj, Evas_Border_Fill_Mode fill);
+Evas_Border_Fill_Mode evas_object_image_border_center_fill_get(const Evas_Object *obj);
+void evas_object_image_smooth_scale_set(Evas_Object *obj, Eina_Bool smooth_scale);
+Eina_Bool evas_object_image_smooth_scale_get(const Evas_Object *obj);
+
+Evas_Object *evas_object_text_add(Evas *e);
+void evas_object_text_text_set(Evas_Object *obj, const char *text);
+const char *evas_object_text_text_get(const Evas_Object *obj);
+void evas_object_text_font_set(Evas_Object *obj, const char *font, Evas_Font_Size size);
+void evas_object_text_font_get(const Evas_Object *obj, const char **font, Evas_Font_Size *size);
+void evas_object_text_font_source_set(Evas_Object *obj, const char *font_source);
+const char *evas_object_text_font_source_get(const Evas_Object *obj);
+void evas_object_text_style_set(Evas_Object *obj, Evas_Text_Style_Type type);
+Evas_Text_Style_Type evas_object_text_style_get(const Evas_Object *obj);
+
+Evas_Map *evas_map_new(int count);
+void evas_map_free(Evas_Map *m);
+void evas_map_util_points_populate_from_object(Evas_Map *m, const Evas_Object *obj);
+void evas_map_util_rotate(Evas_Map *m, double degrees, Evas_Coord cx, Evas_Coord cy);
+void evas_map_point_coord_set(Evas_Map *m, int idx, Evas_Coord x, Evas_Coord y, Evas_Coord z);
+void evas_map_point_image_uv_set(Evas_Map *m, int idx, double u, double v);
+void evas_map_point_coord_get(const Evas_Map *m, int idx, Evas_Coord *x, Evas_Coord *y, Evas_Coord *z);
+void evas_map_point_image_uv_get(const Evas_Map *m, int idx, double *u, double *v);
+void evas_map_smooth_set(Evas_Map *m, Eina_Bool enabled);
+void evas_object_map_set(Evas_Object *obj, const Evas_Map *map);
+const Evas_Map *evas_object_map_get(const Evas_Object *obj);
+void evas_object_map_enable_set(Evas_Object *obj, Eina_Bool enabled);
+Eina_Bool evas_object_map_enable_get(const Evas_Object *obj);
+
+/* Edje */
+typedef enum {
+	EDJE_MESSAGE_NONE = 0,
+	EDJE_MESSAGE_INT = 5,
+	EDJE_MESSAGE_INT_SET = 7,
+	EDJE_MESSAGE_FLOAT_SET = 8,
+} Edje_Message_Type;
+
+typedef struct {
+	int count;
+	int val[1];
+} Edje_Message_Int_Set;
+
+typedef void (*Edje_Signal_Cb)(void *data, Evas_Object *obj, const char *emission, const char *source);
+
+void edje_object_message_send(Evas_Object *obj, Edje_Message_Type type, int id, void *msg);
+Eina_Bool edje_object_color_class_set(Evas_Object *obj, const char *color_class, int r, int g, int b, int a,
+		int r2, int g2, int b2, int a2, int r3, int g3, int b3, int a3);
+void edje_object_signal_emit(Evas_Object *obj, const char *emission, const char *source);
+void edje_object_scale_set(Evas_Object *obj, double scale);
+Eina_Bool edje_object_file_get(const Evas_Object *obj, const char **file, const char **group);
+Eina_List *edje_file_collection_list(const char *file);
+void edje_file_collection_list_free(Eina_List *list);
+
+/* Ecore */
+typedef struct _Ecore_Idler Ecore_Idler;
+typedef struct _Ecore_Idle_Exiter Ecore_Idle_Exiter;
+typedef struct _Ecore_Timer Ecore_Timer;
+typedef struct _Ecore_Animator Ecore_Animator;
+typedef struct _Ecore_Thread Ecore_Thread;
+typedef struct _Ecore_Event_Handler Ecore_Event_Handler;
+
+#define ECORE_CALLBACK_CANCEL EINA_FALSE
+#define ECORE_CALLBACK_RENEW EINA_TRUE
+#define ECORE_CALLBACK_PASS_ON EINA_TRUE
+#define ECORE_CALLBACK_DONE EINA_FALSE
+
+typedef Eina_Bool (*Ecore_Task_Cb)(void *data);
+typedef void (*Ecore_Thread_Cb)(void *data, Ecore_Thread *thread);
+typedef Eina_Bool (*Ecore_Event_Handler_Cb)(void *data, int type, void *event);
+
+double ecore_time_get(void);
+double ecore_loop_time_get(void);
+Ecore_Idler *ecore_idler_add(Ecore_Task_Cb func, const void *data);
+void *ecore_idler_del(Ecore_Idler *idler);
+Ecore_Idle_Exiter *ecore_idle_exiter_add(Ecore_Task_Cb func, const void *data);
+void *ecore_idle_exiter_del(Ecore_Idle_Exiter *idle_exiter);
+Ecore_Timer *ecore_timer_add(double in, Ecore_Task_Cb func, const void *data);
+void *ecore_timer_del(Ecore_Timer *timer);
+Ecore_Animator *ecore_animator_add(Ecore_Task_Cb func, const void *data);
+void *ecore_animator_del(Ecore_Animator *animator);
+double ecore_animator_frametime_get(void);
+Ecore_Thread *ecore_thread_run(Ecore_Thread_Cb func_blocking, Ecore_Thread_Cb func_end, Ecore_Thread_Cb func_cancel, const void *data);
+Eina_Bool ecore_thread_cancel(Ecore_Thread *thread);
+Ecore_Event_Handler *ecore_event_handler_add(int type, Ecore_Event_Handler_Cb func, const void *data);
+void *ecore_event_handler_del(Ecore_Event_Handler *event_handler);
+
+/* Ecore_Evas */
+typedef struct _Ecore_Evas Ecore_Evas;
+
+Ecore_Evas *ecore_evas_buffer_new(int w, int h);
+Evas *ecore_evas_get(const Ecore_Evas *ee);
+const void *ecore_evas_buffer_pixels_get(Ecore_Evas *ee);
+void ecore_evas_free(Ecore_Evas *ee);
+
+/* Elementary */
+typedef enum {
+	ELM_BG_OPTION_CENTER,
+	ELM_BG_OPTION_SCALE,
+	ELM_BG_OPTION_STRETCH,
+	ELM_BG_OPTION_TILE,
+} Elm_Bg_Option;
+
+void elm_language_set(const char *lang);
+Evas_Object *elm_bg_add(Evas_Object *parent);
+Eina_Bool elm_bg_file_set(Evas_Object *obj, const char *file, const char *group);
+void elm_bg_option_set(Evas_Object *obj, Elm_Bg_Option option);
+Evas_Object *elm_image_add(Evas_Object *parent);
+Eina_Bool elm_image_file_set(Evas_Object *obj, const char *file, const char *group);
+Evas_Object *elm_layout_add(Evas_Object *parent);
+Eina_Bool elm_layout_file_set(Evas_Object *obj, const char *file, const char *group);
+Evas_Object *elm_layout_edje_get(const Evas_Object *obj);
+void elm_layout_signal_callback_add(Evas_Object *obj, const char *emission, const char *source, Edje_Signal_Cb func, void *data);
+void elm_object_part_text_set(Evas_Object *obj, const char *part, const char *text);
+void elm_object_part_content_set(Evas_Object *obj, const char *part, Evas_Object *content);
+Evas_Object *elm_object_part_content_unset(Evas_Object *obj, const char *part);
+
+#endif
@@ -0,0 +1,27 @@
+#if !defined(_HOST_APP_H)
+#define _HOST_APP_H
+
+#include <app_common.h>
+
+#define APP_ERROR_NONE 0
+#define APP_ERROR_INVALID_PARAMETER -22
+#define APP_CONTROL_ERROR_NONE 0
+#define APP_CONTROL_ERROR_KEY_NOT_FOUND -126
+
+typedef struct _app_event_info *app_event_info_h;
+typedef struct _app_event_handler *app_event_handler_h;
+typedef struct _app_control *app_control_h;
+
+typedef enum {
+	APP_EVENT_LOW_MEMORY,
+	APP_EVENT_LOW_BATTERY,
+	APP_EVENT_LANGUAGE_CHANGED,
+	APP_EVENT_DEVICE_ORIENTATION_CHANGED,
+	APP_EVENT_REGION_FORMAT_CHANGED,
+} app_event_type_e;
+
+typedef void (*app_event_cb)(app_event_info_h event_info, void *user_data);
+
+int app_control_get_extra_data(app_control_h app_control, const char *key, char **value);
+
+#endif
@@ -0,0 +1,7 @@
+#if !defined(_HOST_APP_COMMON_H)
+#define _HOST_APP_COMMON_H
+
+char *app_get_resource_path(void);
+char *app_get_data_path(void);
+
+#endif
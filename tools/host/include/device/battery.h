@@ -0,0 +1,9 @@
+#if !defined(_HOST_DEVICE_BATTERY_H)
+#define _HOST_DEVICE_BATTERY_H
+
+#include <stdbool.h>
+
+int device_battery_get_percent(int *percent);
+int device_battery_is_charging(bool *charging);
+
+#endif
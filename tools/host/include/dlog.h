@@ -0,0 +1,13 @@
+#if !defined(_HOST_DLOG_H)
+#define _HOST_DLOG_H
+
+typedef enum {
+	DLOG_DEBUG = 3,
+	DLOG_INFO,
+	DLOG_WARN,
+	DLOG_ERROR,
+} log_priority;
+
+int dlog_print(log_priority prio, const char *tag, const char *fmt, ...) __attribute__((format(printf, 3, 4)));
+
+#endif
@@ -0,0 +1,6 @@
+#if !defined(_HOST_EFL_EXTENSION_H)
+#define _HOST_EFL_EXTENSION_H
+
+/* Nothing the face calls, see Elementary.h */
+
+#endif
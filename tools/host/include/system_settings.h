@@ -0,0 +1,10 @@
+#if !defined(_HOST_SYSTEM_SETTINGS_H)
+#define _HOST_SYSTEM_SETTINGS_H
+
+typedef enum {
+	SYSTEM_SETTINGS_KEY_LOCALE_LANGUAGE,
+} system_settings_key_e;
+
+int system_settings_get_value_string(system_settings_key_e key, char **value);
+
+#endif
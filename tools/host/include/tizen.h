@@ -0,0 +1,6 @@
+#if !defined(_HOST_TIZEN_H)
+#define _HOST_TIZEN_H
+
+/* Nothing the face calls, see Elementary.h */
+
+#endif
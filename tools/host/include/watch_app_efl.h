@@ -0,0 +1,6 @@
+#if !defined(_HOST_WATCH_APP_EFL_H)
+#define _HOST_WATCH_APP_EFL_H
+
+/* Nothing the face calls, see Elementary.h */
+
+#endif
@@ -0,0 +1,199 @@
+/*
+ * Report the memory the watch face takes, offline.
+ *
+ * Runs the face itself, main.c and src/, on the EFL stubs of tools/host:
+ * the app is created at the 360px base size, draws its first frame and
+ * lets its idlers and background preloads finish, then gets the same
+ * MEMREPORT_KEY launch request as on the watch, so memreport_efl.c walks
+ * the canvas the face built. The stubs size images from their PNG
+ * headers as decoded ARGB, and read the Edje groups from main.edc.
+ *
+ * With -m, the exit status is 1 if the total is over the budget, so an
+ * asset change can be checked for what it costs.
+ *
+ * Usage: mem_report [-a] [-l] [-v] [-w tier] [-m max_kib] [-o out_file] res_dir edje_images_dir
+ *   -a  ambient mode
+ *   -l  low battery
+ *   -v  print the log of the face
+ *   -w  shadow tier: off, hard or soft (default is the face's own, hard on low battery)
+ *   -m  memory budget in KiB
+ *   -o  write the report to a file instead of stdout
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "host.h"
+#include "look.h"
+#include "memreport.h"
+#include "settings.h"
+
+#define REPORT_FILE "mem_report.txt"
+#define LOOP_MAX 1000
+
+#define USAGE "usage: %s [-a] [-l] [-v] [-w tier] [-m max_kib] [-o out_file] res_dir edje_images_dir\n"
+
+/**
+ * @brief Send a launch request with one extra.
+ */
+static void _app_control(watch_app_lifecycle_callback_s *callback, const char *key, const char *value)
+{
+	app_control_h app_control = host_app_control_new();
+
+	if (app_control == NULL)
+		return;
+
+	host_app_control_add_extra(app_control, key, value);
+	callback->app_control(app_control, NULL);
+	host_app_control_free(app_control);
+}
+
+/**
+ * @brief Tick the face and let it settle.
+ */
+static void _tick(watch_app_lifecycle_callback_s *callback, bool ambient)
+{
+	watch_time_h watch_time = host_watch_time_new();
+
+	if (ambient)
+		callback->ambient_tick(watch_time, NULL);
+	else
+		callback->time_tick(watch_time, NULL);
+
+	watch_time_delete(watch_time);
+
+	host_render();
+	host_run(LOOP_MAX);
+}
+
+/**
+ * @brief Copy the report the face wrote to a file, or to stdout.
+ */
+static bool _copy_report(const char *report_path, const char *out_file)
+{
+	char line[MEMREPORT_NAME_MAX * 4] = { 0, };
+	FILE *in = fopen(report_path, "r");
+	FILE *out = stdout;
+
+	if (in == NULL) {
+		fprintf(stderr, "the face wrote no report\n");
+		return false;
+	}
+
+	if (out_file) {
+		out = fopen(out_file, "w");
+		if (out == NULL) {
+			fprintf(stderr, "failed to write %s\n", out_file);
+			fclose(in);
+			return false;
+		}
+	}
+
+	while (fgets(line, sizeof(line), in))
+		fputs(line, out);
+
+	fclose(in);
+	if (out != stdout)
+		fclose(out);
+
+	return true;
+}
+
+int host_main(int argc, char *argv[], watch_app_lifecycle_callback_s *callback, void *user_data)
+{
+	char data_dir[] = "/tmp/mem_report.XXXXXX";
+	char path[PATH_MAX] = { 0, };
+	const char *out_file = NULL;
+	const char *shadows = NULL;
+	bool ambient = false;
+	bool low_battery = false;
+	long budget = -1;
+	bool ok = true;
+	int opt = 0;
+
+	host_set_log_level(DLOG_ERROR);
+
+	while ((opt = getopt(argc, argv, "alvw:m:o:")) != -1) {
+		switch (opt) {
+		case 'a':
+			ambient = true;
+			break;
+		case 'l':
+			low_battery = true;
+			break;
+		case 'v':
+			host_set_log_level(DLOG_DEBUG);
+			break;
+		case 'w':
+			if (strcmp(optarg, "off") && strcmp(optarg, "hard") && strcmp(optarg, "soft")) {
+				fprintf(stderr, "unknown shadow tier %s\n", optarg);
+				return 1;
+			}
+			shadows = optarg;
+			break;
+		case 'm':
+			budget = atol(optarg);
+			break;
+		case 'o':
+			out_file = optarg;
+			break;
+		default:
+			fprintf(stderr, USAGE, argv[0]);
+			return 1;
+		}
+	}
+
+	if (argc - optind != 2) {
+		fprintf(stderr, USAGE, argv[0]);
+		return 1;
+	}
+
+	// The face saves its settings and snapshot there, start from nothing
+	if (mkdtemp(data_dir) == NULL) {
+		perror("mkdtemp");
+		return 1;
+	}
+
+	host_set_resource_path(argv[optind]);
+	host_set_data_path(data_dir);
+	snprintf(path, sizeof(path), "%s/edje/main.edc", argv[optind]);
+	host_set_edje_source(path, argv[optind + 1]);
+	host_set_battery(low_battery ? 5 : 80, false);
+
+	if (!callback->create(BASE_WIDTH, BASE_HEIGHT, user_data)) {
+		fprintf(stderr, "the face failed to start\n");
+		return 1;
+	}
+
+	if (shadows)
+		_app_control(callback, SETTINGS_KEY_SHADOWS, shadows);
+
+	callback->resume(user_data);
+	_tick(callback, false);
+
+	if (ambient) {
+		callback->ambient_changed(true, user_data);
+		_tick(callback, true);
+	}
+
+	_app_control(callback, MEMREPORT_KEY, REPORT_FILE);
+
+	snprintf(path, sizeof(path), "%s/%s", data_dir, REPORT_FILE);
+	ok = _copy_report(path, out_file);
+
+	if (ok && budget >= 0 && memreport_get_total() > budget * 1024) {
+		fprintf(stderr, "%ld KiB is over the budget of %ld KiB\n", memreport_get_total() / 1024, budget);
+		ok = false;
+	}
+
+	callback->pause(user_data);
+	callback->terminate(user_data);
+
+	snprintf(path, sizeof(path), "rm -rf '%s'", data_dir);
+	if (system(path) != 0)
+		fprintf(stderr, "failed to remove %s\n", data_dir);
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,19 @@
+#!/bin/sh
+#
+# Build the offline memory report and print it for the face.
+# Needs only a C compiler: the face is built on the EFL stubs of tools/host.
+#
+# Usage: tools/mem_report.sh [mem_report options]
+#
+# See tools/mem_report.c for the options, e.g. -m to check a budget in KiB.
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+CC=${CC:-cc}
+
+BIN=${TMPDIR:-/tmp}/mem_report.$$
+trap 'rm -f "$BIN"' EXIT
+
+$CC -std=gnu99 -O2 -I"$ROOT/tools/host/include" -I"$ROOT/tools/host" -I"$ROOT/inc" -o "$BIN" \
+	"$ROOT/tools/mem_report.c" "$ROOT/tools/host/efl_stub.c" "$ROOT"/src/*.c -lm || exit 1
+
+"$BIN" "$@" "$ROOT/res" "$ROOT/edje/images"
@@ -0,0 +1,219 @@
+/*
+ * Check the moon phase disc against the true new moons.
+ *
+ * data_compute_moonphase() counts mean lunations from one new moon. The
+ * reference here is the true new moon of Meeus, Astronomical Algorithms,
+ * chapter 49, good to a few minutes, with the phase of a day taken as
+ * its age between the true new moons either side. Delta T is left out,
+ * it is under a few minutes over the range.
+ *
+ * The mean new moon runs up to about 14 hours either side of the true
+ * one, so the disc may show the step next to the reference one close to
+ * a step boundary. A step farther off than that is a failure.
+ *
+ * Usage: moon_check [-v] [first_year [last_year]]
+ *   -v  print every day the disc is off the reference step
+ * The default is 1900 to 2100.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <math.h>
+
+#include <Elementary.h>
+
+#include "look.h"
+#include "data.h"
+#include "complication.h"
+
+/* The true new moon is at most this far from the mean one, in days */
+#define MEAN_MOON_SPREAD 0.62
+#define SYNODIC_MONTH 29.530588861
+
+#define DEG(x) ((x) * M_PI / 180.0)
+
+/**
+ * @brief Get the Julian Ephemeris Day of the true new moon of lunation k.
+ * @param[in] k The lunation, 0 is the new moon of 6 January 2000
+ */
+static double _true_new_moon(long k)
+{
+	/* Planetary arguments A1 to A14, as (a, b, coefficient) with A = a + b * k */
+	static const double planets[14][3] = {
+		{ 299.77, 0.107408, 0.000325 },
+		{ 251.88, 0.016321, 0.000165 },
+		{ 251.83, 26.651886, 0.000164 },
+		{ 349.42, 36.412478, 0.000126 },
+		{ 84.66, 18.206239, 0.000110 },
+		{ 141.74, 53.303771, 0.000062 },
+		{ 207.14, 2.453732, 0.000060 },
+		{ 154.84, 7.306860, 0.000056 },
+		{ 34.52, 27.261239, 0.000047 },
+		{ 207.19, 0.121824, 0.000042 },
+		{ 291.34, 1.844379, 0.000040 },
+		{ 161.72, 24.198154, 0.000037 },
+		{ 239.56, 25.513099, 0.000035 },
+		{ 331.55, 3.592518, 0.000023 },
+	};
+	double t = k / 1236.85;
+	double t2 = t * t;
+	double t3 = t2 * t;
+	double t4 = t3 * t;
+	double jde = 2451550.09766 + (29.530588861 * k) + (0.00015437 * t2) - (0.000000150 * t3) + (0.00000000073 * t4);
+	double e = 1.0 - (0.002516 * t) - (0.0000074 * t2);
+	double m = DEG(2.5534 + (29.10535670 * k) - (0.0000014 * t2) - (0.00000011 * t3));
+	double mp = DEG(201.5643 + (385.81693528 * k) + (0.0107582 * t2) + (0.00001238 * t3) - (0.000000058 * t4));
+	double f = DEG(160.7108 + (390.67050284 * k) - (0.0016118 * t2) - (0.00000227 * t3) + (0.000000011 * t4));
+	double omega = DEG(124.7746 - (1.56375588 * k) + (0.0020672 * t2) + (0.00000215 * t3));
+	double a = 0.0;
+	int i = 0;
+
+	jde += -0.40720 * sin(mp)
+		+ 0.17241 * e * sin(m)
+		+ 0.01608 * sin(2 * mp)
+		+ 0.01039 * sin(2 * f)
+		+ 0.00739 * e * sin(mp - m)
+		- 0.00514 * e * sin(mp + m)
+		+ 0.00208 * e * e * sin(2 * m)
+		- 0.00111 * sin(mp - (2 * f))
+		- 0.00057 * sin(mp + (2 * f))
+		+ 0.00056 * e * sin((2 * mp) + m)
+		- 0.00042 * sin(3 * mp)
+		+ 0.00042 * e * sin(m + (2 * f))
+		+ 0.00038 * e * sin(m - (2 * f))
+		- 0.00024 * e * sin((2 * mp) - m)
+		- 0.00017 * sin(omega)
+		- 0.00007 * sin(mp + (2 * m))
+		+ 0.00004 * sin((2 * mp) - (2 * f))
+		+ 0.00004 * sin(3 * m)
+		+ 0.00003 * sin(mp + m - (2 * f))
+		+ 0.00003 * sin((2 * mp) + (2 * f))
+		- 0.00003 * sin(mp + m + (2 * f))
+		+ 0.00003 * sin(mp - m + (2 * f))
+		- 0.00002 * sin(mp - m - (2 * f))
+		- 0.00002 * sin((3 * mp) + m)
+		+ 0.00002 * sin(4 * mp);
+
+	for (i = 0; i < 14; i++) {
+		a = planets[i][0] + (planets[i][1] * k);
+		if (i == 0)
+			a -= 0.009173 * t2;
+		jde += planets[i][2] * sin(DEG(a));
+	}
+
+	return jde;
+}
+
+/**
+ * @brief Get the age of the moon at a Julian Day, as a fraction of its lunation.
+ */
+static double _true_phase(double jd)
+{
+	long k = (long)floor((jd - 2451550.09766) / SYNODIC_MONTH);
+	double prev = 0.0;
+	double next = 0.0;
+
+	// The mean guess can be a lunation off either way
+	prev = _true_new_moon(k);
+	if (prev > jd)
+		k--;
+	else if (_true_new_moon(k + 1) <= jd)
+		k++;
+
+	prev = _true_new_moon(k);
+	next = _true_new_moon(k + 1);
+
+	return (jd - prev) / (next - prev);
+}
+
+/**
+ * @brief Get how far a step is from a phase, in steps, around the disc.
+ * @return 0 when the phase falls in the step
+ */
+static double _step_distance(int step, double phase)
+{
+	double pos = phase * MODULE_MOONPHASE_STEPS;
+	double below = 0.0;
+	double above = 0.0;
+
+	if (pos >= step && pos < step + 1)
+		return 0.0;
+
+	// Up to the start of the step, or down to its end, either way round
+	below = fmod(step - pos + MODULE_MOONPHASE_STEPS, MODULE_MOONPHASE_STEPS);
+	above = fmod(pos - (step + 1) + MODULE_MOONPHASE_STEPS, MODULE_MOONPHASE_STEPS);
+
+	return fmin(below, above);
+}
+
+int main(int argc, char *argv[])
+{
+	struct tm tm_day = { 0, };
+	complication_value_s value = { 0, };
+	double tolerance = MEAN_MOON_SPREAD * MODULE_MOONPHASE_STEPS / SYNODIC_MONTH;
+	double worst = 0.0;
+	double distance = 0.0;
+	double phase = 0.0;
+	long days = 0;
+	long off = 0;
+	long failures = 0;
+	int first_year = 1900;
+	int last_year = 2100;
+	bool verbose = false;
+	time_t day = 0;
+	int jd = 0;
+	int opt = 0;
+
+	while ((opt = getopt(argc, argv, "v")) != -1) {
+		switch (opt) {
+		case 'v':
+			verbose = true;
+			break;
+		default:
+			fprintf(stderr, "usage: %s [-v] [first_year [last_year]]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	if (optind < argc)
+		first_year = atoi(argv[optind]);
+	if (optind + 1 < argc)
+		last_year = atoi(argv[optind + 1]);
+
+	// Noon UTC, where the disc takes the phase of the day
+	tm_day.tm_year = first_year - 1900;
+	tm_day.tm_mday = 1;
+	tm_day.tm_hour = 12;
+	day = timegm(&tm_day);
+
+	for (; gmtime_r(&day, &tm_day) && tm_day.tm_year + 1900 <= last_year; day += 24 * 60 * 60) {
+		if (!data_compute_moonphase(day, &value, NULL)) {
+			fprintf(stderr, "no moon phase for %ld\n", (long)day);
+			return 1;
+		}
+
+		jd = data_get_juliandate(tm_day.tm_mday, tm_day.tm_mon + 1, tm_day.tm_year + 1900);
+		phase = _true_phase(jd);
+		distance = _step_distance(value.step, phase);
+
+		days++;
+		if (distance > 0.0)
+			off++;
+		if (distance > worst)
+			worst = distance;
+
+		if (distance > tolerance)
+			failures++;
+
+		if (verbose && distance > 0.0)
+			printf("%04d-%02d-%02d: step %d, reference %.2f%s\n", tm_day.tm_year + 1900, tm_day.tm_mon + 1, tm_day.tm_mday,
+					value.step, phase * MODULE_MOONPHASE_STEPS, distance > tolerance ? " FAIL" : "");
+	}
+
+	printf("%d-%d: %ld days, %ld next to the reference step, worst %.2f steps (%.2f allowed), %ld failures\n",
+			first_year, last_year, days, off, worst, tolerance, failures);
+
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,19 @@
+#!/bin/sh
+#
+# Build the moon phase check and run it, 1900 to 2100 by default.
+# Fails if the disc is a step or more off the true new moons.
+#
+# Usage: tools/moon_check.sh [moon_check options]
+#
+# See tools/moon_check.c for the options.
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+CC=${CC:-cc}
+
+BIN=${TMPDIR:-/tmp}/moon_check.$$
+trap 'rm -f "$BIN"' EXIT
+
+$CC -std=gnu99 -O2 -I"$ROOT/tools/host/include" -I"$ROOT/tools/host" -I"$ROOT/inc" -o "$BIN" \
+	"$ROOT/tools/moon_check.c" "$ROOT/src/data.c" "$ROOT/tools/host/efl_stub.c" -lm || exit 1
+
+"$BIN" "$@"
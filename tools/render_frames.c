@@ -0,0 +1,467 @@
+/*
+ * Render watch face frames offline through the software backend.
+ *
+ * Builds the same scene as _create_base_gui() from the look.h geometry,
+ * without the Edje modules (second hand, day window), and writes one
+ * frame per time step along with the average draw time. Per frame draw
+ * times go to times.txt in out_dir; with -i, a frame is drawn that many
+ * times and the fastest draw is kept, which steadies short timings. A
+ * digest of each frame goes to sums.txt, to keep a golden set as text:
+ * the row kernels give the same pixels bit for bit (tools/blit_bench.sh),
+ * so the digests do not depend on the kernel the host picks.
+ *
+ * The decoded size of the images is printed too, as the memory each
+ * shadow tier (-w) costs.
+ *
+ * With -g, each frame is also compared with the PNG of the same name in
+ * golden_dir, and the exit status is 1 if any frame differs.
+ *
+ * Usage: render_frames [-a] [-l] [-n] [-s] [-r] [-k kernel] [-g golden_dir] [-i draws] [-w tier] [-b level] [-t minutes] res_dir out_dir
+ *   -a  ambient mode
+ *   -l  low battery colour scheme
+ *   -n  nearest sampling instead of bilinear
+ *   -s  filter straight alpha instead of premultiplied
+ *   -r  write raw PAM frames instead of PNG
+ *   -k  row kernel: scalar, sse2, avx2, neon, or float for the per-pixel path
+ *   -g  compare with golden PNG frames, GOLDEN_TOLERANCE per channel
+ *   -i  draws per frame (default 1)
+ *   -w  shadow tier: off, hard (hand sprites tinted black), soft, or auto
+ *       (default, soft unless low battery, as in _get_shadow_tier())
+ *   -b  battery level, 0-100 (default 80)
+ *   -t  minutes between frames (default 1, a full day is 1440 frames)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "look.h"
+#include "render.h"
+#include "render_soft.h"
+
+#define DAY_MINUTES (24 * 60)
+
+/*
+ * The row kernels and the float path round differently by a step or two
+ */
+#define GOLDEN_TOLERANCE 2
+
+#define IMAGE_MAX 16
+
+#define FNV_OFFSET 0xcbf29ce484222325ULL
+#define FNV_PRIME 0x100000001b3ULL
+
+typedef enum {
+	SHADOW_AUTO = 0,
+	SHADOW_OFF,
+	SHADOW_HARD,
+	SHADOW_SOFT,
+	SHADOW_MAX,
+} shadow_e;
+
+static const char *s_shadow_names[SHADOW_MAX] = { "auto", "off", "hard", "soft" };
+
+typedef struct _face {
+	render_object_h bat_shadow;
+	render_object_h bat;
+	render_object_h min_shadow;
+	render_object_h min;
+	render_object_h hour_shadow;
+	render_object_h hour;
+	const char *images[IMAGE_MAX];
+	long image_bytes[IMAGE_MAX];
+	bool image_shadow_only[IMAGE_MAX];
+	int image_cnt;
+} face_s;
+
+/**
+ * @brief Decoded ARGB size of a PNG, from its header.
+ */
+static long _image_bytes(const char *path)
+{
+	unsigned char head[24];
+	long w = 0, h = 0;
+	FILE *fp = fopen(path, "rb");
+
+	if (fp == NULL)
+		return 0;
+
+	if (fread(head, 1, sizeof(head), fp) == sizeof(head)) {
+		w = ((long)head[16] << 24) | (head[17] << 16) | (head[18] << 8) | head[19];
+		h = ((long)head[20] << 24) | (head[21] << 16) | (head[22] << 8) | head[23];
+	}
+	fclose(fp);
+
+	return w * h * 4;
+}
+
+/**
+ * @brief Add an image. Its decoded size is counted once per file, as the image cache shares it.
+ */
+static render_object_h _image_add(face_s *face, const char *res_dir, const char *image, int x, int y, int w, int h, bool shadow)
+{
+	char path[4096] = { 0, };
+	render_object_h obj = NULL;
+	int i = 0;
+
+	snprintf(path, sizeof(path), "%s/images/%s", res_dir, image);
+
+	obj = render_image_add(path, x, y, w, h);
+	if (obj == NULL) {
+		fprintf(stderr, "failed to add %s\n", path);
+		return NULL;
+	}
+
+	for (i = 0; i < face->image_cnt; i++) {
+		if (!strcmp(face->images[i], image))
+			break;
+	}
+
+	if (i == face->image_cnt && i < IMAGE_MAX) {
+		face->images[i] = image;
+		face->image_bytes[i] = _image_bytes(path);
+		face->image_shadow_only[i] = shadow;
+		face->image_cnt++;
+	} else if (i < face->image_cnt && !shadow) {
+		face->image_shadow_only[i] = false;
+	}
+
+	return obj;
+}
+
+/**
+ * @brief Add a shadow in the tier given, nothing when shadows are off.
+ */
+static render_object_h _shadow_add(face_s *face, const char *res_dir, shadow_e tier, const char *hand_image, const char *shadow_image,
+		int x, int y, int w, int h, int alpha)
+{
+	render_object_h obj = NULL;
+
+	if (tier == SHADOW_OFF)
+		return NULL;
+
+	if (tier == SHADOW_HARD) {
+		// Same as view_set_shadow_tint()
+		obj = _image_add(face, res_dir, hand_image, x, y, w, h, true);
+		render_set_color(obj, 0, 0, 0, 255 * 0.5);
+	} else {
+		obj = _image_add(face, res_dir, shadow_image, x, y, w, h, true);
+		render_set_color(obj, 255, 255, 255, alpha);
+	}
+
+	return obj;
+}
+
+/*
+ * Mirrors the part geometry in data.c, at the 360px base size
+ */
+static void _create_face(face_s *face, const char *res_dir, int ambient, int low_battery, shadow_e tier)
+{
+	int hand_x = (BASE_WIDTH / 2) - (HANDS_MIN_WIDTH / 2);
+	int bat_x = (BASE_WIDTH / 2) - (HANDS_BAT_WIDTH / 2);
+	int bat_y = (BASE_HEIGHT / 2) - (HANDS_BAT_HEIGHT / 2) - HANDS_BAT_Y_PADDING;
+
+	memset(face, 0, sizeof(*face));
+
+	if (ambient) {
+		_image_add(face, res_dir, low_battery ? "watch_bg_ambient_low_battery.png" : "watch_bg_ambient.png", 0, 0, BASE_WIDTH, BASE_HEIGHT, false);
+
+		// Ambient hands are white masks tinted by the scheme, see s_scheme_colors
+		face->min = _image_add(face, res_dir, "watch_hand_min_ambient.png", hand_x, 0, HANDS_MIN_WIDTH, HANDS_MIN_HEIGHT, false);
+		face->hour = _image_add(face, res_dir, "watch_hand_hr_ambient.png", hand_x, 0, HANDS_HOUR_WIDTH, HANDS_HOUR_HEIGHT, false);
+		if (low_battery) {
+			render_set_color(face->min, 255, 76, 76, 255);
+			render_set_color(face->hour, 255, 76, 76, 255);
+		} else {
+			render_set_color(face->min, 97, 244, 97, 255);
+			render_set_color(face->hour, 97, 244, 97, 255);
+		}
+		return;
+	}
+
+	_image_add(face, res_dir, "watch_bg.png", 0, 0, BASE_WIDTH, BASE_HEIGHT, false);
+
+	face->bat_shadow = _shadow_add(face, res_dir, tier, "watch_hand_battery.png", "watch_hand_battery_shadow.png",
+			bat_x, bat_y, HANDS_BAT_WIDTH, HANDS_BAT_HEIGHT, 255);
+	face->bat = _image_add(face, res_dir, "watch_hand_battery.png", bat_x, bat_y, HANDS_BAT_WIDTH, HANDS_BAT_HEIGHT, false);
+
+	_image_add(face, res_dir, "watch_bg_plate.png", (BASE_WIDTH - BG_PLATE_WIDTH) / 2, (BASE_HEIGHT - BG_PLATE_HEIGHT) / 2, BG_PLATE_WIDTH, BG_PLATE_HEIGHT, false);
+
+	// Same opacity as view_set_opacity_to_parts()
+	face->min_shadow = _shadow_add(face, res_dir, tier, "watch_hand_min.png", "watch_hand_min_shadow.png",
+			hand_x, HANDS_MIN_SHADOW_PADDING, HANDS_MIN_WIDTH, HANDS_MIN_HEIGHT, 255 * 0.5);
+	face->min = _image_add(face, res_dir, "watch_hand_min.png", hand_x, 0, HANDS_MIN_WIDTH, HANDS_MIN_HEIGHT, false);
+	face->hour_shadow = _shadow_add(face, res_dir, tier, "watch_hand_hr.png", "watch_hand_hr_shadow.png",
+			hand_x, HANDS_HOUR_SHADOW_PADDING, HANDS_HOUR_WIDTH, HANDS_HOUR_HEIGHT, 255 * 0.5);
+	face->hour = _image_add(face, res_dir, "watch_hand_hr.png", hand_x, 0, HANDS_HOUR_WIDTH, HANDS_HOUR_HEIGHT, false);
+
+	// Same as _apply_scheme(), only the battery hand turns red
+	if (low_battery)
+		render_set_color(face->bat, 255, 67, 67, 255);
+}
+
+/*
+ * Mirrors _set_time() and _set_battery()
+ */
+static void _set_face(face_s *face, int ambient, int minute_of_day, int battery)
+{
+	int cx = BASE_WIDTH / 2;
+	int cy = BASE_HEIGHT / 2;
+	int visible_h = ambient ? HANDS_AMBIENT_VISIBLE_HEIGHT : 0;
+	int hour = (minute_of_day / 60) % 12;
+	int min = minute_of_day % 60;
+	double min_degree = min * MIN_ANGLE;
+	double hour_degree = (hour * HOUR_ANGLE) + (min * 0.5);
+	double bat_degree = BATTERY_START_ANGLE + (battery * BATTERY_ANGLE);
+
+	render_set_transform(face->min, min_degree, cx, cy, visible_h);
+	render_set_transform(face->hour, hour_degree, cx, cy, visible_h);
+	render_set_transform(face->min_shadow, min_degree, cx, cy + HANDS_MIN_SHADOW_PADDING, 0);
+	render_set_transform(face->hour_shadow, hour_degree, cx, cy + HANDS_HOUR_SHADOW_PADDING, 0);
+	render_set_transform(face->bat, bat_degree, cx, cy, 0);
+	render_set_transform(face->bat_shadow, bat_degree, cx, cy + HANDS_BAT_SHADOW_PADDING, 0);
+}
+
+/**
+ * @brief Compare the frame with a golden frame.
+ * @return false if any channel is off by more than GOLDEN_TOLERANCE
+ */
+static bool _compare(const char *golden_path)
+{
+	const uint32_t *frame = render_soft_get_pixels();
+	uint32_t *golden = NULL;
+	int w = 0, h = 0;
+	int diff = 0, max_diff = 0;
+	int bad = 0;
+	int i = 0, k = 0;
+
+	// Frames are opaque, so premultiplying the golden one gives back the pixels exactly
+	golden = render_soft_load_png(golden_path, true, &w, &h);
+	if (golden == NULL || w != BASE_WIDTH || h != BASE_HEIGHT) {
+		fprintf(stderr, "%s: missing or not %dx%d\n", golden_path, BASE_WIDTH, BASE_HEIGHT);
+		free(golden);
+		return false;
+	}
+
+	for (i = 0; i < w * h; i++) {
+		for (k = 0; k < 32; k += 8) {
+			diff = abs((int)((frame[i] >> k) & 0xff) - (int)((golden[i] >> k) & 0xff));
+			max_diff = diff > max_diff ? diff : max_diff;
+			if (diff > GOLDEN_TOLERANCE) {
+				bad++;
+				break;
+			}
+		}
+	}
+
+	free(golden);
+
+	if (bad > 0)
+		fprintf(stderr, "%s: %d pixels differ, by up to %d\n", golden_path, bad, max_diff);
+
+	return bad == 0;
+}
+
+/**
+ * @brief 64-bit FNV-1a digest of the frame pixels.
+ */
+static uint64_t _digest(void)
+{
+	const uint32_t *frame = render_soft_get_pixels();
+	uint64_t hash = FNV_OFFSET;
+	int i = 0, k = 0;
+
+	for (i = 0; i < BASE_WIDTH * BASE_HEIGHT; i++) {
+		for (k = 0; k < 32; k += 8) {
+			hash ^= (frame[i] >> k) & 0xff;
+			hash *= FNV_PRIME;
+		}
+	}
+
+	return hash;
+}
+
+static double _now(void)
+{
+	struct timespec ts = { 0, };
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + (ts.tv_nsec / 1000000000.0);
+}
+
+int main(int argc, char *argv[])
+{
+	face_s face;
+	char path[4096] = { 0, };
+	char name[32] = { 0, };
+	const char *golden_dir = NULL;
+	FILE *times = NULL;
+	FILE *sums = NULL;
+	double start = 0.0;
+	double frame_time = 0.0;
+	double spent = 0.0;
+	int ambient = 0;
+	int low_battery = 0;
+	int raw = 0;
+	int battery = 80;
+	int step = 1;
+	int frames = 0;
+	int minute = 0;
+	int mismatches = 0;
+	int repeats = 1;
+	shadow_e shadow = SHADOW_AUTO;
+	long image_bytes = 0;
+	long shadow_bytes = 0;
+	int i = 0;
+	int kernel = -1;
+	int opt = 0;
+
+	while ((opt = getopt(argc, argv, "alnsrk:g:i:w:b:t:")) != -1) {
+		switch (opt) {
+		case 'a':
+			ambient = 1;
+			break;
+		case 'l':
+			low_battery = 1;
+			break;
+		case 'n':
+			render_soft_set_filter(RENDER_SOFT_FILTER_NEAREST);
+			break;
+		case 's':
+			render_soft_set_premultiplied(false);
+			break;
+		case 'r':
+			raw = 1;
+			break;
+		case 'k':
+			for (kernel = 0; kernel < RENDER_BLIT_MAX; kernel++) {
+				if (!strcmp(optarg, render_blit_get_name(kernel)))
+					break;
+			}
+			if (kernel == RENDER_BLIT_MAX && strcmp(optarg, "float")) {
+				fprintf(stderr, "unknown kernel %s\n", optarg);
+				return 1;
+			}
+			break;
+		case 'g':
+			golden_dir = optarg;
+			break;
+		case 'i':
+			repeats = atoi(optarg);
+			break;
+		case 'w':
+			for (shadow = 0; shadow < SHADOW_MAX; shadow++) {
+				if (!strcmp(optarg, s_shadow_names[shadow]))
+					break;
+			}
+			if (shadow == SHADOW_MAX) {
+				fprintf(stderr, "unknown shadow tier %s\n", optarg);
+				return 1;
+			}
+			break;
+		case 'b':
+			battery = atoi(optarg);
+			break;
+		case 't':
+			step = atoi(optarg);
+			break;
+		default:
+			fprintf(stderr, "usage: %s [-a] [-l] [-n] [-s] [-r] [-k kernel] [-g golden_dir] [-i draws] [-w tier] [-b level] [-t minutes] res_dir out_dir\n", argv[0]);
+			return 1;
+		}
+	}
+
+	if (argc - optind != 2 || step <= 0 || repeats <= 0 || (golden_dir && raw)) {
+		fprintf(stderr, "usage: %s [-a] [-l] [-n] [-s] [-r] [-k kernel] [-g golden_dir] [-i draws] [-w tier] [-b level] [-t minutes] res_dir out_dir\n", argv[0]);
+		return 1;
+	}
+
+	if (!render_soft_initialize(BASE_WIDTH, BASE_HEIGHT)) {
+		fprintf(stderr, "failed to allocate the frame\n");
+		return 1;
+	}
+
+	if (kernel >= 0 && !render_soft_set_kernel(kernel)) {
+		fprintf(stderr, "kernel %s is not supported here\n", render_blit_get_name(kernel));
+		render_soft_finalize();
+		return 1;
+	}
+
+	snprintf(path, sizeof(path), "%s/times.txt", argv[optind + 1]);
+	times = fopen(path, "w");
+	if (times == NULL) {
+		fprintf(stderr, "failed to write %s\n", path);
+		render_soft_finalize();
+		return 1;
+	}
+
+	snprintf(path, sizeof(path), "%s/sums.txt", argv[optind + 1]);
+	sums = fopen(path, "w");
+	if (sums == NULL) {
+		fprintf(stderr, "failed to write %s\n", path);
+		fclose(times);
+		render_soft_finalize();
+		return 1;
+	}
+
+	if (shadow == SHADOW_AUTO)
+		shadow = low_battery ? SHADOW_HARD : SHADOW_SOFT;
+
+	render_set_backend(&render_backend_soft);
+	_create_face(&face, argv[optind], ambient, low_battery, shadow);
+
+	for (i = 0; i < face.image_cnt; i++) {
+		image_bytes += face.image_bytes[i];
+		if (face.image_shadow_only[i])
+			shadow_bytes += face.image_bytes[i];
+	}
+
+	for (minute = 0; minute < DAY_MINUTES; minute += step) {
+		_set_face(&face, ambient, minute, battery);
+
+		for (i = 0; i < repeats; i++) {
+			start = _now();
+			render_soft_draw();
+			start = _now() - start;
+			if (i == 0 || start < frame_time)
+				frame_time = start;
+		}
+		spent += frame_time;
+		frames++;
+
+		snprintf(name, sizeof(name), "frame_%02d%02d.%s", minute / 60, minute % 60, raw ? "pam" : "png");
+		fprintf(times, "%s %.3f\n", name, frame_time * 1000.0);
+		fprintf(sums, "%s %016llx\n", name, (unsigned long long)_digest());
+
+		snprintf(path, sizeof(path), "%s/%s", argv[optind + 1], name);
+		if (!(raw ? render_soft_write_raw(path) : render_soft_write_png(path))) {
+			fprintf(stderr, "failed to write %s\n", path);
+			fclose(times);
+			fclose(sums);
+			render_soft_finalize();
+			return 1;
+		}
+
+		if (golden_dir) {
+			snprintf(path, sizeof(path), "%s/%s", golden_dir, name);
+			if (!_compare(path))
+				mismatches++;
+		}
+	}
+
+	fclose(times);
+	fclose(sums);
+
+	printf("%d frames, %.3f ms per frame\n", frames, (spent * 1000.0) / frames);
+	printf("%d images, %ld KiB decoded, %ld KiB for %s shadows\n", face.image_cnt, image_bytes / 1024, shadow_bytes / 1024,
+			ambient ? "no" : s_shadow_names[shadow]);
+	if (golden_dir)
+		printf("%d of %d frames differ from %s\n", mismatches, frames, golden_dir);
+
+	render_soft_finalize();
+
+	return mismatches > 0 ? 1 : 0;
+}
@@ -0,0 +1,28 @@
+#!/bin/sh
+#
+# Build the offline frame renderer and draw a day of frames with it.
+# Needs a C compiler and libpng.
+#
+# Usage: tools/render_frames.sh out_dir [render_frames options]
+#
+# See tools/render_frames.c for the options, e.g. -a for ambient mode.
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+CC=${CC:-cc}
+
+if [ $# -lt 1 ]; then
+	echo "usage: $0 out_dir [render_frames options]"
+	exit 1
+fi
+
+OUT=$1
+shift
+
+BIN=${TMPDIR:-/tmp}/render_frames.$$
+trap 'rm -f "$BIN"' EXIT
+
+$CC -std=gnu99 -O2 -I"$ROOT/tools/soft" -I"$ROOT/inc" -o "$BIN" \
+	"$ROOT/tools/render_frames.c" "$ROOT/src/render.c" "$ROOT/tools/soft/render_soft.c" "$ROOT/tools/soft/render_blit.c" -lpng -lm || exit 1
+
+mkdir -p "$OUT" || exit 1
+"$BIN" "$@" "$ROOT/res" "$OUT"
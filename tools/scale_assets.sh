@@ -0,0 +1,75 @@
+#!/bin/sh
+#
+# Generate pre-scaled assets for round displays larger than the 360px
+# design size, so hands are mapped 1:1 instead of being resampled. Each
+# image is sized to the part it is drawn into, not to its own pixel
+# size, as the hand sources are drawn oversampled.
+#
+#  res/images/<size>/*.png      images loaded at runtime
+#  edje/images/<size>/*.png     images embedded in the theme
+#  res/edje/<size>/main.edj     theme compiled against the scaled images
+#
+# The sizes must match s_profiles in src/data.c. Run before packaging;
+# a profile without generated assets falls back to the 360px ones.
+#
+# Usage: tools/scale_assets.sh [size ...]
+#
+# Needs edje_cc (EFL) and ImageMagick (convert).
+
+SIZES=${*:-"396 450"}
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+
+for tool in convert edje_cc; do
+	if ! command -v $tool >/dev/null 2>&1; then
+		echo "$tool not found"
+		exit 1
+	fi
+done
+
+# The layout values of inc/look.h, e.g. HANDS_MIN_WIDTH=30
+eval "$(awk '$1 == "#define" && $3 ~ /^[0-9]+$/ && NF == 3 { print $2 "=" $3 }' "$ROOT/inc/look.h")"
+
+# The size of the part an image is drawn into, at BASE_WIDTH
+part_size() {
+	case $1 in
+	watch_bg_plate.png) echo "BG_PLATE_WIDTH BG_PLATE_HEIGHT" ;;
+	watch_bg*.png) echo "BASE_WIDTH BASE_HEIGHT" ;;
+	watch_hand_battery*.png) echo "HANDS_BAT_WIDTH HANDS_BAT_HEIGHT" ;;
+	watch_hand_hr*.png) echo "HANDS_HOUR_WIDTH HANDS_HOUR_HEIGHT" ;;
+	watch_hand_min*.png) echo "HANDS_MIN_WIDTH HANDS_MIN_HEIGHT" ;;
+	watch_hand_sec*.png) echo "HANDS_SEC_WIDTH HANDS_SEC_HEIGHT" ;;
+	watch_moonphase_disc.png) echo "MODULE_MOONPHASE_WINDOW_SIZE MODULE_MOONPHASE_WINDOW_SIZE" ;;
+	watch_moonphase_window.png) echo "MODULE_MOONPHASE_WINDOW_SIZE MODULE_MOONPHASE_WINDOW_SIZE/2" ;;
+	watch_day_num_*.png) echo "MODULE_DAY_NUM_SIZE MODULE_DAY_NUM_SIZE" ;;
+	*) return 1 ;;
+	esac
+}
+
+scale_dir() {
+	src=$1
+	dst=$2
+	size=$3
+
+	mkdir -p "$dst"
+	for img in "$src"/*.png; do
+		name=$(basename "$img")
+		if ! part=$(part_size "$name"); then
+			echo "no part size for $name, add it to part_size()"
+			exit 1
+		fi
+		# The part size, scaled the same way data_scale() does
+		set -- $part
+		w=$(( ($(($1)) * size + BASE_WIDTH / 2) / BASE_WIDTH ))
+		h=$(( ($(($2)) * size + BASE_WIDTH / 2) / BASE_WIDTH ))
+		convert "$img" -filter Lanczos -resize "${w}x${h}!" "$dst/$name" || exit 1
+	done
+}
+
+for size in $SIZES; do
+	echo "== ${size}px"
+	scale_dir "$ROOT/res/images" "$ROOT/res/images/$size" "$size"
+	scale_dir "$ROOT/edje/images" "$ROOT/edje/images/$size" "$size"
+	mkdir -p "$ROOT/res/edje/$size"
+	edje_cc -id "$ROOT/edje/images/$size" "$ROOT/res/edje/main.edc" "$ROOT/res/edje/$size/main.edj" || exit 1
+done
@@ -0,0 +1,434 @@
+#include <stddef.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#if defined(__GNUC__)
+#include <immintrin.h>
+#define RENDER_BLIT_HAVE_AVX2 1
+#endif
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define RENDER_BLIT_HAVE_NEON 1
+#endif
+
+#include "render_blit.h"
+
+/*
+ * Weights have 7 bits so that a*(128-f) + b*f stays below 2^15, which
+ * keeps every intermediate in a 16 bit lane for the vector kernels.
+ */
+#define BLIT_FRAC_BITS 7
+#define BLIT_FRAC_ONE (1 << BLIT_FRAC_BITS)
+
+static const char *s_kernel_names[RENDER_BLIT_MAX] = {
+	[RENDER_BLIT_SCALAR] = "scalar",
+	[RENDER_BLIT_SSE2] = "sse2",
+	[RENDER_BLIT_AVX2] = "avx2",
+	[RENDER_BLIT_NEON] = "neon",
+};
+
+/**
+ * @brief Divide by 255, rounded, exact for t up to 255 * 255.
+ */
+static inline uint32_t _div255(uint32_t t)
+{
+	t += 128;
+	return (t + (t >> 8)) >> 8;
+}
+
+/**
+ * @brief Texel coordinates and weights of one pixel, clamped to the sprite.
+ */
+static inline void _locate(const render_blit_span_s *span, int32_t u, int32_t v,
+		uint32_t *i00, uint32_t *i01, uint32_t *i10, uint32_t *i11, uint32_t *fx, uint32_t *fy)
+{
+	int32_t umax = (span->src_w - 1) << 16;
+	int32_t vmax = (span->src_h - 1) << 16;
+	int x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+
+	u = u < 0 ? 0 : (u > umax ? umax : u);
+	v = v < 0 ? 0 : (v > vmax ? vmax : v);
+
+	x0 = u >> 16;
+	y0 = v >> 16;
+	x1 = x0 + (x0 < span->src_w - 1);
+	y1 = y0 + (y0 < span->src_h - 1);
+
+	*i00 = (y0 * span->src_w) + x0;
+	*i01 = (y0 * span->src_w) + x1;
+	*i10 = (y1 * span->src_w) + x0;
+	*i11 = (y1 * span->src_w) + x1;
+	*fx = (u >> (16 - BLIT_FRAC_BITS)) & (BLIT_FRAC_ONE - 1);
+	*fy = (v >> (16 - BLIT_FRAC_BITS)) & (BLIT_FRAC_ONE - 1);
+}
+
+/**
+ * @brief Reference kernel, one pixel and one channel at a time.
+ */
+static void _blit_scalar(const render_blit_span_s *span)
+{
+	const uint32_t *src = span->src;
+	uint32_t i00, i01, i10, i11, fx, fy;
+	uint32_t s[4], out = 0;
+	uint32_t top = 0, bottom = 0, d = 0;
+	int32_t u = span->u;
+	int32_t v = span->v;
+	int shift = 0;
+	int i = 0, k = 0;
+
+	for (i = 0; i < span->count; i++, u += span->du, v += span->dv) {
+		_locate(span, u, v, &i00, &i01, &i10, &i11, &fx, &fy);
+
+		for (k = 0; k < 4; k++) {
+			shift = k * 8;
+			top = ((((src[i00] >> shift) & 0xff) * (BLIT_FRAC_ONE - fx)) + (((src[i01] >> shift) & 0xff) * fx)) >> BLIT_FRAC_BITS;
+			bottom = ((((src[i10] >> shift) & 0xff) * (BLIT_FRAC_ONE - fx)) + (((src[i11] >> shift) & 0xff) * fx)) >> BLIT_FRAC_BITS;
+			s[k] = ((top * (BLIT_FRAC_ONE - fy)) + (bottom * fy)) >> BLIT_FRAC_BITS;
+			s[k] = _div255(s[k] * ((span->color >> shift) & 0xff));
+		}
+
+		// The colour need not be premultiplied, so the sum can pass 255
+		out = 0;
+		for (k = 0; k < 4; k++) {
+			d = s[k] + _div255(((span->dst[i] >> (k * 8)) & 0xff) * (255 - s[3]));
+			out |= (d > 255 ? 255 : d) << (k * 8);
+		}
+		span->dst[i] = out;
+	}
+}
+
+#if defined(__SSE2__)
+
+/**
+ * @brief Divide 16 bit lanes by 255, as _div255().
+ */
+static inline __m128i _div255_sse2(__m128i t)
+{
+	t = _mm_add_epi16(t, _mm_set1_epi16(128));
+	return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+
+/**
+ * @brief Filter, colour and blend two pixels held as 16 bit lanes.
+ */
+static inline __m128i _blend2_sse2(__m128i a, __m128i b, __m128i c, __m128i d,
+		__m128i fx, __m128i fy, __m128i color, __m128i dst)
+{
+	__m128i one = _mm_set1_epi16(BLIT_FRAC_ONE);
+	__m128i top = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(a, _mm_sub_epi16(one, fx)), _mm_mullo_epi16(b, fx)), BLIT_FRAC_BITS);
+	__m128i bottom = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(c, _mm_sub_epi16(one, fx)), _mm_mullo_epi16(d, fx)), BLIT_FRAC_BITS);
+	__m128i s = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(top, _mm_sub_epi16(one, fy)), _mm_mullo_epi16(bottom, fy)), BLIT_FRAC_BITS);
+	__m128i sa;
+
+	s = _div255_sse2(_mm_mullo_epi16(s, color));
+	sa = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+
+	return _mm_add_epi16(s, _div255_sse2(_mm_mullo_epi16(dst, _mm_sub_epi16(_mm_set1_epi16(255), sa))));
+}
+
+/**
+ * @brief SSE2 kernel, four pixels per step. SSE2 has no gather, so
+ * texels are fetched with scalar loads and filtered as vectors.
+ */
+static void _blit_sse2(const render_blit_span_s *span)
+{
+	const uint32_t *src = span->src;
+	__m128i zero = _mm_setzero_si128();
+	__m128i color = _mm_unpacklo_epi8(_mm_set1_epi32(span->color), zero);
+	__m128i a, b, c, d, dst, lo, hi;
+	uint32_t ta[4], tb[4], tc[4], td[4];
+	uint32_t i00, i01, i10, i11;
+	uint32_t fx[4], fy[4];
+	int32_t u = span->u;
+	int32_t v = span->v;
+	int i = 0, k = 0;
+
+	for (i = 0; i + 4 <= span->count; i += 4) {
+		for (k = 0; k < 4; k++, u += span->du, v += span->dv) {
+			_locate(span, u, v, &i00, &i01, &i10, &i11, &fx[k], &fy[k]);
+			ta[k] = src[i00];
+			tb[k] = src[i01];
+			tc[k] = src[i10];
+			td[k] = src[i11];
+		}
+
+		a = _mm_loadu_si128((const __m128i *)ta);
+		b = _mm_loadu_si128((const __m128i *)tb);
+		c = _mm_loadu_si128((const __m128i *)tc);
+		d = _mm_loadu_si128((const __m128i *)td);
+		dst = _mm_loadu_si128((const __m128i *)(span->dst + i));
+
+		lo = _blend2_sse2(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero),
+				_mm_unpacklo_epi8(c, zero), _mm_unpacklo_epi8(d, zero),
+				_mm_set_epi16(fx[1], fx[1], fx[1], fx[1], fx[0], fx[0], fx[0], fx[0]),
+				_mm_set_epi16(fy[1], fy[1], fy[1], fy[1], fy[0], fy[0], fy[0], fy[0]),
+				color, _mm_unpacklo_epi8(dst, zero));
+		hi = _blend2_sse2(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero),
+				_mm_unpackhi_epi8(c, zero), _mm_unpackhi_epi8(d, zero),
+				_mm_set_epi16(fx[3], fx[3], fx[3], fx[3], fx[2], fx[2], fx[2], fx[2]),
+				_mm_set_epi16(fy[3], fy[3], fy[3], fy[3], fy[2], fy[2], fy[2], fy[2]),
+				color, _mm_unpackhi_epi8(dst, zero));
+
+		_mm_storeu_si128((__m128i *)(span->dst + i), _mm_packus_epi16(lo, hi));
+	}
+
+	if (i < span->count) {
+		render_blit_span_s tail = *span;
+
+		tail.dst += i;
+		tail.count -= i;
+		tail.u = u;
+		tail.v = v;
+		_blit_scalar(&tail);
+	}
+}
+
+#endif
+
+#if defined(RENDER_BLIT_HAVE_AVX2)
+
+__attribute__((target("avx2")))
+static inline __m256i _div255_avx2(__m256i t)
+{
+	t = _mm256_add_epi16(t, _mm256_set1_epi16(128));
+	return _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+}
+
+/**
+ * @brief Filter, colour and blend four pixels held as 16 bit lanes.
+ */
+__attribute__((target("avx2")))
+static inline __m256i _blend4_avx2(__m256i a, __m256i b, __m256i c, __m256i d,
+		__m256i fx, __m256i fy, __m256i color, __m256i dst)
+{
+	__m256i one = _mm256_set1_epi16(BLIT_FRAC_ONE);
+	__m256i top = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(a, _mm256_sub_epi16(one, fx)), _mm256_mullo_epi16(b, fx)), BLIT_FRAC_BITS);
+	__m256i bottom = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(c, _mm256_sub_epi16(one, fx)), _mm256_mullo_epi16(d, fx)), BLIT_FRAC_BITS);
+	__m256i s = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(top, _mm256_sub_epi16(one, fy)), _mm256_mullo_epi16(bottom, fy)), BLIT_FRAC_BITS);
+	__m256i sa;
+
+	s = _div255_avx2(_mm256_mullo_epi16(s, color));
+	sa = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(s, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+
+	return _mm256_add_epi16(s, _div255_avx2(_mm256_mullo_epi16(dst, _mm256_sub_epi16(_mm256_set1_epi16(255), sa))));
+}
+
+/**
+ * @brief AVX2 kernel, eight pixels per step. Coordinates are stepped as
+ * vectors and texels are gathered. Unpacking works within 128 bit lanes,
+ * so the low half holds pixels 0, 1, 4, 5 and packing restores the order.
+ */
+__attribute__((target("avx2")))
+static void _blit_avx2(const render_blit_span_s *span)
+{
+	const int *src = (const int *)span->src;
+	__m256i zero = _mm256_setzero_si256();
+	__m256i color = _mm256_unpacklo_epi8(_mm256_set1_epi32(span->color), zero);
+	__m256i step = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+	__m256i u = _mm256_add_epi32(_mm256_set1_epi32(span->u), _mm256_mullo_epi32(step, _mm256_set1_epi32(span->du)));
+	__m256i v = _mm256_add_epi32(_mm256_set1_epi32(span->v), _mm256_mullo_epi32(step, _mm256_set1_epi32(span->dv)));
+	__m256i du8 = _mm256_set1_epi32(span->du * 8);
+	__m256i dv8 = _mm256_set1_epi32(span->dv * 8);
+	__m256i umax = _mm256_set1_epi32((span->src_w - 1) << 16);
+	__m256i vmax = _mm256_set1_epi32((span->src_h - 1) << 16);
+	__m256i wmax = _mm256_set1_epi32(span->src_w - 1);
+	__m256i hmax = _mm256_set1_epi32(span->src_h - 1);
+	__m256i stride = _mm256_set1_epi32(span->src_w);
+	__m256i mask = _mm256_set1_epi32(BLIT_FRAC_ONE - 1);
+	__m256i uc, vc, x0, y0, x1, y1, row0, row1, fx, fy;
+	__m256i a, b, c, d, dst, lo, hi;
+	int i = 0;
+
+	for (i = 0; i + 8 <= span->count; i += 8) {
+		uc = _mm256_min_epi32(_mm256_max_epi32(u, zero), umax);
+		vc = _mm256_min_epi32(_mm256_max_epi32(v, zero), vmax);
+
+		x0 = _mm256_srli_epi32(uc, 16);
+		y0 = _mm256_srli_epi32(vc, 16);
+		x1 = _mm256_sub_epi32(x0, _mm256_cmpgt_epi32(wmax, x0));
+		y1 = _mm256_sub_epi32(y0, _mm256_cmpgt_epi32(hmax, y0));
+		row0 = _mm256_mullo_epi32(y0, stride);
+		row1 = _mm256_mullo_epi32(y1, stride);
+
+		a = _mm256_i32gather_epi32(src, _mm256_add_epi32(row0, x0), 4);
+		b = _mm256_i32gather_epi32(src, _mm256_add_epi32(row0, x1), 4);
+		c = _mm256_i32gather_epi32(src, _mm256_add_epi32(row1, x0), 4);
+		d = _mm256_i32gather_epi32(src, _mm256_add_epi32(row1, x1), 4);
+
+		// Weights in both 16 bit halves, then spread over each pixel's four lanes
+		fx = _mm256_and_si256(_mm256_srli_epi32(uc, 16 - BLIT_FRAC_BITS), mask);
+		fy = _mm256_and_si256(_mm256_srli_epi32(vc, 16 - BLIT_FRAC_BITS), mask);
+		fx = _mm256_or_si256(fx, _mm256_slli_epi32(fx, 16));
+		fy = _mm256_or_si256(fy, _mm256_slli_epi32(fy, 16));
+
+		dst = _mm256_loadu_si256((const __m256i *)(span->dst + i));
+
+		lo = _blend4_avx2(_mm256_unpacklo_epi8(a, zero), _mm256_unpacklo_epi8(b, zero),
+				_mm256_unpacklo_epi8(c, zero), _mm256_unpacklo_epi8(d, zero),
+				_mm256_unpacklo_epi32(fx, fx), _mm256_unpacklo_epi32(fy, fy),
+				color, _mm256_unpacklo_epi8(dst, zero));
+		hi = _blend4_avx2(_mm256_unpackhi_epi8(a, zero), _mm256_unpackhi_epi8(b, zero),
+				_mm256_unpackhi_epi8(c, zero), _mm256_unpackhi_epi8(d, zero),
+				_mm256_unpackhi_epi32(fx, fx), _mm256_unpackhi_epi32(fy, fy),
+				color, _mm256_unpackhi_epi8(dst, zero));
+
+		_mm256_storeu_si256((__m256i *)(span->dst + i), _mm256_packus_epi16(lo, hi));
+
+		u = _mm256_add_epi32(u, du8);
+		v = _mm256_add_epi32(v, dv8);
+	}
+
+	if (i < span->count) {
+		render_blit_span_s tail = *span;
+
+		tail.dst += i;
+		tail.count -= i;
+		tail.u = span->u + (i * span->du);
+		tail.v = span->v + (i * span->dv);
+		_blit_sse2(&tail);
+	}
+}
+
+#endif
+
+#if defined(RENDER_BLIT_HAVE_NEON)
+
+static inline uint16x8_t _div255_neon(uint16x8_t t)
+{
+	t = vaddq_u16(t, vdupq_n_u16(128));
+	return vshrq_n_u16(vaddq_u16(t, vshrq_n_u16(t, 8)), 8);
+}
+
+/**
+ * @brief Filter, colour and blend two pixels held as 16 bit lanes.
+ */
+static inline uint16x8_t _blend2_neon(uint16x8_t a, uint16x8_t b, uint16x8_t c, uint16x8_t d,
+		uint16x8_t fx, uint16x8_t fy, uint16x8_t color, uint16x8_t dst)
+{
+	uint16x8_t one = vdupq_n_u16(BLIT_FRAC_ONE);
+	uint16x8_t top = vshrq_n_u16(vmlaq_u16(vmulq_u16(a, vsubq_u16(one, fx)), b, fx), BLIT_FRAC_BITS);
+	uint16x8_t bottom = vshrq_n_u16(vmlaq_u16(vmulq_u16(c, vsubq_u16(one, fx)), d, fx), BLIT_FRAC_BITS);
+	uint16x8_t s = vshrq_n_u16(vmlaq_u16(vmulq_u16(top, vsubq_u16(one, fy)), bottom, fy), BLIT_FRAC_BITS);
+	uint16x8_t sa;
+
+	s = _div255_neon(vmulq_u16(s, color));
+	sa = vcombine_u16(vdup_lane_u16(vget_low_u16(s), 3), vdup_lane_u16(vget_high_u16(s), 3));
+
+	return vaddq_u16(s, _div255_neon(vmulq_u16(dst, vsubq_u16(vdupq_n_u16(255), sa))));
+}
+
+/**
+ * @brief NEON kernel for the watch, four pixels per step with scalar texel loads.
+ */
+static void _blit_neon(const render_blit_span_s *span)
+{
+	const uint32_t *src = span->src;
+	uint16x8_t color = vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(span->color)));
+	uint8x16_t a, b, c, d, dst;
+	uint16x8_t lo, hi;
+	uint32_t ta[4], tb[4], tc[4], td[4];
+	uint32_t i00, i01, i10, i11;
+	uint32_t fx[4], fy[4];
+	uint16_t wx[16], wy[16];
+	int32_t u = span->u;
+	int32_t v = span->v;
+	int i = 0, k = 0, j = 0;
+
+	for (i = 0; i + 4 <= span->count; i += 4) {
+		for (k = 0; k < 4; k++, u += span->du, v += span->dv) {
+			_locate(span, u, v, &i00, &i01, &i10, &i11, &fx[k], &fy[k]);
+			ta[k] = src[i00];
+			tb[k] = src[i01];
+			tc[k] = src[i10];
+			td[k] = src[i11];
+			for (j = 0; j < 4; j++) {
+				wx[(k * 4) + j] = fx[k];
+				wy[(k * 4) + j] = fy[k];
+			}
+		}
+
+		a = vreinterpretq_u8_u32(vld1q_u32(ta));
+		b = vreinterpretq_u8_u32(vld1q_u32(tb));
+		c = vreinterpretq_u8_u32(vld1q_u32(tc));
+		d = vreinterpretq_u8_u32(vld1q_u32(td));
+		dst = vreinterpretq_u8_u32(vld1q_u32(span->dst + i));
+
+		lo = _blend2_neon(vmovl_u8(vget_low_u8(a)), vmovl_u8(vget_low_u8(b)),
+				vmovl_u8(vget_low_u8(c)), vmovl_u8(vget_low_u8(d)),
+				vld1q_u16(wx), vld1q_u16(wy), color, vmovl_u8(vget_low_u8(dst)));
+		hi = _blend2_neon(vmovl_u8(vget_high_u8(a)), vmovl_u8(vget_high_u8(b)),
+				vmovl_u8(vget_high_u8(c)), vmovl_u8(vget_high_u8(d)),
+				vld1q_u16(wx + 8), vld1q_u16(wy + 8), color, vmovl_u8(vget_high_u8(dst)));
+
+		vst1q_u32(span->dst + i, vreinterpretq_u32_u8(vcombine_u8(vqmovn_u16(lo), vqmovn_u16(hi))));
+	}
+
+	if (i < span->count) {
+		render_blit_span_s tail = *span;
+
+		tail.dst += i;
+		tail.count -= i;
+		tail.u = u;
+		tail.v = v;
+		_blit_scalar(&tail);
+	}
+}
+
+#endif
+
+/**
+ * @brief Get a kernel.
+ * @param[in] kernel The kernel
+ * @return The kernel, or NULL if this build or CPU does not support it
+ */
+render_blit_span_cb render_blit_get(render_blit_kernel_e kernel)
+{
+	switch (kernel) {
+	case RENDER_BLIT_SCALAR:
+		return _blit_scalar;
+#if defined(__SSE2__)
+	case RENDER_BLIT_SSE2:
+		return _blit_sse2;
+#endif
+#if defined(RENDER_BLIT_HAVE_AVX2)
+	case RENDER_BLIT_AVX2:
+		return __builtin_cpu_supports("avx2") ? _blit_avx2 : NULL;
+#endif
+#if defined(RENDER_BLIT_HAVE_NEON)
+	case RENDER_BLIT_NEON:
+		return _blit_neon;
+#endif
+	default:
+		return NULL;
+	}
+}
+
+/**
+ * @brief Get the fastest kernel this build and CPU support.
+ */
+render_blit_kernel_e render_blit_get_best(void)
+{
+	static const render_blit_kernel_e order[] = { RENDER_BLIT_AVX2, RENDER_BLIT_NEON, RENDER_BLIT_SSE2 };
+	size_t i = 0;
+
+	for (i = 0; i < sizeof(order) / sizeof(order[0]); i++) {
+		if (render_blit_get(order[i]))
+			return order[i];
+	}
+
+	return RENDER_BLIT_SCALAR;
+}
+
+/**
+ * @brief Get the name of a kernel.
+ * @param[in] kernel The kernel
+ */
+const char *render_blit_get_name(render_blit_kernel_e kernel)
+{
+	if (kernel < 0 || kernel >= RENDER_BLIT_MAX)
+		return "unknown";
+
+	return s_kernel_names[kernel];
+}
@@ -0,0 +1,43 @@
+#if !defined(_RENDER_BLIT_H)
+#define _RENDER_BLIT_H
+
+#include <stdint.h>
+
+typedef enum {
+	RENDER_BLIT_SCALAR = 0,
+	RENDER_BLIT_SSE2,
+	RENDER_BLIT_AVX2,
+	RENDER_BLIT_NEON,
+	RENDER_BLIT_MAX,
+} render_blit_kernel_e;
+
+/*
+ * One row of a rotated sprite. The caller clips the span so every pixel
+ * samples inside the sprite; u and v are 16.16 texel coordinates of the
+ * first pixel, already offset by half a texel, and step by du, dv per pixel.
+ * Pixels and colour are premultiplied 0xAARRGGBB.
+ */
+typedef struct _render_blit_span {
+	uint32_t *dst;
+	int count;
+	const uint32_t *src;
+	int src_w;
+	int src_h;
+	int32_t u;
+	int32_t v;
+	int32_t du;
+	int32_t dv;
+	uint32_t color;
+} render_blit_span_s;
+
+/*
+ * Sample bilinearly, multiply by the colour and draw over dst. All kernels
+ * use the same integer arithmetic and give identical output.
+ */
+typedef void (*render_blit_span_cb)(const render_blit_span_s *span);
+
+render_blit_span_cb render_blit_get(render_blit_kernel_e kernel);
+render_blit_kernel_e render_blit_get_best(void);
+const char *render_blit_get_name(render_blit_kernel_e kernel);
+
+#endif
@@ -0,0 +1,645 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <png.h>
+
+#include "render_soft.h"
+
+/*
+ * Pixels are 0xAARRGGBB. Images keep both a premultiplied and a straight
+ * copy, so the two blending strategies can be compared on the same scene.
+ */
+struct _render_object {
+	struct _render_object *next;
+	uint32_t *premul;
+	uint32_t *straight;
+	int iw;
+	int ih;
+	int x;
+	int y;
+	int w;
+	int h;
+	double degree;
+	int cx;
+	int cy;
+	int visible_h;
+	int r;
+	int g;
+	int b;
+	int a;
+	bool visible;
+};
+
+static struct render_soft_info {
+	uint32_t *frame;
+	int width;
+	int height;
+	render_soft_filter_e filter;
+	bool premultiplied;
+	render_blit_span_cb blit;
+	struct _render_object *head;
+	struct _render_object *tail;
+} s_info = {
+	.frame = NULL,
+	.width = 0,
+	.height = 0,
+	.filter = RENDER_SOFT_FILTER_BILINEAR,
+	.premultiplied = true,
+	.blit = NULL,
+	.head = NULL,
+	.tail = NULL,
+};
+
+/*
+ * PNG, through libpng
+ */
+
+/**
+ * @brief Drop libpng warnings, such as the colour profiles some assets carry.
+ */
+static void _png_warning(png_structp png, png_const_charp message)
+{
+}
+
+/**
+ * @brief Load a PNG file as straight 0xAARRGGBB pixels.
+ * Gamma is left alone, the frames are compared byte for byte with the assets.
+ */
+static uint32_t *_png_load(const char *path, int *width, int *height)
+{
+	png_structp png = NULL;
+	png_infop info = NULL;
+	uint8_t *volatile raw = NULL;
+	uint32_t *volatile pixels = NULL;
+	png_bytep *volatile rows = NULL;
+	const uint8_t *src = NULL;
+	png_uint_32 w = 0, h = 0;
+	int depth = 0, type = 0;
+	png_uint_32 i = 0;
+	FILE *fp = NULL;
+
+	fp = fopen(path, "rb");
+	if (fp == NULL)
+		return NULL;
+
+	png = png_create_read_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, _png_warning);
+	if (png)
+		info = png_create_info_struct(png);
+	if (info == NULL)
+		goto fail;
+
+	if (setjmp(png_jmpbuf(png)))
+		goto fail;
+
+	png_init_io(png, fp);
+	png_read_info(png, info);
+	png_get_IHDR(png, info, &w, &h, &depth, &type, NULL, NULL, NULL);
+	if (w > 8192 || h > 8192)
+		goto fail;
+
+	// Everything to 8 bit RGBA
+	png_set_expand(png);
+	png_set_strip_16(png);
+	png_set_gray_to_rgb(png);
+	if (!(type & PNG_COLOR_MASK_ALPHA) && !png_get_valid(png, info, PNG_INFO_tRNS))
+		png_set_add_alpha(png, 0xff, PNG_FILLER_AFTER);
+	png_set_interlace_handling(png);
+	png_read_update_info(png, info);
+
+	raw = malloc((size_t)w * h * 4);
+	rows = malloc(sizeof(png_bytep) * h);
+	pixels = malloc(sizeof(uint32_t) * w * h);
+	if (raw == NULL || rows == NULL || pixels == NULL)
+		goto fail;
+
+	for (i = 0; i < h; i++)
+		rows[i] = raw + ((size_t)i * w * 4);
+	png_read_image(png, rows);
+	png_read_end(png, NULL);
+
+	for (i = 0, src = raw; i < w * h; i++, src += 4)
+		pixels[i] = ((uint32_t)src[3] << 24) | (src[0] << 16) | (src[1] << 8) | src[2];
+
+	*width = w;
+	*height = h;
+	goto out;
+
+fail:
+	free(pixels);
+	pixels = NULL;
+out:
+	png_destroy_read_struct(&png, &info, NULL);
+	free(rows);
+	free(raw);
+	fclose(fp);
+	return pixels;
+}
+
+/**
+ * @brief Convert a premultiplied pixel to straight RGBA bytes.
+ */
+static void _unpremultiply(uint32_t px, uint8_t *out)
+{
+	int a = px >> 24;
+
+	out[3] = a;
+	if (a == 0) {
+		out[0] = out[1] = out[2] = 0;
+		return;
+	}
+
+	out[0] = ((((px >> 16) & 0xff) * 255) + (a / 2)) / a;
+	out[1] = ((((px >> 8) & 0xff) * 255) + (a / 2)) / a;
+	out[2] = (((px & 0xff) * 255) + (a / 2)) / a;
+}
+
+/*
+ * Rasteriser
+ */
+
+static uint32_t _premultiply(uint32_t px)
+{
+	uint32_t a = px >> 24;
+
+	return (a << 24) |
+			(((((px >> 16) & 0xff) * a) + 127) / 255) << 16 |
+			(((((px >> 8) & 0xff) * a) + 127) / 255) << 8 |
+			((((px & 0xff) * a) + 127) / 255);
+}
+
+/**
+ * @brief Sample an image at a point in image pixels, clamped at the edges.
+ * Straight pixels are premultiplied after filtering.
+ */
+static uint32_t _sample(const struct _render_object *obj, double u, double v)
+{
+	const uint32_t *src = s_info.premultiplied ? obj->premul : obj->straight;
+	uint32_t p[4];
+	double fu = 0.0, fv = 0.0;
+	double c[4] = { 0.0, };
+	int x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+	int i = 0;
+	int shift = 0;
+
+	if (s_info.filter == RENDER_SOFT_FILTER_NEAREST) {
+		x0 = (int)u;
+		y0 = (int)v;
+		x0 = x0 < 0 ? 0 : (x0 >= obj->iw ? obj->iw - 1 : x0);
+		y0 = y0 < 0 ? 0 : (y0 >= obj->ih ? obj->ih - 1 : y0);
+		p[0] = src[(y0 * obj->iw) + x0];
+		return s_info.premultiplied ? p[0] : _premultiply(p[0]);
+	}
+
+	u -= 0.5;
+	v -= 0.5;
+	x0 = (int)floor(u);
+	y0 = (int)floor(v);
+	fu = u - x0;
+	fv = v - y0;
+	x1 = x0 + 1;
+	y1 = y0 + 1;
+	x0 = x0 < 0 ? 0 : (x0 >= obj->iw ? obj->iw - 1 : x0);
+	x1 = x1 < 0 ? 0 : (x1 >= obj->iw ? obj->iw - 1 : x1);
+	y0 = y0 < 0 ? 0 : (y0 >= obj->ih ? obj->ih - 1 : y0);
+	y1 = y1 < 0 ? 0 : (y1 >= obj->ih ? obj->ih - 1 : y1);
+
+	p[0] = src[(y0 * obj->iw) + x0];
+	p[1] = src[(y0 * obj->iw) + x1];
+	p[2] = src[(y1 * obj->iw) + x0];
+	p[3] = src[(y1 * obj->iw) + x1];
+
+	for (i = 0; i < 4; i++) {
+		shift = 24 - (i * 8);
+		c[i] = (((p[0] >> shift) & 0xff) * (1.0 - fu) * (1.0 - fv)) +
+				(((p[1] >> shift) & 0xff) * fu * (1.0 - fv)) +
+				(((p[2] >> shift) & 0xff) * (1.0 - fu) * fv) +
+				(((p[3] >> shift) & 0xff) * fu * fv);
+	}
+
+	p[0] = ((uint32_t)(c[0] + 0.5) << 24) | ((uint32_t)(c[1] + 0.5) << 16) |
+			((uint32_t)(c[2] + 0.5) << 8) | (uint32_t)(c[3] + 0.5);
+
+	return s_info.premultiplied ? p[0] : _premultiply(p[0]);
+}
+
+/**
+ * @brief Multiply by the object colour and draw over the frame.
+ */
+static void _blend(uint32_t *dst, uint32_t src, const struct _render_object *obj)
+{
+	uint32_t sa = (((src >> 24) * obj->a) + 127) / 255;
+	uint32_t sr = ((((src >> 16) & 0xff) * obj->r) + 127) / 255;
+	uint32_t sg = ((((src >> 8) & 0xff) * obj->g) + 127) / 255;
+	uint32_t sb = (((src & 0xff) * obj->b) + 127) / 255;
+	uint32_t d = *dst;
+	uint32_t ia = 255 - sa;
+	uint32_t r = sr + (((((d >> 16) & 0xff) * ia) + 127) / 255);
+	uint32_t g = sg + (((((d >> 8) & 0xff) * ia) + 127) / 255);
+	uint32_t b = sb + ((((d & 0xff) * ia) + 127) / 255);
+	uint32_t a = sa + ((((d >> 24) * ia) + 127) / 255);
+
+	*dst = ((a > 255 ? 255 : a) << 24) | ((r > 255 ? 255 : r) << 16) |
+			((g > 255 ? 255 : g) << 8) | (b > 255 ? 255 : b);
+}
+
+/**
+ * @brief Narrow [*t0, *t1) to the steps t where 0 <= start + (t * step) < limit.
+ */
+static void _clip_span(double start, double step, double limit, int *t0, int *t1)
+{
+	double lo = 0.0, hi = 0.0;
+
+	if (step == 0.0) {
+		if (start < 0.0 || start >= limit)
+			*t1 = *t0;
+		return;
+	}
+
+	lo = -start / step;
+	hi = (limit - start) / step;
+	if (step < 0.0) {
+		lo = hi;
+		hi = -start / step;
+		if (floor(lo) + 1 > *t0)
+			*t0 = (int)floor(lo) + 1;
+		if (floor(hi) + 1 < *t1)
+			*t1 = (int)floor(hi) + 1;
+	} else {
+		if (ceil(lo) > *t0)
+			*t0 = (int)ceil(lo);
+		if (ceil(hi) < *t1)
+			*t1 = (int)ceil(hi);
+	}
+}
+
+/**
+ * @brief Draw one row with the blit kernel, in 16.16 texel coordinates.
+ * Bilinear sampling of premultiplied pixels only.
+ */
+static void _draw_span(const struct _render_object *obj, int y, int x0, int x1, double lx, double ly, double co, double si, int vh)
+{
+	double sx = (double)obj->iw / obj->w;
+	double sy = (double)obj->ih / obj->h;
+	render_blit_span_s span;
+	int t0 = 0;
+	int t1 = x1 - x0;
+
+	_clip_span(lx, co, obj->w, &t0, &t1);
+	_clip_span(ly, -si, vh, &t0, &t1);
+	if (t0 >= t1)
+		return;
+
+	span.dst = s_info.frame + (y * s_info.width) + x0 + t0;
+	span.count = t1 - t0;
+	span.src = obj->premul;
+	span.src_w = obj->iw;
+	span.src_h = obj->ih;
+	span.u = (int32_t)lround((((lx + (t0 * co)) * sx) - 0.5) * 65536.0);
+	span.v = (int32_t)lround((((ly - (t0 * si)) * sy) - 0.5) * 65536.0);
+	span.du = (int32_t)lround(co * sx * 65536.0);
+	span.dv = (int32_t)lround(-si * sy * 65536.0);
+	span.color = ((uint32_t)obj->a << 24) | (obj->r << 16) | (obj->g << 8) | obj->b;
+
+	s_info.blit(&span);
+}
+
+/**
+ * @brief Draw one object. The inverse transform is stepped along each row
+ * instead of being recomputed per pixel.
+ */
+static void _draw_object(const struct _render_object *obj)
+{
+	double rad = obj->degree * M_PI / 180.0;
+	double co = cos(rad);
+	double si = sin(rad);
+	double sx = (double)obj->iw / obj->w;
+	double sy = (double)obj->ih / obj->h;
+	int vh = (obj->visible_h > 0 && obj->visible_h < obj->h) ? obj->visible_h : obj->h;
+	double corner_x[4] = { obj->x, obj->x + obj->w, obj->x + obj->w, obj->x };
+	double corner_y[4] = { obj->y, obj->y, obj->y + vh, obj->y + vh };
+	double min_x = s_info.width, min_y = s_info.height, max_x = 0, max_y = 0;
+	double px = 0.0, py = 0.0;
+	double lx = 0.0, ly = 0.0;
+	int x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+	int x = 0, y = 0;
+	int i = 0;
+
+	for (i = 0; i < 4; i++) {
+		px = obj->cx + ((corner_x[i] - obj->cx) * co) - ((corner_y[i] - obj->cy) * si);
+		py = obj->cy + ((corner_x[i] - obj->cx) * si) + ((corner_y[i] - obj->cy) * co);
+		min_x = px < min_x ? px : min_x;
+		max_x = px > max_x ? px : max_x;
+		min_y = py < min_y ? py : min_y;
+		max_y = py > max_y ? py : max_y;
+	}
+
+	x0 = min_x < 0 ? 0 : (int)floor(min_x);
+	y0 = min_y < 0 ? 0 : (int)floor(min_y);
+	x1 = max_x > s_info.width ? s_info.width : (int)ceil(max_x);
+	y1 = max_y > s_info.height ? s_info.height : (int)ceil(max_y);
+
+	for (y = y0; y < y1; y++) {
+		// Object coordinates of the centre of the first pixel in the row
+		px = x0 + 0.5 - obj->cx;
+		py = y + 0.5 - obj->cy;
+		lx = obj->cx + (px * co) + (py * si) - obj->x;
+		ly = obj->cy - (px * si) + (py * co) - obj->y;
+
+		if (s_info.blit && s_info.premultiplied && s_info.filter == RENDER_SOFT_FILTER_BILINEAR) {
+			_draw_span(obj, y, x0, x1, lx, ly, co, si, vh);
+			continue;
+		}
+
+		for (x = x0; x < x1; x++, lx += co, ly -= si) {
+			if (lx < 0 || ly < 0 || lx >= obj->w || ly >= vh)
+				continue;
+
+			_blend(&s_info.frame[(y * s_info.width) + x], _sample(obj, lx * sx, ly * sy), obj);
+		}
+	}
+}
+
+/*
+ * Backend
+ */
+
+static render_object_h _image_add(const char *image_path, int x, int y, int w, int h)
+{
+	struct _render_object *obj = NULL;
+	int i = 0;
+
+	if (w <= 0 || h <= 0)
+		return NULL;
+
+	obj = calloc(1, sizeof(struct _render_object));
+	if (obj == NULL)
+		return NULL;
+
+	obj->straight = _png_load(image_path, &obj->iw, &obj->ih);
+	if (obj->straight)
+		obj->premul = malloc(sizeof(uint32_t) * obj->iw * obj->ih);
+
+	if (obj->premul == NULL) {
+		fprintf(stderr, "render_soft: failed to load %s\n", image_path);
+		free(obj->straight);
+		free(obj);
+		return NULL;
+	}
+
+	for (i = 0; i < obj->iw * obj->ih; i++)
+		obj->premul[i] = _premultiply(obj->straight[i]);
+
+	obj->x = x;
+	obj->y = y;
+	obj->w = w;
+	obj->h = h;
+	obj->r = obj->g = obj->b = obj->a = 255;
+	obj->visible = true;
+
+	if (s_info.tail)
+		s_info.tail->next = obj;
+	else
+		s_info.head = obj;
+	s_info.tail = obj;
+
+	return obj;
+}
+
+static void _set_transform(render_object_h obj, double degree, int cx, int cy, int visible_h)
+{
+	obj->degree = degree;
+	obj->cx = cx;
+	obj->cy = cy;
+	obj->visible_h = visible_h;
+}
+
+static void _set_color(render_object_h obj, int r, int g, int b, int a)
+{
+	obj->r = r;
+	obj->g = g;
+	obj->b = b;
+	obj->a = a;
+}
+
+static void _set_visible(render_object_h obj, bool visible)
+{
+	obj->visible = visible;
+}
+
+/*
+ * There is no font rasteriser, text is left to the EFL backend
+ */
+static void _set_text(render_object_h obj, const char *part_name, const char *text)
+{
+}
+
+static void _del(render_object_h obj)
+{
+	struct _render_object *prev = NULL;
+	struct _render_object *it = s_info.head;
+
+	while (it && it != obj) {
+		prev = it;
+		it = it->next;
+	}
+
+	if (it) {
+		if (prev)
+			prev->next = obj->next;
+		else
+			s_info.head = obj->next;
+
+		if (s_info.tail == obj)
+			s_info.tail = prev;
+	}
+
+	free(obj->premul);
+	free(obj->straight);
+	free(obj);
+}
+
+const render_backend_s render_backend_soft = {
+	.name = "soft",
+	.image_add = _image_add,
+	.set_transform = _set_transform,
+	.set_color = _set_color,
+	.set_visible = _set_visible,
+	.set_text = _set_text,
+	.del = _del,
+};
+
+/**
+ * @brief Initialization function for the software backend.
+ * @param[in] width The frame width
+ * @param[in] height The frame height
+ */
+bool render_soft_initialize(int width, int height)
+{
+	s_info.frame = calloc((size_t)width * height, sizeof(uint32_t));
+	if (s_info.frame == NULL)
+		return false;
+
+	s_info.width = width;
+	s_info.height = height;
+	s_info.blit = render_blit_get(render_blit_get_best());
+
+	return true;
+}
+
+/**
+ * @brief Finalization function for the software backend.
+ */
+void render_soft_finalize(void)
+{
+	while (s_info.head)
+		_del(s_info.head);
+
+	free(s_info.frame);
+	s_info.frame = NULL;
+}
+
+/**
+ * @brief Set how images are sampled.
+ * @param[in] filter The filter
+ */
+void render_soft_set_filter(render_soft_filter_e filter)
+{
+	s_info.filter = filter;
+}
+
+/**
+ * @brief Filter premultiplied pixels, or straight ones premultiplied afterwards.
+ * @param[in] premultiplied True to filter premultiplied pixels
+ */
+void render_soft_set_premultiplied(bool premultiplied)
+{
+	s_info.premultiplied = premultiplied;
+}
+
+/**
+ * @brief Choose the row kernel for bilinear, premultiplied drawing.
+ * @param[in] kernel The kernel, RENDER_BLIT_MAX for the per-pixel float path
+ * @return false if this build or CPU does not support the kernel
+ */
+bool render_soft_set_kernel(render_blit_kernel_e kernel)
+{
+	render_blit_span_cb blit = NULL;
+
+	if (kernel == RENDER_BLIT_MAX) {
+		s_info.blit = NULL;
+		return true;
+	}
+
+	blit = render_blit_get(kernel);
+	if (blit == NULL)
+		return false;
+
+	s_info.blit = blit;
+
+	return true;
+}
+
+/**
+ * @brief Draw all visible objects over an opaque black frame.
+ */
+void render_soft_draw(void)
+{
+	struct _render_object *obj = NULL;
+	int i = 0;
+
+	for (i = 0; i < s_info.width * s_info.height; i++)
+		s_info.frame[i] = 0xff000000;
+
+	for (obj = s_info.head; obj; obj = obj->next) {
+		if (obj->visible)
+			_draw_object(obj);
+	}
+}
+
+/**
+ * @brief Get the frame, premultiplied 0xAARRGGBB.
+ */
+const uint32_t *render_soft_get_pixels(void)
+{
+	return s_info.frame;
+}
+
+/**
+ * @brief Load a PNG file as 0xAARRGGBB pixels, to be freed by the caller.
+ * @param[in] path The file path
+ * @param[in] premultiplied True for premultiplied pixels, as objects draw them
+ * @param[out] width The image width
+ * @param[out] height The image height
+ */
+uint32_t *render_soft_load_png(const char *path, bool premultiplied, int *width, int *height)
+{
+	uint32_t *pixels = _png_load(path, width, height);
+	int i = 0;
+
+	if (pixels && premultiplied) {
+		for (i = 0; i < *width * *height; i++)
+			pixels[i] = _premultiply(pixels[i]);
+	}
+
+	return pixels;
+}
+
+/**
+ * @brief Write the frame as an RGBA PNG.
+ * @param[in] path The file path
+ */
+bool render_soft_write_png(const char *path)
+{
+	png_image image;
+	uint8_t *raw = NULL;
+	bool ret = false;
+	int i = 0;
+
+	raw = malloc((size_t)s_info.width * s_info.height * 4);
+	if (raw == NULL)
+		return false;
+
+	for (i = 0; i < s_info.width * s_info.height; i++)
+		_unpremultiply(s_info.frame[i], raw + (i * 4));
+
+	memset(&image, 0, sizeof(image));
+	image.version = PNG_IMAGE_VERSION;
+	image.width = s_info.width;
+	image.height = s_info.height;
+	image.format = PNG_FORMAT_RGBA;
+
+	ret = png_image_write_to_file(&image, path, 0, raw, 0, NULL) != 0;
+	if (!ret)
+		fprintf(stderr, "render_soft: %s: %s\n", path, image.message);
+
+	free(raw);
+	return ret;
+}
+
+/**
+ * @brief Write the frame as straight RGBA in a PAM file.
+ * @param[in] path The file path
+ */
+bool render_soft_write_raw(const char *path)
+{
+	uint8_t px[4];
+	bool ret = true;
+	int i = 0;
+	FILE *fp = NULL;
+
+	fp = fopen(path, "wb");
+	if (fp == NULL)
+		return false;
+
+	fprintf(fp, "P7\nWIDTH %d\nHEIGHT %d\nDEPTH 4\nMAXVAL 255\nTUPLTYPE RGB_ALPHA\nENDHDR\n", s_info.width, s_info.height);
+	for (i = 0; i < s_info.width * s_info.height && ret; i++) {
+		_unpremultiply(s_info.frame[i], px);
+		ret = fwrite(px, 1, 4, fp) == 4;
+	}
+
+	if (fclose(fp) != 0)
+		ret = false;
+
+	return ret;
+}
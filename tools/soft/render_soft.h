@@ -0,0 +1,34 @@
+#if !defined(_RENDER_SOFT_H)
+#define _RENDER_SOFT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "render.h"
+#include "render_blit.h"
+
+typedef enum {
+	RENDER_SOFT_FILTER_NEAREST = 0,
+	RENDER_SOFT_FILTER_BILINEAR = 1,
+} render_soft_filter_e;
+
+/*
+ * Initialize the software backend with a frame of the given size
+ */
+bool render_soft_initialize(int width, int height);
+
+/*
+ * Finalize the software backend, deleting any objects left
+ */
+void render_soft_finalize(void);
+
+void render_soft_set_filter(render_soft_filter_e filter);
+void render_soft_set_premultiplied(bool premultiplied);
+bool render_soft_set_kernel(render_blit_kernel_e kernel);
+void render_soft_draw(void);
+const uint32_t *render_soft_get_pixels(void);
+uint32_t *render_soft_load_png(const char *path, bool premultiplied, int *width, int *height);
+bool render_soft_write_png(const char *path);
+bool render_soft_write_raw(const char *path);
+
+#endif